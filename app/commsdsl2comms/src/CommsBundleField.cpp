@@ -166,11 +166,13 @@ std::string CommsBundleField::commsDefPublicCodeImpl() const
 {
     static const std::string Templ = 
         "#^#ACCESS#$#\n"
-        "#^#ALIASES#$#\n";
+        "#^#ALIASES#$#\n"
+        "#^#LENGTH#$#\n";
 
     util::ReplacementMap repl = {
         {"ACCESS", commsDefAccessCodeInternal()},
         {"ALIASES", commsDefAliasesCodeInternal()},
+        {"LENGTH", commsDefFixedLengthCodeInternal()},
     };
 
     return util::processTemplate(Templ, repl);
@@ -609,6 +611,24 @@ std::string CommsBundleField::commsDefAliasesCodeInternal() const
     return util::strListToString(result, "\n", "");
 }
 
+std::string CommsBundleField::commsDefFixedLengthCodeInternal() const
+{
+    if ((commsMinLength() != commsMaxLength()) || commsHasCustomLength() || commsIsVersionDependent()) {
+        return strings::emptyString();
+    }
+
+    static const std::string Templ = 
+        "/// @brief Generated length functionality.\n"
+        "/// @details All the members have fixed length.\n"
+        "static constexpr std::size_t length()\n"
+        "{\n"
+        "    static_assert(Base::minLength() == Base::maxLength(), \"All the members are expected to have fixed length\");\n"
+        "    return Base::minLength();\n"
+        "}\n";
+
+    return Templ;
+}
+
 void CommsBundleField::commsAddCustomReadRefreshOptInternal(StringsList& opts) const
 {
     bool hasGeneratedRead = 
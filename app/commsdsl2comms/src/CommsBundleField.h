@@ -71,6 +71,7 @@ private:
     std::string commsDefFieldOptsInternal() const;
     std::string commsDefAccessCodeInternal() const;
     std::string commsDefAliasesCodeInternal() const;
+    std::string commsDefFixedLengthCodeInternal() const;
 
     void commsAddCustomReadRefreshOptInternal(StringsList& opts) const;
     void commsAddRemLengthMemberOptInternal(StringsList& opts) const;
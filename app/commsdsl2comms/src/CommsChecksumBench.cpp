@@ -0,0 +1,242 @@
+//
+// Copyright 2019 - 2023 (C). Alex Robenko. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "CommsChecksumBench.h"
+
+#include "CommsChecksumLayer.h"
+#include "CommsGenerator.h"
+
+#include "commsdsl/gen/comms.h"
+#include "commsdsl/gen/strings.h"
+#include "commsdsl/gen/util.h"
+
+#include <algorithm>
+#include <cassert>
+#include <fstream>
+
+namespace comms = commsdsl::gen::comms;
+namespace strings = commsdsl::gen::strings;
+namespace util = commsdsl::gen::util;
+
+namespace commsdsl2comms
+{
+
+namespace
+{
+
+const std::string ChecksumBenchStr("ChecksumBench");
+
+} // namespace
+
+bool CommsChecksumBench::write(CommsGenerator& generator)
+{
+    CommsChecksumBench obj(generator);
+    return obj.commsWriteInternal();
+}
+
+bool CommsChecksumBench::commsWriteInternal() const
+{
+    static const std::string Templ =
+        "#^#GENERATED#$#\n"
+        "/// @file\n"
+        "/// @brief Measures throughput of the CRC calculators used by the protocol frames.\n"
+        "/// @details Usage: checksum_bench_#^#PROT_NAMESPACE#$# [iterations]\n"
+        "///     The iterations apply to the largest buffer, the smaller ones are\n"
+        "///     processed proportionally more times.\n\n"
+        "#include <chrono>\n"
+        "#include <cstddef>\n"
+        "#include <cstdint>\n"
+        "#include <cstdlib>\n"
+        "#include <deque>\n"
+        "#include <iostream>\n"
+        "#include <random>\n"
+        "#include <vector>\n\n"
+        "#^#INCLUDES#$#\n\n"
+        "namespace\n"
+        "{\n\n"
+        "class ChecksumBench\n"
+        "{\n"
+        "public:\n"
+        "    explicit ChecksumBench(std::size_t iterations) :\n"
+        "        m_iterations(iterations)\n"
+        "    {\n"
+        "    }\n\n"
+        "    template <typename TCalc>\n"
+        "    void run(const char* name)\n"
+        "    {\n"
+        "        for (auto size : Sizes) {\n"
+        "            runSize<TCalc>(name, size);\n"
+        "        }\n"
+        "    }\n\n"
+        "private:\n"
+        "    using Clock = std::chrono::high_resolution_clock;\n"
+        "    static const std::size_t MaxSize = 65536U;\n"
+        "    static constexpr std::size_t Sizes[] = {64U, 1500U, MaxSize};\n\n"
+        "    template <typename TCalc>\n"
+        "    void runSize(const char* name, std::size_t size)\n"
+        "    {\n"
+        "        std::vector<std::uint8_t> buf(size);\n"
+        "        std::mt19937 gen(static_cast<std::uint32_t>(size));\n"
+        "        for (auto& byte : buf) {\n"
+        "            byte = static_cast<std::uint8_t>(gen());\n"
+        "        }\n\n"
+        "        // Non contiguous storage, processed one byte at a time\n"
+        "        std::deque<std::uint8_t> bytewiseBuf(buf.begin(), buf.end());\n\n"
+        "        TCalc calc;\n"
+        "        const std::uint8_t* ptrIter = buf.data();\n"
+        "        auto bytewiseIter = bytewiseBuf.cbegin();\n"
+        "        if (calc(ptrIter, size) != calc(bytewiseIter, size)) {\n"
+        "            std::cerr << \"ERROR: Checksum mismatch of \" << name << std::endl;\n"
+        "            std::exit(-1);\n"
+        "        }\n\n"
+        "        auto iterations = m_iterations * (MaxSize / size);\n"
+        "        auto contiguousNs = nsPerOp<TCalc>(static_cast<const std::uint8_t*>(buf.data()), size, iterations);\n"
+        "        auto bytewiseNs = nsPerOp<TCalc>(bytewiseBuf.cbegin(), size, iterations);\n\n"
+        "        if (0U < m_count) {\n"
+        "            std::cout << \",\";\n"
+        "        }\n\n"
+        "        std::cout << \"\\n    {\"\n"
+        "            \"\\\"name\\\":\\\"\" << name << \"\\\",\"\n"
+        "            \"\\\"bytes_per_op\\\":\" << size << \",\"\n"
+        "            \"\\\"contiguous_mb_per_sec\\\":\" << mbPerSec(size, contiguousNs) << \",\"\n"
+        "            \"\\\"bytewise_mb_per_sec\\\":\" << mbPerSec(size, bytewiseNs) << \"}\";\n"
+        "        ++m_count;\n"
+        "    }\n\n"
+        "    template <typename TCalc, typename TIter>\n"
+        "    double nsPerOp(TIter begin, std::size_t size, std::size_t iterations)\n"
+        "    {\n"
+        "        TCalc calc;\n"
+        "        std::uint64_t result = 0U;\n"
+        "        auto start = Clock::now();\n"
+        "        for (std::size_t idx = 0U; idx < iterations; ++idx) {\n"
+        "            auto iter = begin;\n"
+        "            result += static_cast<std::uint64_t>(calc(iter, size));\n"
+        "        }\n"
+        "        auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start);\n"
+        "        m_sink = m_sink + result; // Prevents the calculation from being optimized away\n"
+        "        return static_cast<double>(ns.count()) / static_cast<double>(iterations);\n"
+        "    }\n\n"
+        "    static double mbPerSec(std::size_t bytes, double nsPerOp)\n"
+        "    {\n"
+        "        if (nsPerOp <= 0.0) {\n"
+        "            return 0.0;\n"
+        "        }\n\n"
+        "        return (static_cast<double>(bytes) * 1000.0) / nsPerOp;\n"
+        "    }\n\n"
+        "    std::size_t m_iterations = 0U;\n"
+        "    std::size_t m_count = 0U;\n"
+        "    volatile std::uint64_t m_sink = 0U;\n"
+        "};\n\n"
+        "constexpr std::size_t ChecksumBench::Sizes[];\n\n"
+        "} // namespace\n\n"
+        "int main(int argc, const char* argv[])\n"
+        "{\n"
+        "    std::size_t iterations = 1000U;\n"
+        "    if (1 < argc) {\n"
+        "        iterations = static_cast<std::size_t>(std::strtoull(argv[1], nullptr, 10));\n"
+        "    }\n\n"
+        "    if (iterations == 0U) {\n"
+        "        std::cerr << \"Invalid number of iterations\" << std::endl;\n"
+        "        return -1;\n"
+        "    }\n\n"
+        "    std::cout << \"{\\n  \\\"iterations\\\":\" << iterations << \",\\n\"\n"
+        "        \"  \\\"checksums\\\":[\";\n\n"
+        "    ChecksumBench bench(iterations);\n"
+        "    #^#RUNS#$#\n"
+        "    std::cout << \"\\n  ]\\n}\" << std::endl;\n"
+        "    return 0;\n"
+        "}\n"
+        ;
+
+    auto& gen = m_generator;
+    util::StringsList includes;
+    util::StringsList calcTypes;
+    auto frames = gen.currentSchema().getAllFrames();
+    for (auto* f : frames) {
+        auto includesCount = includes.size();
+        for (auto& l : f->layers()) {
+            if (l->dslObj().kind() != commsdsl::parse::Layer::Kind::Checksum) {
+                continue;
+            }
+
+            auto* checksumLayer = dynamic_cast<const CommsChecksumLayer*>(l.get());
+            assert(checksumLayer != nullptr);
+            auto calcType = checksumLayer->commsCrcCalcType();
+            if (calcType.empty()) {
+                continue;
+            }
+
+            if (includesCount == includes.size()) {
+                includes.push_back(comms::relHeaderPathFor(*f, gen));
+            }
+
+            if (std::find(calcTypes.begin(), calcTypes.end(), calcType) == calcTypes.end()) {
+                calcTypes.push_back(std::move(calcType));
+            }
+        }
+    }
+
+    if (calcTypes.empty()) {
+        return true;
+    }
+
+    util::StringsList runs;
+    for (auto& t : calcTypes) {
+        auto name = t;
+        auto pos = name.rfind("::");
+        if (pos != std::string::npos) {
+            name = name.substr(pos + 2U);
+        }
+
+        runs.push_back("bench.run<" + t + " >(\"" + name + "\");");
+    }
+
+    comms::prepareIncludeStatement(includes);
+    util::ReplacementMap repl = {
+        {"GENERATED", CommsGenerator::commsFileGeneratedComment()},
+        {"PROT_NAMESPACE", gen.currentSchema().mainNamespace()},
+        {"INCLUDES", util::strListToString(includes, "\n", "")},
+        {"RUNS", util::strListToString(runs, "\n", "")},
+    };
+
+    auto filePath =
+        util::pathAddElem(
+            util::pathAddElem(gen.getOutputDir(), strings::srcDirStr()),
+            ChecksumBenchStr + strings::cppSourceSuffixStr());
+
+    gen.logger().info("Generating " + filePath);
+    auto dirPath = util::pathUp(filePath);
+    assert(!dirPath.empty());
+    if (!gen.createDirectory(dirPath)) {
+        return false;
+    }
+
+    std::ofstream stream(filePath);
+    if (!stream) {
+        gen.logger().error("Failed to open \"" + filePath + "\" for writing.");
+        return false;
+    }
+
+    stream << util::processTemplate(Templ, repl, true);
+    stream.flush();
+    if (!stream.good()) {
+        gen.logger().error("Failed to write \"" + filePath + "\".");
+        return false;
+    }
+
+    return true;
+}
+
+} // namespace commsdsl2comms
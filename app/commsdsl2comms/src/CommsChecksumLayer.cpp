@@ -23,7 +23,11 @@
 
 #include <algorithm>
 #include <cassert>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
 #include <iterator>
+#include <sstream>
 
 namespace comms = commsdsl::gen::comms;
 namespace strings = commsdsl::gen::strings;
@@ -32,12 +36,181 @@ namespace util = commsdsl::gen::util;
 namespace commsdsl2comms
 {
 
+namespace
+{
+
+using ChecksumAlg = commsdsl::parse::ChecksumLayer::Alg;
+
+const unsigned SliceCount = 8U;
+const unsigned SliceEntriesCount = 256U;
+
+struct GeneratedAlgInfo
+{
+    ChecksumAlg m_alg;
+    const char* m_name;
+    const char* m_desc;
+    unsigned m_width;
+    std::uint64_t m_poly; // reflected when m_reflected is true
+    std::uint64_t m_init;
+    std::uint64_t m_xorOut;
+    bool m_reflected;
+};
+
+// The parameters of Crc_CCITT, Crc_16 and Crc_32 match the ones of the
+// same name calculators provided by the COMMS library.
+const GeneratedAlgInfo GeneratedAlgs[] = {
+    {ChecksumAlg::Crc_CCITT, "Crc_CCITT", "CRC-16/CCITT-FALSE", 16U, 0x1021ULL, 0xFFFFULL, 0x0ULL, false},
+    {ChecksumAlg::Crc_16, "Crc_16", "CRC-16/ARC", 16U, 0xA001ULL, 0x0ULL, 0x0ULL, true},
+    {ChecksumAlg::Crc_32, "Crc_32", "CRC-32", 32U, 0xEDB88320ULL, 0xFFFFFFFFULL, 0xFFFFFFFFULL, true},
+    {ChecksumAlg::Crc_32C, "Crc_32C", "CRC-32C (Castagnoli)", 32U, 0x82F63B78ULL, 0xFFFFFFFFULL, 0xFFFFFFFFULL, true},
+    {ChecksumAlg::Crc_64, "Crc_64", "CRC-64/XZ (ECMA-182)", 64U, 0xC96C5795D7870F42ULL, 0xFFFFFFFFFFFFFFFFULL, 0xFFFFFFFFFFFFFFFFULL, true},
+};
+
+const GeneratedAlgInfo* generatedAlgInfo(ChecksumAlg alg)
+{
+    auto iter =
+        std::find_if(
+            std::begin(GeneratedAlgs), std::end(GeneratedAlgs),
+            [alg](const GeneratedAlgInfo& info)
+            {
+                return info.m_alg == alg;
+            });
+
+    if (iter == std::end(GeneratedAlgs)) {
+        return nullptr;
+    }
+
+    return &(*iter);
+}
+
+std::uint64_t generatedAlgMask(const GeneratedAlgInfo& info)
+{
+    if (64U <= info.m_width) {
+        return ~static_cast<std::uint64_t>(0U);
+    }
+
+    return (static_cast<std::uint64_t>(1U) << info.m_width) - 1U;
+}
+
+std::string generatedAlgHex(std::uint64_t value, const GeneratedAlgInfo& info)
+{
+    std::stringstream stream;
+    stream << "0x" << std::hex << std::setfill('0') << std::setw(static_cast<int>(info.m_width / 4U)) << 
+        value << ((info.m_width <= 32U) ? "U" : "ULL");
+    return stream.str();
+}
+
+std::string generatedAlgTable(const GeneratedAlgInfo& info)
+{
+    auto mask = generatedAlgMask(info);
+    auto topShift = info.m_width - 8U;
+    auto topBit = static_cast<std::uint64_t>(1U) << (info.m_width - 1U);
+    std::vector<std::uint64_t> values(SliceCount * SliceEntriesCount);
+    for (auto idx = 0U; idx < SliceEntriesCount; ++idx) {
+        std::uint64_t crc = idx;
+        if (!info.m_reflected) {
+            crc <<= topShift;
+        }
+
+        for (auto bit = 0U; bit < 8U; ++bit) {
+            if (info.m_reflected) {
+                crc = ((crc & 1U) != 0U) ? ((crc >> 1U) ^ info.m_poly) : (crc >> 1U);
+                continue;
+            }
+
+            crc = ((crc & topBit) != 0U) ? ((crc << 1U) ^ info.m_poly) : (crc << 1U);
+            crc &= mask;
+        }
+        values[idx] = crc;
+    }
+
+    for (auto slice = 1U; slice < SliceCount; ++slice) {
+        for (auto idx = 0U; idx < SliceEntriesCount; ++idx) {
+            auto prev = values[((slice - 1U) * SliceEntriesCount) + idx];
+            if (info.m_reflected) {
+                values[(slice * SliceEntriesCount) + idx] = (prev >> 8U) ^ values[prev & 0xffU];
+                continue;
+            }
+
+            values[(slice * SliceEntriesCount) + idx] = ((prev << 8U) & mask) ^ values[prev >> topShift];
+        }
+    }
+
+    auto perLine = 256U / info.m_width;
+    util::StringsList slices;
+    for (auto slice = 0U; slice < SliceCount; ++slice) {
+        util::StringsList lines;
+        for (auto idx = 0U; idx < SliceEntriesCount; idx += perLine) {
+            util::StringsList elems;
+            for (auto elemIdx = idx; elemIdx < (idx + perLine); ++elemIdx) {
+                elems.push_back(generatedAlgHex(values[(slice * SliceEntriesCount) + elemIdx], info));
+            }
+            lines.push_back(util::strListToString(elems, ", ", ""));
+        }
+
+        static const std::string Templ = 
+            "{\n"
+            "    #^#VALUES#$#\n"
+            "}";
+
+        util::ReplacementMap repl = {
+            {"VALUES", util::strListToString(lines, ",\n", "")}
+        };
+
+        slices.push_back(util::processTemplate(Templ, repl));
+    }
+
+    return util::strListToString(slices, ",\n", "");
+}
+
+} // namespace
+
 CommsChecksumLayer::CommsChecksumLayer(CommsGenerator& generator, commsdsl::parse::Layer dslObj, commsdsl::gen::Elem* parent) :
     Base(generator, dslObj, parent),
     CommsBase(static_cast<Base&>(*this))
 {
 }
 
+std::string CommsChecksumLayer::commsCrcCalcType() const
+{
+    if (generatedAlgInfo(checksumDslObj().alg()) == nullptr) {
+        return strings::emptyString();
+    }
+
+    return commsDefAlgInternal();
+}
+
+bool CommsChecksumLayer::commsWriteCrcCalcs(CommsGenerator& generator)
+{
+    std::vector<ChecksumAlg> algs;
+    auto frames = generator.currentSchema().getAllFrames();
+    for (auto* f : frames) {
+        for (auto& l : f->layers()) {
+            if (l->dslObj().kind() != commsdsl::parse::Layer::Kind::Checksum) {
+                continue;
+            }
+
+            auto* checksumLayer = dynamic_cast<const CommsChecksumLayer*>(l.get());
+            assert(checksumLayer != nullptr);
+            auto alg = checksumLayer->checksumDslObj().alg();
+            if ((generatedAlgInfo(alg) == nullptr) || 
+                (std::find(algs.begin(), algs.end(), alg) != algs.end())) {
+                continue;
+            }
+
+            algs.push_back(alg);
+        }
+    }
+
+    return 
+        std::all_of(
+            algs.begin(), algs.end(),
+            [&generator](ChecksumAlg alg)
+            {
+                return commsWriteCrcCalcInternal(generator, alg);
+            });
+}
+
 bool CommsChecksumLayer::prepareImpl()
 {
     return Base::prepareImpl() && CommsBase::commsPrepare();
@@ -59,10 +232,12 @@ CommsChecksumLayer::IncludesList CommsChecksumLayer::commsDefIncludesImpl() cons
     const std::string ChecksumMap[] = {
         /* Custom */ strings::emptyString(),
         /* Sum */ "BasicSum",
-        /* Crc_CCITT */ "Crc",
-        /* Crc_16 */ "Crc",
-        /* Crc_32 */ "Crc",
+        /* Crc_CCITT */ strings::emptyString(),
+        /* Crc_16 */ strings::emptyString(),
+        /* Crc_32 */ strings::emptyString(),
         /* Xor */ "BasicXor",
+        /* Crc_32C */ strings::emptyString(),
+        /* Crc_64 */ strings::emptyString(),
     };
 
     const std::size_t ChecksumMapSize = std::extent<decltype(ChecksumMap)>::value;
@@ -77,7 +252,11 @@ CommsChecksumLayer::IncludesList CommsChecksumLayer::commsDefIncludesImpl() cons
         idx = 0U;
     }
 
-    if (!ChecksumMap[idx].empty()) {
+    auto* genInfo = generatedAlgInfo(obj.alg());
+    if (genInfo != nullptr) {
+        result.push_back(comms::relHeaderForChecksum(genInfo->m_name, generator()));
+    }
+    else if (!ChecksumMap[idx].empty()) {
         result.push_back("comms/protocol/checksum/" + ChecksumMap[idx] + strings::cppHeaderSuffixStr());
     }
     else {
@@ -120,10 +299,12 @@ std::string CommsChecksumLayer::commsDefAlgInternal() const
     const std::string ClassMap[] = {
         /* Custom */ strings::emptyString(),
         /* Sum */ "BasicSum",
-        /* Crc_CCITT */ "Crc_CCITT",
-        /* Crc_16 */ "Crc_16",
-        /* Crc_32 */ "Crc_32",
+        /* Crc_CCITT */ strings::emptyString(),
+        /* Crc_16 */ strings::emptyString(),
+        /* Crc_32 */ strings::emptyString(),
         /* Xor */ "BasicXor",
+        /* Crc_32C */ strings::emptyString(),
+        /* Crc_64 */ strings::emptyString(),
     };
 
     const std::size_t ClassMapSize = std::extent<decltype(ClassMap)>::value;
@@ -142,6 +323,11 @@ std::string CommsChecksumLayer::commsDefAlgInternal() const
         idx = 0U;
     }
 
+    auto* genInfo = generatedAlgInfo(alg);
+    if (genInfo != nullptr) {
+        return comms::scopeForChecksum(genInfo->m_name, generator());
+    }
+
     if (ClassMap[idx].empty()) {
         assert(!obj.customAlgName().empty());
         return comms::scopeForChecksum(obj.customAlgName(), generator());
@@ -179,4 +365,323 @@ std::string CommsChecksumLayer::commsDefExtraOptInternal() const
     return result;
 }
 
+bool CommsChecksumLayer::commsWriteCrcCalcInternal(CommsGenerator& generator, commsdsl::parse::ChecksumLayer::Alg alg)
+{
+    auto* genInfo = generatedAlgInfo(alg);
+    assert(genInfo != nullptr);
+
+    auto& gen = generator;
+    auto filePath = 
+        gen.getOutputDir() + '/' + strings::includeDirStr() + '/' + 
+        comms::relHeaderForChecksum(genInfo->m_name, gen);
+
+    gen.logger().info("Generating " + filePath);
+
+    auto dirPath = util::pathUp(filePath);
+    assert(!dirPath.empty());
+    if (!gen.createDirectory(dirPath)) {
+        return false;
+    }
+
+    std::ofstream stream(filePath);
+    if (!stream) {
+        gen.logger().error("Failed to open \"" + filePath + "\" for writing.");
+        return false;
+    }
+
+    static const std::string Templ =
+        "#^#GENERATED#$#\n"
+        "/// @file\n"
+        "/// @brief Contains definition of <b>\"#^#CLASS_NAME#$#\"</b> checksum calculator.\n\n"
+        "#pragma once\n\n"
+        "#include <cstddef>\n"
+        "#include <cstdint>\n"
+        "#include <cstring>\n"
+        "#include <iterator>\n"
+        "#include <type_traits>\n"
+        "#include <vector>\n\n"
+        "#^#HW_DEFINE#$#\n"
+        "namespace #^#PROT_NAMESPACE#$#\n"
+        "{\n\n"
+        "namespace #^#FRAME_NAMESPACE#$#\n"
+        "{\n\n"
+        "namespace #^#CHECKSUM_NAMESPACE#$#\n"
+        "{\n\n"
+        "/// @brief Calculator of #^#DESC#$# checksum.\n"
+        "/// @details Uses #^#POLY_KIND#$# polynomial @b #^#POLY#$#, initial value @b #^#INIT#$#\n"
+        "///     and final XOR value @b #^#FINAL_XOR#$#. Contiguous input (raw pointer or\n"
+        "///     @b std::vector iterator) is processed 8 bytes at a time using slice-by-8\n"
+        "///     lookup tables.\n"
+        "#^#HW_DOC#$#\n"
+        "///     Any other iterator is processed one byte at a time.\n"
+        "class #^#CLASS_NAME#$#\n"
+        "{\n"
+        "public:\n"
+        "    /// @brief Type of the calculated checksum.\n"
+        "    using ResultType = #^#TYPE#$#;\n\n"
+        "    /// @brief Calculate the checksum.\n"
+        "    /// @param[in, out] iter Input iterator, advanced by @b len.\n"
+        "    /// @param[in] len Number of bytes to process.\n"
+        "    template <typename TIter>\n"
+        "    ResultType operator()(TIter& iter, std::size_t len) const\n"
+        "    {\n"
+        "        using Tag =\n"
+        "            typename std::conditional<\n"
+        "                IsContiguousIter<TIter>::value,\n"
+        "                ContiguousTag,\n"
+        "                GenericTag\n"
+        "            >::type;\n\n"
+        "        return static_cast<ResultType>(calcInternal(iter, len, Tag()) ^ FinalXor);\n"
+        "    }\n\n"
+        "private:\n"
+        "    using Table = ResultType[#^#SLICES#$#][#^#ENTRIES#$#];\n\n"
+        "    struct ContiguousTag {};\n"
+        "    struct GenericTag {};\n\n"
+        "    template <typename TIter>\n"
+        "    struct IsContiguousIter\n"
+        "    {\n"
+        "        using ValueType = typename std::iterator_traits<TIter>::value_type;\n"
+        "        static const bool value =\n"
+        "            (sizeof(ValueType) == 1U) &&\n"
+        "            (!std::is_same<ValueType, bool>::value) &&\n"
+        "            (std::is_pointer<TIter>::value ||\n"
+        "             std::is_same<TIter, typename std::vector<ValueType>::iterator>::value ||\n"
+        "             std::is_same<TIter, typename std::vector<ValueType>::const_iterator>::value);\n"
+        "    };\n\n"
+        "    static constexpr ResultType InitValue = #^#INIT#$#;\n"
+        "    static constexpr ResultType FinalXor = #^#FINAL_XOR#$#;\n\n"
+        "    template <typename TIter>\n"
+        "    static ResultType calcInternal(TIter& iter, std::size_t len, ContiguousTag)\n"
+        "    {\n"
+        "        if (len == 0U) {\n"
+        "            return InitValue;\n"
+        "        }\n\n"
+        "        auto* data = reinterpret_cast<const std::uint8_t*>(&(*iter));\n"
+        "        std::advance(iter, len);\n"
+        "        #^#HW_DISPATCH#$#\n"
+        "        return sliceCalcInternal(InitValue, data, len);\n"
+        "    }\n\n"
+        "    template <typename TIter>\n"
+        "    static ResultType calcInternal(TIter& iter, std::size_t len, GenericTag)\n"
+        "    {\n"
+        "        auto crc = InitValue;\n"
+        "        for (; len > 0U; --len) {\n"
+        "            crc = updateByteInternal(crc, static_cast<std::uint8_t>(*iter));\n"
+        "            ++iter;\n"
+        "        }\n"
+        "        return crc;\n"
+        "    }\n\n"
+        "    static ResultType updateByteInternal(ResultType crc, std::uint8_t byte)\n"
+        "    {\n"
+        "        #^#BYTE_UPDATE#$#\n"
+        "    }\n\n"
+        "    static ResultType sliceCalcInternal(ResultType crc, const std::uint8_t* data, std::size_t len)\n"
+        "    {\n"
+        "        auto& tab = tableInternal();\n"
+        "        while (#^#SLICES#$#U <= len) {\n"
+        "            #^#SLICE_STEP#$#\n"
+        "            data += #^#SLICES#$#;\n"
+        "            len -= #^#SLICES#$#U;\n"
+        "        }\n\n"
+        "        for (; len > 0U; --len) {\n"
+        "            crc = updateByteInternal(crc, *data);\n"
+        "            ++data;\n"
+        "        }\n"
+        "        return crc;\n"
+        "    }\n\n"
+        "    #^#HW_FUNCS#$#\n"
+        "    static const Table& tableInternal()\n"
+        "    {\n"
+        "        static const Table Values = {\n"
+        "            #^#TABLE#$#\n"
+        "        };\n"
+        "        return Values;\n"
+        "    }\n"
+        "};\n\n"
+        "} // namespace #^#CHECKSUM_NAMESPACE#$#\n\n"
+        "} // namespace #^#FRAME_NAMESPACE#$#\n\n"
+        "} // namespace #^#PROT_NAMESPACE#$#\n\n"
+        "#^#HW_UNDEF#$#\n";
+
+    static const std::string Slice16Templ = 
+        "crc = static_cast<ResultType>(crc ^ data[0] ^ (data[1] << 8U));\n"
+        "crc =\n"
+        "    static_cast<ResultType>(\n"
+        "        tab[7][crc & 0xffU] ^\n"
+        "        tab[6][crc >> 8U] ^\n"
+        "        tab[5][data[2]] ^\n"
+        "        tab[4][data[3]] ^\n"
+        "        tab[3][data[4]] ^\n"
+        "        tab[2][data[5]] ^\n"
+        "        tab[1][data[6]] ^\n"
+        "        tab[0][data[7]]);\n";
+
+    static const std::string Slice16NormalTempl = 
+        "crc =\n"
+        "    static_cast<ResultType>(\n"
+        "        tab[7][data[0] ^ (crc >> 8U)] ^\n"
+        "        tab[6][data[1] ^ (crc & 0xffU)] ^\n"
+        "        tab[5][data[2]] ^\n"
+        "        tab[4][data[3]] ^\n"
+        "        tab[3][data[4]] ^\n"
+        "        tab[2][data[5]] ^\n"
+        "        tab[1][data[6]] ^\n"
+        "        tab[0][data[7]]);\n";
+
+    static const std::string Slice32Templ = 
+        "crc ^=\n"
+        "    static_cast<ResultType>(data[0]) |\n"
+        "    (static_cast<ResultType>(data[1]) << 8U) |\n"
+        "    (static_cast<ResultType>(data[2]) << 16U) |\n"
+        "    (static_cast<ResultType>(data[3]) << 24U);\n\n"
+        "crc =\n"
+        "    tab[7][crc & 0xffU] ^\n"
+        "    tab[6][(crc >> 8U) & 0xffU] ^\n"
+        "    tab[5][(crc >> 16U) & 0xffU] ^\n"
+        "    tab[4][crc >> 24U] ^\n"
+        "    tab[3][data[4]] ^\n"
+        "    tab[2][data[5]] ^\n"
+        "    tab[1][data[6]] ^\n"
+        "    tab[0][data[7]];\n";
+
+    static const std::string Slice64Templ = 
+        "crc ^=\n"
+        "    static_cast<ResultType>(data[0]) |\n"
+        "    (static_cast<ResultType>(data[1]) << 8U) |\n"
+        "    (static_cast<ResultType>(data[2]) << 16U) |\n"
+        "    (static_cast<ResultType>(data[3]) << 24U) |\n"
+        "    (static_cast<ResultType>(data[4]) << 32U) |\n"
+        "    (static_cast<ResultType>(data[5]) << 40U) |\n"
+        "    (static_cast<ResultType>(data[6]) << 48U) |\n"
+        "    (static_cast<ResultType>(data[7]) << 56U);\n\n"
+        "crc =\n"
+        "    tab[7][crc & 0xffU] ^\n"
+        "    tab[6][(crc >> 8U) & 0xffU] ^\n"
+        "    tab[5][(crc >> 16U) & 0xffU] ^\n"
+        "    tab[4][(crc >> 24U) & 0xffU] ^\n"
+        "    tab[3][(crc >> 32U) & 0xffU] ^\n"
+        "    tab[2][(crc >> 40U) & 0xffU] ^\n"
+        "    tab[1][(crc >> 48U) & 0xffU] ^\n"
+        "    tab[0][crc >> 56U];\n";
+
+    static const std::string ByteUpdateTempl = 
+        "return static_cast<ResultType>(tableInternal()[0][(crc ^ byte) & 0xffU] ^ (crc >> 8U));";
+
+    static const std::string ByteUpdateNormalTempl = 
+        "return static_cast<ResultType>((crc << 8U) ^ tableInternal()[0][((crc >> #^#TOP_SHIFT#$#U) ^ byte) & 0xffU]);";
+
+    auto className = comms::className(genInfo->m_name);
+    auto ns = gen.currentSchema().mainNamespace();
+    std::stringstream polyStream;
+    polyStream << "0x" << std::uppercase << std::hex << std::setfill('0') << std::setw(static_cast<int>(genInfo->m_width / 4U)) << genInfo->m_poly;
+
+    const std::string* sliceStep = &Slice64Templ;
+    std::string type = "std::uint64_t";
+    if (genInfo->m_width == 16U) {
+        sliceStep = genInfo->m_reflected ? &Slice16Templ : &Slice16NormalTempl;
+        type = "std::uint16_t";
+    }
+    else if (genInfo->m_width == 32U) {
+        assert(genInfo->m_reflected); // Slice step for non-reflected 32 bit CRC is not implemented
+        sliceStep = &Slice32Templ;
+        type = "std::uint32_t";
+    }
+
+    assert((genInfo->m_width != 64U) || (genInfo->m_reflected));
+
+    util::ReplacementMap repl = {
+        {"GENERATED", CommsGenerator::commsFileGeneratedComment()},
+        {"CLASS_NAME", className},
+        {"DESC", genInfo->m_desc},
+        {"POLY_KIND", genInfo->m_reflected ? "reflected" : "normal (non-reflected)"},
+        {"POLY", polyStream.str()},
+        {"PROT_NAMESPACE", ns},
+        {"FRAME_NAMESPACE", strings::frameNamespaceStr()},
+        {"CHECKSUM_NAMESPACE", strings::checksumNamespaceStr()},
+        {"TYPE", std::move(type)},
+        {"INIT", generatedAlgHex(genInfo->m_init, *genInfo)},
+        {"FINAL_XOR", generatedAlgHex(genInfo->m_xorOut, *genInfo)},
+        {"SLICES", std::to_string(SliceCount)},
+        {"ENTRIES", std::to_string(SliceEntriesCount)},
+        {"SLICE_STEP", *sliceStep},
+        {"BYTE_UPDATE", ByteUpdateTempl},
+        {"TABLE", generatedAlgTable(*genInfo)},
+    };
+
+    if (!genInfo->m_reflected) {
+        util::ReplacementMap byteRepl = {
+            {"TOP_SHIFT", std::to_string(genInfo->m_width - 8U)},
+        };
+
+        repl["BYTE_UPDATE"] = util::processTemplate(ByteUpdateNormalTempl, byteRepl);
+    }
+
+    if (genInfo->m_alg == ChecksumAlg::Crc_32C) {
+        // The SSE4.2 crc32 instruction implements exactly the CRC-32C polynomial
+        static const std::string HwDefineTempl = 
+            "#if !defined(#^#NS_UPPER#$#_CHECKSUM_NO_HW_ACCEL) && defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))\n"
+            "#define #^#HW_MACRO#$#\n"
+            "#include <nmmintrin.h>\n"
+            "#endif\n";
+
+        static const std::string HwDispatchTempl = 
+            "#ifdef #^#HW_MACRO#$#\n"
+            "if (hwSupportedInternal()) {\n"
+            "    return hwCalcInternal(InitValue, data, len);\n"
+            "}\n"
+            "#endif // #ifdef #^#HW_MACRO#$#\n";
+
+        static const std::string HwFuncsTempl = 
+            "#ifdef #^#HW_MACRO#$#\n"
+            "static bool hwSupportedInternal()\n"
+            "{\n"
+            "    static const bool Supported = (__builtin_cpu_init(), __builtin_cpu_supports(\"sse4.2\") != 0);\n"
+            "    return Supported;\n"
+            "}\n\n"
+            "__attribute__((target(\"sse4.2\")))\n"
+            "static ResultType hwCalcInternal(ResultType crc, const std::uint8_t* data, std::size_t len)\n"
+            "{\n"
+            "    std::uint64_t crc64 = crc;\n"
+            "    while (8U <= len) {\n"
+            "        std::uint64_t chunk = 0U;\n"
+            "        std::memcpy(&chunk, data, sizeof(chunk));\n"
+            "        crc64 = _mm_crc32_u64(crc64, chunk);\n"
+            "        data += 8;\n"
+            "        len -= 8U;\n"
+            "    }\n\n"
+            "    auto crc32 = static_cast<std::uint32_t>(crc64);\n"
+            "    for (; len > 0U; --len) {\n"
+            "        crc32 = _mm_crc32_u8(crc32, *data);\n"
+            "        ++data;\n"
+            "    }\n"
+            "    return crc32;\n"
+            "}\n"
+            "#endif // #ifdef #^#HW_MACRO#$#\n";
+
+        util::ReplacementMap hwRepl = {
+            {"NS_UPPER", util::strToUpper(ns)},
+            {"HW_MACRO", util::strToUpper(ns) + "_" + util::strToUpper(className) + "_HW_ACCEL"},
+        };
+
+        repl["HW_DEFINE"] = util::processTemplate(HwDefineTempl, hwRepl);
+        repl["HW_DISPATCH"] = util::processTemplate(HwDispatchTempl, hwRepl);
+        repl["HW_FUNCS"] = util::processTemplate(HwFuncsTempl, hwRepl);
+        repl["HW_UNDEF"] = "#undef " + hwRepl["HW_MACRO"];
+        repl["HW_DOC"] = 
+            "///     On x86-64 the SSE4.2 @b crc32 instruction is used instead when the CPU\n"
+            "///     supports it (detected at runtime), unless @b " + hwRepl["NS_UPPER"] + "_CHECKSUM_NO_HW_ACCEL\n"
+            "///     is defined.";
+    }
+
+    stream << util::processTemplate(Templ, repl, true);
+    stream.flush();
+
+    if (!stream.good()) {
+        gen.logger().error("Failed to write \"" + filePath + "\".");
+        return false;
+    }
+
+    return true;
+}
+
 } // namespace commsdsl2comms
@@ -30,6 +30,12 @@ class CommsChecksumLayer final : public commsdsl::gen::ChecksumLayer, public Com
 public:
     CommsChecksumLayer(CommsGenerator& generator, commsdsl::parse::Layer dslObj, commsdsl::gen::Elem* parent);
 
+    // Calculator class of the CRC algorithms, empty for others
+    std::string commsCrcCalcType() const;
+
+    // Writes the CRC calculators used by the current schema, once per algorithm
+    static bool commsWriteCrcCalcs(CommsGenerator& generator);
+
 protected:
     virtual bool prepareImpl() override;
     
@@ -40,6 +46,7 @@ protected:
 private:
     std::string commsDefAlgInternal() const;
     std::string commsDefExtraOptInternal() const;
+    static bool commsWriteCrcCalcInternal(CommsGenerator& generator, commsdsl::parse::ChecksumLayer::Alg alg);
 };
 
 } // namespace commsdsl2comms
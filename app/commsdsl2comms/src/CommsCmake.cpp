@@ -40,7 +40,9 @@ using ReplacementMap = util::ReplacementMap;
 bool CommsCmake::write(CommsGenerator& generator)
 {
     CommsCmake obj(generator);
-    return obj.commsWriteInternal();
+    return 
+        obj.commsWriteInternal() &&
+        obj.commsWriteHeadersBudgetInternal();
 }
 
 bool CommsCmake::commsWriteInternal() const
@@ -60,12 +62,23 @@ bool CommsCmake::commsWriteInternal() const
     const std::string Templ = 
         "cmake_minimum_required (VERSION 3.1)\n"
         "project (\"#^#NAME#$#\")\n\n"
-        "option (OPT_REQUIRE_COMMS_LIB \"Require COMMS library, find it and set as dependency to the protocol library\" ON)\n\n"
+        "option (OPT_REQUIRE_COMMS_LIB \"Require COMMS library, find it and set as dependency to the protocol library\" ON)\n"
+        "option (OPT_EXPLICIT_INSTANTIATION_LIB \"Build static library explicitly instantiating messages and frames of the protocol\" OFF)\n"
+        "option (OPT_HEADERS_BUDGET_CHECK \"Define target reporting (and limiting) preprocessed size of every protocol header\" OFF)\n"
+        "option (OPT_BUILD_JSON_BENCH \"Build benchmark of the JSON serialization of all the protocol messages\" OFF)\n"
+        "option (OPT_BUILD_VARINT_BENCH \"Build benchmark of the bulk read / write of the lists of variable length integers\" OFF)\n"
+        "option (OPT_BUILD_CHECKSUM_BENCH \"Build benchmark of the CRC calculators used by the protocol frames\" OFF)\n\n"
         "# Other parameters:\n"
         "# OPT_CMAKE_EXPORT_NAMESPACE - Set namespace for a protocol library\n"
         "#     exported via generated *Config.cmake file. Defaults to \"cc\".\n"
         "# OPT_CMAKE_EXPORT_CONFIG_NAME - Override default name \"#^#NAME#$#\" of the cmake generated config file export\n"
-        "#     (#^#NAME#$#Config) with provided new name.\n\n"
+        "#     (#^#NAME#$#Config) with provided new name.\n"
+        "# OPT_EXPLICIT_INSTANTIATION_INTERFACE - Type (without commas) of the common message interface\n"
+        "#     used by the explicit instantiation library. Required when OPT_EXPLICIT_INSTANTIATION_LIB is enabled.\n"
+        "# OPT_EXPLICIT_INSTANTIATION_INTERFACE_HEADER - Path to the header file defining the\n"
+        "#     OPT_EXPLICIT_INSTANTIATION_INTERFACE type. Required when OPT_EXPLICIT_INSTANTIATION_LIB is enabled.\n"
+        "# OPT_HEADERS_BUDGET_BYTES - Maximal allowed preprocessed size (in bytes) of a single protocol header\n"
+        "#     checked by the \"headers_budget_#^#NAME#$#\" target. Defaults to 0, which means report only.\n\n"
         "if (CMAKE_TOOLCHAIN_FILE AND EXISTS ${CMAKE_TOOLCHAIN_FILE})\n"
         "    message(STATUS \"Loading toolchain from ${CMAKE_TOOLCHAIN_FILE}\")\n"
         "endif()\n\n"
@@ -109,7 +122,59 @@ bool CommsCmake::commsWriteInternal() const
         "if (\"${OPT_CMAKE_EXPORT_CONFIG_NAME}\" STREQUAL \"\")\n"
         "    set (OPT_CMAKE_EXPORT_CONFIG_NAME \"#^#NAME#$#\")\n"
         "endif ()\n\n"
-        "install(TARGETS #^#NAME#$# EXPORT ${OPT_CMAKE_EXPORT_CONFIG_NAME}Config)\n"
+        "set (install_targets #^#NAME#$#)\n"
+        "if (OPT_EXPLICIT_INSTANTIATION_LIB)\n"
+        "    if ((\"${OPT_EXPLICIT_INSTANTIATION_INTERFACE}\" STREQUAL \"\") OR\n"
+        "        (\"${OPT_EXPLICIT_INSTANTIATION_INTERFACE_HEADER}\" STREQUAL \"\"))\n"
+        "        message (FATAL_ERROR \"OPT_EXPLICIT_INSTANTIATION_INTERFACE and OPT_EXPLICIT_INSTANTIATION_INTERFACE_HEADER must be provided\")\n"
+        "    endif ()\n\n"
+        "    set (explicit_lib \"#^#NAME#$#_explicit\")\n"
+        "    add_library(${explicit_lib} STATIC ${CMAKE_CURRENT_SOURCE_DIR}/src/ExplicitInstantiation.cpp)\n"
+        "    target_link_libraries(${explicit_lib} PUBLIC #^#NAME#$#)\n"
+        "    target_compile_definitions(${explicit_lib} PUBLIC\n"
+        "        \"#^#CAP_NAME#$#_EXPLICIT_INSTANTIATION_INTERFACE=${OPT_EXPLICIT_INSTANTIATION_INTERFACE}\"\n"
+        "        \"#^#CAP_NAME#$#_EXPLICIT_INSTANTIATION_INTERFACE_HEADER=\\\"${OPT_EXPLICIT_INSTANTIATION_INTERFACE_HEADER}\\\"\"\n"
+        "    )\n"
+        "    list (APPEND install_targets ${explicit_lib})\n"
+        "endif ()\n\n"
+        "if (OPT_HEADERS_BUDGET_CHECK)\n"
+        "    set (budget_inc_dirs \"${CMAKE_CURRENT_SOURCE_DIR}/include\")\n"
+        "    if (TARGET cc::comms)\n"
+        "        get_target_property(comms_inc_dirs cc::comms INTERFACE_INCLUDE_DIRECTORIES)\n"
+        "        list (APPEND budget_inc_dirs ${comms_inc_dirs})\n"
+        "    endif ()\n\n"
+        "    if (\"${OPT_HEADERS_BUDGET_BYTES}\" STREQUAL \"\")\n"
+        "        set (OPT_HEADERS_BUDGET_BYTES 0)\n"
+        "    endif ()\n\n"
+        "    string (REPLACE \";\" \"|\" budget_inc_dirs \"${budget_inc_dirs}\")\n"
+        "    add_custom_target(\"headers_budget_#^#NAME#$#\"\n"
+        "        COMMAND ${CMAKE_COMMAND}\n"
+        "            -DCXX_COMPILER=${CMAKE_CXX_COMPILER}\n"
+        "            \"-DINCLUDE_DIRS=${budget_inc_dirs}\"\n"
+        "            -DHEADERS_DIR=${CMAKE_CURRENT_SOURCE_DIR}/include/#^#NAME#$#\n"
+        "            -DBUDGET=${OPT_HEADERS_BUDGET_BYTES}\n"
+        "            -P ${CMAKE_CURRENT_SOURCE_DIR}/cmake/HeadersBudget.cmake\n"
+        "        WORKING_DIRECTORY ${CMAKE_CURRENT_BINARY_DIR}\n"
+        "    )\n"
+        "endif ()\n\n"
+        "if (OPT_BUILD_JSON_BENCH)\n"
+        "    set (json_bench \"json_bench_#^#NAME#$#\")\n"
+        "    add_executable(${json_bench} ${CMAKE_CURRENT_SOURCE_DIR}/src/JsonBench.cpp)\n"
+        "    target_link_libraries(${json_bench} PRIVATE #^#NAME#$#)\n"
+        "endif ()\n\n"
+        "if (OPT_BUILD_VARINT_BENCH AND EXISTS ${CMAKE_CURRENT_SOURCE_DIR}/src/VarintBench.cpp)\n"
+        "    set (varint_bench \"varint_bench_#^#NAME#$#\")\n"
+        "    add_executable(${varint_bench} ${CMAKE_CURRENT_SOURCE_DIR}/src/VarintBench.cpp)\n"
+        "    target_link_libraries(${varint_bench} PRIVATE #^#NAME#$#)\n"
+        "endif ()\n\n"
+        "if (OPT_BUILD_CHECKSUM_BENCH AND EXISTS ${CMAKE_CURRENT_SOURCE_DIR}/src/ChecksumBench.cpp)\n"
+        "    set (checksum_bench \"checksum_bench_#^#NAME#$#\")\n"
+        "    add_executable(${checksum_bench} ${CMAKE_CURRENT_SOURCE_DIR}/src/ChecksumBench.cpp)\n"
+        "    target_link_libraries(${checksum_bench} PRIVATE #^#NAME#$#)\n"
+        "endif ()\n\n"
+        "install(TARGETS ${install_targets} EXPORT ${OPT_CMAKE_EXPORT_CONFIG_NAME}Config\n"
+        "    ARCHIVE DESTINATION ${CMAKE_INSTALL_LIBDIR}\n"
+        ")\n"
         "install(EXPORT ${OPT_CMAKE_EXPORT_CONFIG_NAME}Config\n"
         "    DESTINATION ${CMAKE_INSTALL_LIBDIR}/${OPT_CMAKE_EXPORT_CONFIG_NAME}/cmake\n"
         "    NAMESPACE ${OPT_CMAKE_EXPORT_NAMESPACE}::\n"
@@ -156,4 +221,83 @@ bool CommsCmake::commsWriteInternal() const
     return true;    
 }
 
+bool CommsCmake::commsWriteHeadersBudgetInternal() const
+{
+    auto dirPath = util::pathAddElem(m_generator.getOutputDir(), "cmake");
+    if (!m_generator.createDirectory(dirPath)) {
+        return false;
+    }
+
+    auto filePath = util::pathAddElem(dirPath, "HeadersBudget.cmake");
+    m_generator.logger().info("Generating " + filePath);
+    std::ofstream stream(filePath);
+    if (!stream) {
+        m_generator.logger().error("Failed to open \"" + filePath + "\" for writing.");
+        return false;
+    }
+
+    const std::string Templ = 
+        "# Preprocesses every protocol header in a separate translation unit and\n"
+        "# reports its preprocessed size, sorted from the largest.\n"
+        "# Expected parameters:\n"
+        "# CXX_COMPILER - Path to the C++ compiler (GCC or Clang compatible command line).\n"
+        "# INCLUDE_DIRS - Include directories separated by \"|\".\n"
+        "# HEADERS_DIR - Directory of the protocol headers.\n"
+        "# BUDGET - Maximal allowed preprocessed size in bytes, 0 means report only.\n"
+        "# CXX_STANDARD - Optional C++ standard to use, defaults to 11.\n\n"
+        "if (\"${CXX_STANDARD}\" STREQUAL \"\")\n"
+        "    set (CXX_STANDARD 11)\n"
+        "endif ()\n\n"
+        "string (REPLACE \"|\" \";\" inc_dirs \"${INCLUDE_DIRS}\")\n"
+        "set (inc_opts)\n"
+        "foreach (dir ${inc_dirs})\n"
+        "    list (APPEND inc_opts \"-I${dir}\")\n"
+        "endforeach ()\n\n"
+        "get_filename_component(prot_name ${HEADERS_DIR} NAME)\n"
+        "file (GLOB_RECURSE headers RELATIVE \"${HEADERS_DIR}\" \"${HEADERS_DIR}/*.h\")\n"
+        "set (src_file \"${CMAKE_CURRENT_BINARY_DIR}/headers_budget_${prot_name}.cpp\")\n"
+        "set (report)\n"
+        "set (exceeded)\n"
+        "foreach (hdr ${headers})\n"
+        "    file (WRITE ${src_file} \"#include \\\"${prot_name}/${hdr}\\\"\\n\")\n"
+        "    execute_process(\n"
+        "        COMMAND ${CXX_COMPILER} -std=c++${CXX_STANDARD} -E -P ${inc_opts} ${src_file}\n"
+        "        OUTPUT_VARIABLE output\n"
+        "        ERROR_VARIABLE errors\n"
+        "        RESULT_VARIABLE result\n"
+        "    )\n\n"
+        "    if (NOT result EQUAL 0)\n"
+        "        message (WARNING \"Failed to preprocess ${hdr}:\\n${errors}\")\n"
+        "    else ()\n"
+        "        string (LENGTH \"${output}\" size)\n"
+        "        string (LENGTH \"${size}\" size_digits)\n"
+        "        string (SUBSTRING \"0000000000\" ${size_digits} -1 padding)\n"
+        "        list (APPEND report \"${padding}${size} ${hdr}\")\n"
+        "        if ((0 LESS BUDGET) AND (BUDGET LESS size))\n"
+        "            list (APPEND exceeded ${hdr})\n"
+        "        endif ()\n"
+        "    endif ()\n"
+        "endforeach ()\n\n"
+        "file (REMOVE ${src_file})\n"
+        "list (SORT report)\n"
+        "list (REVERSE report)\n"
+        "foreach (line ${report})\n"
+        "    message (STATUS \"${line}\")\n"
+        "endforeach ()\n\n"
+        "if (exceeded)\n"
+        "    string (REPLACE \";\" \"\\n    \" exceeded \"${exceeded}\")\n"
+        "    message (FATAL_ERROR \"Preprocessed size of the following headers exceeds ${BUDGET} bytes:\\n    ${exceeded}\")\n"
+        "endif ()\n"
+        ;
+
+    stream << Templ;
+    stream.flush();
+    if (!stream.good()) {
+        m_generator.logger().error("Failed to write \"" + filePath + "\".");
+        return false;
+    }
+
+    return true;
+}
+
 } // namespace commsdsl2comms
\ No newline at end of file
@@ -28,6 +28,7 @@ private:
     explicit CommsCmake(CommsGenerator& generator) : m_generator(generator) {}
 
     bool commsWriteInternal() const;
+    bool commsWriteHeadersBudgetInternal() const;
     
 private:
     CommsGenerator& m_generator;
@@ -0,0 +1,459 @@
+//
+// Copyright 2019 - 2023 (C). Alex Robenko. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "CommsColumnar.h"
+
+#include "CommsGenerator.h"
+
+#include "commsdsl/gen/BitfieldField.h"
+#include "commsdsl/gen/BundleField.h"
+#include "commsdsl/gen/ListField.h"
+#include "commsdsl/gen/OptionalField.h"
+#include "commsdsl/gen/RefField.h"
+#include "commsdsl/gen/comms.h"
+#include "commsdsl/gen/strings.h"
+#include "commsdsl/gen/util.h"
+
+#include <cassert>
+#include <fstream>
+#include <set>
+
+namespace comms = commsdsl::gen::comms;
+namespace strings = commsdsl::gen::strings;
+namespace util = commsdsl::gen::util;
+
+namespace commsdsl2comms
+{
+
+namespace
+{
+
+const std::string ColumnarStr("Columnar");
+
+struct ColumnsInfo
+{
+    util::StringsList m_decls;
+    util::StringsList m_clears;
+    std::set<std::string> m_names;
+    util::StringsList m_duplicates;
+};
+
+// The prefix prevents collision with the non-column members
+std::string columnMemberInternal(const std::string& name)
+{
+    return "m_col_" + name;
+}
+
+void addColumnInternal(
+    const std::string& type,
+    const std::string& name,
+    const std::string& desc,
+    ColumnsInfo& info)
+{
+    if (!info.m_names.insert(name).second) {
+        info.m_duplicates.push_back(name);
+    }
+
+    auto member = columnMemberInternal(name);
+    info.m_decls.push_back(
+        "/// @brief " + desc + "\n"
+        "std::vector<" + type + "> " + member + ";");
+    info.m_clears.push_back(member + ".clear();");
+}
+
+void addFieldColumnsInternal(
+    const commsdsl::gen::Field& field,
+    const std::string& typeStr,
+    const std::string& accStr,
+    const std::string& colName,
+    unsigned depth,
+    ColumnsInfo& info,
+    util::StringsList& appends);
+
+void addMemberColumnsInternal(
+    const commsdsl::gen::Field& field,
+    const std::string& parentTypeStr,
+    const std::string& parentAccStr,
+    const std::string& parentColName,
+    unsigned depth,
+    ColumnsInfo& info,
+    util::StringsList& appends)
+{
+    auto accName = comms::accessName(field.dslObj().name());
+    auto typeStr = parentTypeStr + "::Field_" + accName;
+    auto accStr = parentAccStr + ".field_" + accName + "()";
+    auto colName = accName;
+    if (!parentColName.empty()) {
+        colName = parentColName + '_' + accName;
+    }
+
+    if (comms::isVersionOptionalField(field, field.generator())) {
+        // Distinct from the flags of the optional field itself wrapped by the version dependent one
+        auto existsName = colName + "_version_exists";
+        addColumnInternal("std::uint8_t", existsName, "Version dependent existence flags of the @b " + colName + " field.", info);
+        appends.push_back(columnMemberInternal(existsName) + ".push_back(static_cast<std::uint8_t>(" + accStr + ".doesExist()));");
+        typeStr += "::Field";
+        accStr += ".field()";
+    }
+
+    addFieldColumnsInternal(field, typeStr, accStr, colName, depth, info, appends);
+}
+
+void addFieldColumnsInternal(
+    const commsdsl::gen::Field& field,
+    const std::string& typeStr,
+    const std::string& accStr,
+    const std::string& colName,
+    unsigned depth,
+    ColumnsInfo& info,
+    util::StringsList& appends)
+{
+    using Kind = commsdsl::parse::Field::Kind;
+    auto kind = field.dslObj().kind();
+    switch (kind) {
+        case Kind::Int:
+        case Kind::Enum:
+        case Kind::Set:
+        case Kind::Float:
+            addColumnInternal("typename " + typeStr + "::ValueType", colName, "Values of the @b " + colName + " field.", info);
+            appends.push_back(columnMemberInternal(colName) + ".push_back(" + accStr + ".value());");
+            break;
+
+        case Kind::Bitfield:
+            for (auto& m : static_cast<const commsdsl::gen::BitfieldField&>(field).members()) {
+                addMemberColumnsInternal(*m, typeStr, accStr, colName, depth, info, appends);
+            }
+            break;
+
+        case Kind::Bundle:
+            for (auto& m : static_cast<const commsdsl::gen::BundleField&>(field).members()) {
+                addMemberColumnsInternal(*m, typeStr, accStr, colName, depth, info, appends);
+            }
+            break;
+
+        case Kind::String:
+        case Kind::Data:
+        {
+            auto offsetsName = colName + "_offsets";
+            addColumnInternal("typename " + typeStr + "::ValueType::value_type", colName, "Concatenated values of the @b " + colName + " field.", info);
+            addColumnInternal("std::size_t", offsetsName, "End offsets of the @b " + colName + " field values.", info);
+            appends.push_back(columnMemberInternal(colName) + ".insert(" + columnMemberInternal(colName) + ".end(), " + accStr + ".value().begin(), " + accStr + ".value().end());");
+            appends.push_back("details::appendOffset(" + columnMemberInternal(offsetsName) + ", " + accStr + ".value().size());");
+            break;
+        }
+
+        case Kind::List:
+        {
+            auto& listField = static_cast<const commsdsl::gen::ListField&>(field);
+            auto* elemField = listField.memberElementField();
+            if (elemField == nullptr) {
+                elemField = listField.externalElementField();
+            }
+
+            assert(elemField != nullptr);
+            auto elemStr = "elem" + std::to_string(depth);
+            util::StringsList loopBody;
+            addFieldColumnsInternal(*elemField, typeStr + "::ValueType::value_type", elemStr, colName + "_elem", depth + 1U, info, loopBody);
+            if (!loopBody.empty()) {
+                appends.push_back(
+                    "for (auto& " + elemStr + " : " + accStr + ".value()) {\n" +
+                    util::strInsertIndent(util::strListToString(loopBody, "\n", "")) + "\n"
+                    "}");
+            }
+
+            auto offsetsName = colName + "_offsets";
+            addColumnInternal("std::size_t", offsetsName, "End offsets of the @b " + colName + " field elements.", info);
+            appends.push_back("details::appendOffset(" + columnMemberInternal(offsetsName) + ", " + accStr + ".value().size());");
+            break;
+        }
+
+        case Kind::Optional:
+        {
+            auto& optField = static_cast<const commsdsl::gen::OptionalField&>(field);
+            auto* innerField = optField.memberField();
+            if (innerField == nullptr) {
+                innerField = optField.externalField();
+            }
+
+            assert(innerField != nullptr);
+            auto existsName = colName + "_exists";
+            addColumnInternal("std::uint8_t", existsName, "Existence flags of the @b " + colName + " field.", info);
+            appends.push_back(columnMemberInternal(existsName) + ".push_back(static_cast<std::uint8_t>(" + accStr + ".doesExist()));");
+            addFieldColumnsInternal(*innerField, typeStr + "::Field", accStr + ".field()", colName, depth, info, appends);
+            break;
+        }
+
+        case Kind::Ref:
+        {
+            auto* refField = static_cast<const commsdsl::gen::RefField&>(field).referencedField();
+            assert(refField != nullptr);
+            addFieldColumnsInternal(*refField, typeStr, accStr, colName, depth, info, appends);
+            break;
+        }
+
+        case Kind::Variant:
+        {
+            auto idxName = colName + "_idx";
+            addColumnInternal("std::size_t", idxName, "Indices of the selected members of the @b " + colName + " field.", info);
+            appends.push_back(columnMemberInternal(idxName) + ".push_back(" + accStr + ".currentField());");
+            break;
+        }
+
+        default:
+            break;
+    }
+}
+
+std::string columnsClassNameInternal(const commsdsl::gen::Message& msg, const CommsGenerator& generator)
+{
+    auto tokens = util::strSplitByAnyChar(comms::scopeFor(msg, generator, false), ":");
+    std::string result;
+    for (auto& t : tokens) {
+        if (t == strings::messageNamespaceStr()) {
+            continue;
+        }
+
+        result += comms::className(t);
+    }
+
+    return result + "Columns";
+}
+
+} // namespace
+
+bool CommsColumnar::write(CommsGenerator& generator)
+{
+    CommsColumnar obj(generator);
+    return obj.commsWriteInternal();
+}
+
+bool CommsColumnar::commsWriteInternal() const
+{
+    auto filePath = comms::headerPathRoot(ColumnarStr, m_generator);
+    m_generator.logger().info("Generating " + filePath);
+
+    auto dirPath = util::pathUp(filePath);
+    assert(!dirPath.empty());
+    if (!m_generator.createDirectory(dirPath)) {
+        return false;
+    }
+
+    std::ofstream stream(filePath);
+    if (!stream) {
+        m_generator.logger().error("Failed to open \"" + filePath + "\" for writing.");
+        return false;
+    }
+
+    util::StringsList includes = {
+        "<cstddef>",
+        "<cstdint>",
+        "<vector>",
+        comms::relHeaderForOptions(strings::defaultOptionsClassStr(), m_generator)
+    };
+
+    util::StringsList classes;
+    util::StringsList handleFuncs;
+    util::StringsList flushCalls;
+    util::StringsList members;
+
+    static const std::string ClassTempl =
+        "/// @brief Columns of the @ref #^#SCOPE#$# message fields.\n"
+        "/// @details The names of the column members are flattened names of the\n"
+        "///     fields prefixed with @b m_col_.\n"
+        "/// @tparam TMsg Type of the message, instantiated @ref #^#SCOPE#$# class.\n"
+        "template <typename TMsg>\n"
+        "struct #^#CLASS_NAME#$#\n"
+        "{\n"
+        "    /// @brief Type of the message\n"
+        "    using Message = TMsg;\n\n"
+        "    #^#DECLS#$#\n"
+        "    /// @brief Amount of the appended messages.\n"
+        "    std::size_t m_rows = 0U;\n\n"
+        "    /// @brief Append values of the message fields to the columns.\n"
+        "    void append(const TMsg& msg)\n"
+        "    {\n"
+        "        #^#APPENDS#$#\n"
+        "        ++m_rows;\n"
+        "    }\n\n"
+        "    /// @brief Remove all the values, the allocated capacity is retained.\n"
+        "    void clear()\n"
+        "    {\n"
+        "        #^#CLEARS#$#\n"
+        "        m_rows = 0U;\n"
+        "    }\n"
+        "};\n";
+
+    static const std::string HandleTempl =
+        "/// @brief Append the @ref #^#SCOPE#$# message to its columns.\n"
+        "void handle(const #^#SCOPE#$#<TInterface, TOpt>& msg)\n"
+        "{\n"
+        "    appendInternal(#^#MEMBER#$#, msg);\n"
+        "}\n";
+
+    auto allMessages = m_generator.getAllMessagesIdSorted();
+    for (auto* m : allMessages) {
+        assert(m != nullptr);
+        auto scopeStr = comms::scopeFor(*m, m_generator);
+        auto className = columnsClassNameInternal(*m, m_generator);
+        auto memberName = "m_" + comms::accessName(className);
+
+        ColumnsInfo info;
+        util::StringsList appends;
+        for (auto& f : m->fields()) {
+            addMemberColumnsInternal(*f, "TMsg", "msg", std::string(), 0U, info, appends);
+        }
+
+        if (!info.m_duplicates.empty()) {
+            m_generator.logger().error(
+                "Flattened names of the fields of the \"" + m->dslObj().externalRef() + "\" message "
+                "produce duplicate columns: " + util::strListToString(info.m_duplicates, ", ", "") + ".");
+            return false;
+        }
+
+        if (appends.empty()) {
+            appends.push_back("static_cast<void>(msg);");
+        }
+
+        util::ReplacementMap classRepl = {
+            {"SCOPE", scopeStr},
+            {"CLASS_NAME", className},
+            {"DECLS", util::strListToString(info.m_decls, "\n\n", "\n")},
+            {"APPENDS", util::strListToString(appends, "\n", "")},
+            {"CLEARS", util::strListToString(info.m_clears, "\n", "")},
+        };
+
+        util::ReplacementMap handleRepl = {
+            {"SCOPE", scopeStr},
+            {"MEMBER", memberName},
+        };
+
+        includes.push_back(comms::relHeaderPathFor(*m, m_generator));
+        classes.push_back(util::processTemplate(ClassTempl, classRepl));
+        handleFuncs.push_back(util::processTemplate(HandleTempl, handleRepl));
+        flushCalls.push_back("flushInternal(" + memberName + ");");
+        members.push_back(className + "<" + scopeStr + "<TInterface, TOpt> > " + memberName + ";");
+    }
+
+    static const std::string Templ =
+        "#^#GENERATED#$#\n"
+        "/// @file\n"
+        "/// @brief Contains columnar (per field) export of the decoded protocol messages.\n"
+        "/// @details Not used by the protocol definition itself and needs to be\n"
+        "///     included explicitly. Every scalar field value is appended to the contiguous\n"
+        "///     typed column, while the strings, data, and lists are represented by the\n"
+        "///     concatenated values column accompanied by the column of the end offsets.\n"
+        "///     The columns of the list elements are populated per element, while the\n"
+        "///     variant fields record only the index of the selected member. The columns\n"
+        "///     are populated from the fully decoded message objects, i.e. the columnar\n"
+        "///     export comes in addition to the regular message decoding.\n\n"
+        "#pragma once\n\n"
+        "#^#INCLUDES#$#\n"
+        "namespace #^#PROT_NAMESPACE#$#\n"
+        "{\n\n"
+        "namespace columnar\n"
+        "{\n\n"
+        "namespace details\n"
+        "{\n\n"
+        "template <typename TOffsets>\n"
+        "void appendOffset(TOffsets& offsets, std::size_t count)\n"
+        "{\n"
+        "    offsets.push_back((offsets.empty() ? 0U : offsets.back()) + count);\n"
+        "}\n\n"
+        "} // namespace details\n\n"
+        "#^#CLASSES#$#\n"
+        "/// @brief Message handler appending the handled messages to their columns.\n"
+        "/// @details When amount of the appended messages of a particular type reaches\n"
+        "///     the configured chunk size, the columns are passed to the provided\n"
+        "///     handler and then cleared. The same column objects are reused for\n"
+        "///     the whole stream, i.e. no memory allocation is expected once the\n"
+        "///     first chunk is flushed.\n"
+        "/// @tparam TInterface Common interface class of the messages.\n"
+        "/// @tparam THandler Type of the handler, expected to define @b operator()\n"
+        "///     accepting const reference to every columns type (can be a template).\n"
+        "/// @tparam TOpt Protocol definition options.\n"
+        "template <typename TInterface, typename THandler, typename TOpt = #^#OPTIONS#$#>\n"
+        "class Sink\n"
+        "{\n"
+        "public:\n"
+        "    /// @brief Constructor\n"
+        "    /// @param[in] handler Handler of the flushed columns, not owned by the sink.\n"
+        "    /// @param[in] chunkSize Amount of the messages in a single flushed chunk.\n"
+        "    explicit Sink(THandler& handler, std::size_t chunkSize = 1024U) :\n"
+        "        m_handler(handler),\n"
+        "        m_chunkSize(chunkSize)\n"
+        "    {\n"
+        "    }\n\n"
+        "    #^#HANDLE_FUNCS#$#\n"
+        "    /// @brief Ignore the rest of the messages.\n"
+        "    void handle(const TInterface& msg)\n"
+        "    {\n"
+        "        static_cast<void>(msg);\n"
+        "    }\n\n"
+        "    /// @brief Pass all the columns that still contain values to the handler.\n"
+        "    void flush()\n"
+        "    {\n"
+        "        #^#FLUSH_CALLS#$#\n"
+        "    }\n\n"
+        "private:\n"
+        "    template <typename TColumns, typename TMsg>\n"
+        "    void appendInternal(TColumns& columns, const TMsg& msg)\n"
+        "    {\n"
+        "        columns.append(msg);\n"
+        "        if (m_chunkSize <= columns.m_rows) {\n"
+        "            flushInternal(columns);\n"
+        "        }\n"
+        "    }\n\n"
+        "    template <typename TColumns>\n"
+        "    void flushInternal(TColumns& columns)\n"
+        "    {\n"
+        "        if (columns.m_rows == 0U) {\n"
+        "            return;\n"
+        "        }\n\n"
+        "        m_handler(static_cast<const TColumns&>(columns));\n"
+        "        columns.clear();\n"
+        "    }\n\n"
+        "    THandler& m_handler;\n"
+        "    std::size_t m_chunkSize = 0U;\n"
+        "    #^#MEMBERS#$#\n"
+        "};\n\n"
+        "} // namespace columnar\n\n"
+        "} // namespace #^#PROT_NAMESPACE#$#\n\n"
+        "#^#APPEND#$#\n"
+        ;
+
+    comms::prepareIncludeStatement(includes);
+    util::ReplacementMap repl = {
+        {"GENERATED", CommsGenerator::commsFileGeneratedComment()},
+        {"PROT_NAMESPACE", m_generator.currentSchema().mainNamespace()},
+        {"INCLUDES", util::strListToString(includes, "\n", "\n")},
+        {"OPTIONS", comms::scopeForOptions(strings::defaultOptionsClassStr(), m_generator)},
+        {"CLASSES", util::strListToString(classes, "\n", "\n")},
+        {"HANDLE_FUNCS", util::strListToString(handleFuncs, "\n", "\n")},
+        {"FLUSH_CALLS", util::strListToString(flushCalls, "\n", "")},
+        {"MEMBERS", util::strListToString(members, "\n", "")},
+        {"APPEND", util::readFileContents(comms::inputCodePathForRoot(ColumnarStr, m_generator))},
+    };
+
+    stream << util::processTemplate(Templ, repl, true);
+    stream.flush();
+    if (!stream.good()) {
+        m_generator.logger().error("Failed to write \"" + filePath + "\".");
+        return false;
+    }
+
+    return true;
+}
+
+} // namespace commsdsl2comms
@@ -345,6 +345,21 @@ CommsDataField::StringsList CommsDataField::commsExtraBareMetalDefaultOptionsImp
         };    
 }
 
+CommsDataField::StringsList CommsDataField::commsExtraBoundedBareMetalDefaultOptionsImpl() const
+{
+    auto obj = dataDslObj();
+    if (obj.fixedLength() != 0U) {
+        return StringsList();
+    }
+
+    std::uintmax_t capacity = 0U;
+    if (obj.hasLengthPrefixField()) {
+        capacity = commsBoundedStorageMaxPrefixValue(obj.lengthPrefixField());
+    }
+
+    return commsBoundedStorageOpts(capacity);
+}
+
 std::size_t CommsDataField::commsMaxLengthImpl() const
 {
     auto obj = dataDslObj();
@@ -202,6 +202,8 @@ bool CommsDefaultOptions::commsWriteInternal() const
         commsWriteServerDefaultOptionsInternal() &&
         commsWriteDataViewDefaultOptionsInternal() &&
         commsWriteBareMetalDefaultOptionsInternal() &&
+        commsWriteBoundedBareMetalDefaultOptionsInternal() &&
+        commsWriteFixedVersionDefaultOptionsInternal() &&
         commsWriteMsgFactoryDefaultOptionsInternal();
 }
 
@@ -338,6 +340,107 @@ bool CommsDefaultOptions::commsWriteBareMetalDefaultOptionsInternal() const
     return true;
 }
 
+bool CommsDefaultOptions::commsWriteBoundedBareMetalDefaultOptionsInternal() const
+{
+    static const std::string Templ = 
+        "#^#GENERATED#$#\n"
+        "/// @file\n"
+        "/// @brief Contains definition of protocol bounded bare metal default options.\n\n"
+        "#pragma once\n\n"
+        "#include \"#^#PROT_NAMESPACE#$#/options/#^#BARE_METAL#$#DefaultOptions.h\"\n\n"
+        "namespace #^#PROT_NAMESPACE#$#\n"
+        "{\n\n"
+        "namespace options\n"
+        "{\n\n"
+        "/// @brief Default bare metal options of the protocol with the storage\n"
+        "///     sizes derived from the schema.\n"
+        "/// @details The fixed storage capacity of the lists, strings, and data\n"
+        "///     fields is derived from the maximal value of their count or length\n"
+        "///     prefixes. The fields that cannot be bounded this way (reported\n"
+        "///     by the code generator) keep the storage size defined by the\n"
+        "///     @ref #^#BARE_METAL#$#DefaultOptionsT.\n"
+        "template <typename TBase = #^#BARE_METAL_OPTS#$#>\n"
+        "struct #^#NAME#$#DefaultOptionsT : public TBase\n"
+        "{\n"
+        "    #^#BODY#$#\n"
+        "};\n\n"
+        "/// @brief Alias to @ref #^#NAME#$#DefaultOptionsT with default template parameter.\n"
+        "using #^#NAME#$#DefaultOptions#^#ORIG#$# = #^#NAME#$#DefaultOptionsT<>;\n\n"
+        "#^#EXTEND#$#\n"
+        "#^#APPEND#$#\n"
+        "} // namespace options\n\n"
+        "} // namespace #^#PROT_NAMESPACE#$#\n";
+
+    util::ReplacementMap repl = extInitialRepl(m_generator);
+    auto prefix = "Bounded" + strings::bareMetalStr();
+    auto name = prefix + strings::defaultOptionsClassStr();
+    repl.insert({
+        {"NAME", prefix},
+        {"BARE_METAL", strings::bareMetalStr()},
+        {"BARE_METAL_OPTS", comms::scopeForOptions(strings::bareMetalStr() + strings::defaultOptionsClassStr(), m_generator)},
+        {"BODY", optionsBodyInternal(m_generator, &CommsNamespace::commsBoundedBareMetalDefaultOptions, true)},
+        {"EXTEND", util::readFileContents(comms::inputCodePathForOptions(name, m_generator) + strings::extendFileSuffixStr())},
+        {"APPEND", util::readFileContents(comms::inputCodePathForOptions(name, m_generator) + strings::appendFileSuffixStr())},
+    });
+
+    if (!repl["EXTEND"].empty()) {
+        repl["ORIG"] = strings::origSuffixStr();
+    }
+
+    writeFileInternal(name, m_generator, util::processTemplate(Templ, repl, true));
+    return true;
+}
+
+bool CommsDefaultOptions::commsWriteFixedVersionDefaultOptionsInternal() const
+{
+    static const std::string Templ = 
+        "#^#GENERATED#$#\n"
+        "/// @file\n"
+        "/// @brief Contains definition of protocol default options with compile time fixed version.\n\n"
+        "#pragma once\n\n"
+        "#include <type_traits>\n\n"
+        "#include \"#^#PROT_NAMESPACE#$#/Version.h\"\n"
+        "#include \"#^#PROT_NAMESPACE#$#/options/DefaultOptions.h\"\n\n"
+        "namespace #^#PROT_NAMESPACE#$#\n"
+        "{\n\n"
+        "namespace options\n"
+        "{\n\n"
+        "/// @brief Default options of the protocol with the version frozen at compile time.\n"
+        "/// @details The version dependent checks of the fields defined with these options\n"
+        "///     ignore the runtime version information and fold into compile time constants.\n"
+        "///     The classes defined with other options keep checking the version at runtime.\n"
+        "/// @tparam TVersion Protocol version to specialise the code for.\n"
+        "/// @tparam TBase Options to extend.\n"
+        "template <unsigned TVersion = #^#SPEC_VERSION#$#, typename TBase = #^#DEFAULT_OPTS#$#>\n"
+        "struct #^#NAME#$#DefaultOptionsT : public TBase\n"
+        "{\n"
+        "    /// @brief Protocol version frozen at compile time.\n"
+        "    using FixedVersion = std::integral_constant<unsigned, TVersion>;\n"
+        "};\n\n"
+        "/// @brief Alias to @ref #^#NAME#$#DefaultOptionsT with default template parameters.\n"
+        "using #^#NAME#$#DefaultOptions#^#ORIG#$# = #^#NAME#$#DefaultOptionsT<>;\n\n"
+        "#^#EXTEND#$#\n"
+        "#^#APPEND#$#\n"
+        "} // namespace options\n\n"
+        "} // namespace #^#PROT_NAMESPACE#$#\n";
+
+    util::ReplacementMap repl = extInitialRepl(m_generator);
+    auto name = "FixedVersion" + strings::defaultOptionsClassStr();
+    repl.insert({
+        {"NAME", "FixedVersion"},
+        {"SPEC_VERSION", comms::scopeForRoot("specVersion", m_generator) + "()"},
+        {"EXTEND", util::readFileContents(comms::inputCodePathForOptions(name, m_generator) + strings::extendFileSuffixStr())},
+        {"APPEND", util::readFileContents(comms::inputCodePathForOptions(name, m_generator) + strings::appendFileSuffixStr())},
+    });
+
+    if (!repl["EXTEND"].empty()) {
+        repl["ORIG"] = strings::origSuffixStr();
+    }
+
+    writeFileInternal(name, m_generator, util::processTemplate(Templ, repl, true));
+    return true;
+}
+
 bool CommsDefaultOptions::commsWriteMsgFactoryDefaultOptionsInternal() const
 {
     if (!m_generator.isCurrentProtocolSchema()) {
@@ -35,6 +35,8 @@ private:
     bool commsWriteServerDefaultOptionsInternal() const;
     bool commsWriteDataViewDefaultOptionsInternal() const;
     bool commsWriteBareMetalDefaultOptionsInternal() const;
+    bool commsWriteBoundedBareMetalDefaultOptionsInternal() const;
+    bool commsWriteFixedVersionDefaultOptionsInternal() const;
     bool commsWriteMsgFactoryDefaultOptionsInternal() const;
     bool commsWriteAllMessagesDynMemMsgFactoryOptionsInternal() const;
     bool commsWriteClientInputMessagesDynMemMsgFactoryOptionsInternal() const;
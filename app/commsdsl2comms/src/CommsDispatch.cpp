@@ -27,6 +27,8 @@
 #include <cassert>
 #include <functional>
 #include <fstream>
+#include <utility>
+#include <vector>
 
 namespace comms = commsdsl::gen::comms;
 namespace strings = commsdsl::gen::strings;
@@ -44,6 +46,11 @@ auto getFileName(const std::string& desc = std::string())
     return "Dispatch" + desc + "Message";
 }    
 
+auto getBatchProcessorFileName(const std::string& desc)
+{
+    return desc + "MsgBatchProcessor";
+}
+
 bool writeFileInternal(
     const std::string& name,
     CommsGenerator& generator,
@@ -195,7 +202,7 @@ const std::string& singleMessagePerIdTempl()
         "{\n"
         "    return dispatch#^#NAME#$#Message<#^#DEFAULT_OPTIONS#$#>(id, idx, msg, handler);\n"
         "}\n\n"
-        "#^#DISPATCHER#$#\n"; 
+        "#^#DISPATCHER#$#\n";
     return Templ;
 }
 
@@ -293,7 +300,7 @@ const std::string& multipleMessagesPerIdTempl()
         "{\n"
         "    return dispatch#^#NAME#$#Message<#^#DEFAULT_OPTIONS#$#>(id, msg, handler);\n"
         "}\n\n"
-        "#^#DISPATCHER#$#\n"; 
+        "#^#DISPATCHER#$#\n";
     return Templ;
 }
 
@@ -318,7 +325,8 @@ bool CommsDispatch::commsWriteInternal() const
         commsWriteClientDispatchInternal() &&
         commsWriteServerDispatchInternal() &&
         commsWritePlatformDispatchInternal() &&
-        commsWriteExtraDispatchInternal();
+        commsWriteExtraDispatchInternal() &&
+        commsWriteBatchProcessorsInternal();
 }
 
 bool CommsDispatch::commsWriteDispatchInternal() const
@@ -579,16 +587,97 @@ bool CommsDispatch::commsWriteExtraDispatchInternal() const
     return true;
 }
 
+bool CommsDispatch::commsWriteBatchProcessorsInternal() const
+{
+    static const std::string Templ = 
+        "#^#GENERATED#$#\n"
+        "/// @file\n"
+        "/// @brief Contains batch decoding and dispatch of the #^#DESC#$# input messages.\n\n"
+        "#pragma once\n\n"
+        "#^#INCLUDES#$#\n"
+        "namespace #^#PROT_NAMESPACE#$#\n"
+        "{\n\n"
+        "namespace dispatch\n"
+        "{\n\n"
+        "#^#CODE#$#\n\n"
+        "} // namespace dispatch\n\n"
+        "} // namespace #^#PROT_NAMESPACE#$#\n";
+
+    std::vector<std::pair<std::string, std::string> > inputs = {
+        {std::string(), "all"},
+        {"ClientInput", "client input"},
+        {"ServerInput", "server input"},
+    };
+
+    auto addInputsFunc = 
+        [&inputs](const std::string& prefix, const std::string& desc)
+        {
+            inputs.emplace_back(prefix, desc);
+            inputs.emplace_back(prefix + "ClientInput", desc + " client input");
+            inputs.emplace_back(prefix + "ServerInput", desc + " server input");
+        };
+
+    for (auto& p : m_generator.currentSchema().platformNames()) {
+        addInputsFunc(comms::className(p), p + " platform");
+    }
+
+    for (auto& b : m_generator.commsExtraMessageBundles()) {
+        addInputsFunc(comms::className(b.first), b.first + " bundle");
+    }
+
+    for (auto& i : inputs) {
+        util::StringsList incs = {
+            "<algorithm>",
+            "<array>",
+            "<cstddef>",
+            "<iterator>",
+            "comms/ErrorStatus.h",
+            "comms/protocol/ProtocolLayerBase.h",
+            comms::relHeaderForDispatch(getFileName(i.first), m_generator),
+        };
+
+        comms::prepareIncludeStatement(incs);
+
+        util::ReplacementMap repl = initialRepl(m_generator);
+        repl.insert({
+            {"DESC", i.second},
+            {"INCLUDES", util::strListToString(incs, "\n", "\n")},
+            {"CODE", commsMsgBatchProcessorCodeInternal(i.first)}
+        });
+
+        if (!writeFileInternal(getBatchProcessorFileName(i.first), m_generator, util::processTemplate(Templ, repl, true))) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
 std::string CommsDispatch::commsIncludesInternal(const std::string& inputPrefix) const
 {
     util::StringsList incs = {
         comms::relHeaderForRoot(strings::msgIdEnumNameStr(), m_generator),
-        comms::relHeaderForInput(inputPrefix + "Messages", m_generator),
+        comms::relHeaderForRoot("Fwd", m_generator),
         comms::relHeaderForOptions(strings::defaultOptionsClassStr(), m_generator),
     };
 
     comms::prepareIncludeStatement(incs);
-    return util::strListToString(incs, "\n", "\n");
+
+    static const std::string Templ = 
+        "#^#INCLUDES#$#\n"
+        "#ifndef #^#NS#$#_DISPATCH_FWD_ONLY\n"
+        "// Define #^#NS#$#_DISPATCH_FWD_ONLY when the including code provides\n"
+        "// the definitions of all the dispatched messages itself.\n"
+        "#include \"#^#MESSAGES#$#\"\n"
+        "#endif\n";
+
+    util::ReplacementMap repl = {
+        {"INCLUDES", util::strListToString(incs, "\n", "\n")},
+        {"NS", util::strToUpper(m_generator.currentSchema().mainNamespace())},
+        {"MESSAGES", comms::relHeaderForInput(inputPrefix + "Messages", m_generator)},
+    };
+
+    return util::processTemplate(Templ, repl);
 }
 
 std::string CommsDispatch::commsDispatchCodeInternal(const std::string& name, CheckMsgFunc&& func) const
@@ -801,4 +890,135 @@ std::string CommsDispatch::commsMsgDispatcherCodeInternal(const std::string& inp
 }
 
 
+std::string CommsDispatch::commsMsgBatchProcessorCodeInternal(const std::string& inputPrefix) const
+{
+    static const std::string Templ =
+        "/// @brief Decoder of the input messages in batches.\n"
+        "/// @details Decodes up to @b TBatchSize messages from the input buffer into\n"
+        "///     the reusable storage first and only then dispatches them to the handler\n"
+        "///     using @ref dispatch#^#NAME#$#Message() function grouped by the message ID.\n"
+        "///     As the result every handling function processes a contiguous batch of\n"
+        "///     the messages of the same type instead of interleaving with the decoding\n"
+        "///     of every frame. The order of the messages with the same ID is preserved.\n"
+        "///     The messages are released right after being dispatched. When the frame\n"
+        "///     fails to allocate a message (@b comms::ErrorStatus::MsgAllocFailure), for\n"
+        "///     example due to in-place allocation holding a single message at a time,\n"
+        "///     the collected batch is dispatched and the frame is decoded again.\n"
+        "/// @tparam TFrame Frame (protocol stack) type used to decode the messages.\n"
+        "/// @tparam TBatchSize Maximum number of messages decoded in a single batch.\n"
+        "/// @tparam TProtOptions Protocol options struct used for the application,\n"
+        "///     like @ref #^#DEFAULT_OPTIONS#$#.\n"
+        "/// @headerfile #^#HEADERFILE#$#\n"
+        "template <typename TFrame, std::size_t TBatchSize, typename TProtOptions = #^#DEFAULT_OPTIONS#$#>\n"
+        "class #^#NAME#$#MsgBatchProcessor\n"
+        "{\n"
+        "    static_assert(0U < TBatchSize, \"Batch size must be positive\");\n\n"
+        "public:\n"
+        "    /// @brief Type of the smart pointer holding the decoded message objects.\n"
+        "    using MsgPtr = typename TFrame::MsgPtr;\n\n"
+        "    /// @brief Decode and dispatch all the messages in the input buffer.\n"
+        "    /// @details The messages are decoded and dispatched in batches of up to\n"
+        "    ///     @b TBatchSize messages. Similar to @b comms::processAllWithDispatch(),\n"
+        "    ///     the bytes that cannot be recognised as a valid frame are skipped, on\n"
+        "    ///     @b comms::ErrorStatus::ProtocolError the decoding resumes from the\n"
+        "    ///     offset reported by the @b resyncOffset() function of the frame.\n"
+        "    /// @param[in] buf Random access iterator to the contiguous input buffer.\n"
+        "    /// @param[in] len Number of bytes in the input buffer.\n"
+        "    /// @param[in] frame Frame object used to decode the messages.\n"
+        "    /// @param[in] handler Reference to handling object, see @ref dispatch#^#NAME#$#Message().\n"
+        "    /// @return Number of consumed bytes. The rest is expected to be provided\n"
+        "    ///     again when more data becomes available.\n"
+        "    template <typename TIter, typename THandler>\n"
+        "    std::size_t process(TIter buf, std::size_t len, TFrame& frame, THandler& handler)\n"
+        "    {\n"
+        "        std::size_t consumed = 0U;\n"
+        "        while (true) {\n"
+        "            bool more = decodeBatchInternal(buf, len, frame, consumed);\n"
+        "            dispatchBatchInternal(handler);\n"
+        "            if (!more) {\n"
+        "                break;\n"
+        "            }\n"
+        "        }\n\n"
+        "        return consumed;\n"
+        "    }\n\n"
+        "private:\n"
+        "    struct Element\n"
+        "    {\n"
+        "        MsgPtr m_msg;\n"
+        "        #^#MAIN_NS#$#::MsgId m_id = static_cast<#^#MAIN_NS#$#::MsgId>(0);\n"
+        "        std::size_t m_idx = 0U;\n"
+        "    };\n\n"
+        "    // Returns true when the batch is complete and decoding needs to continue\n"
+        "    // after its dispatch.\n"
+        "    template <typename TIter>\n"
+        "    bool decodeBatchInternal(TIter buf, std::size_t len, TFrame& frame, std::size_t& consumed)\n"
+        "    {\n"
+        "        m_count = 0U;\n"
+        "        while (consumed < len) {\n"
+        "            if (TBatchSize <= m_count) {\n"
+        "                return true;\n"
+        "            }\n\n"
+        "            auto& elem = m_elements[m_count];\n"
+        "            elem.m_idx = 0U;\n\n"
+        "            auto iter = buf + consumed;\n"
+        "            auto es =\n"
+        "                frame.read(\n"
+        "                    elem.m_msg, iter, len - consumed,\n"
+        "                    comms::protocol::msgId(elem.m_id),\n"
+        "                    comms::protocol::msgIndex(elem.m_idx));\n\n"
+        "            if (es == comms::ErrorStatus::NotEnoughData) {\n"
+        "                break;\n"
+        "            }\n\n"
+        "            if ((es == comms::ErrorStatus::MsgAllocFailure) && (0U < m_count)) {\n"
+        "                // The storage is occupied by the already decoded messages\n"
+        "                elem.m_msg.reset();\n"
+        "                return true;\n"
+        "            }\n\n"
+        "            if (es == comms::ErrorStatus::ProtocolError) {\n"
+        "                elem.m_msg.reset();\n"
+        "                consumed += TFrame::resyncOffset(&buf[consumed], len - consumed);\n"
+        "                continue;\n"
+        "            }\n\n"
+        "            consumed = static_cast<std::size_t>(std::distance(buf, iter));\n"
+        "            if ((es != comms::ErrorStatus::Success) || (!elem.m_msg)) {\n"
+        "                elem.m_msg.reset();\n"
+        "                continue;\n"
+        "            }\n\n"
+        "            m_order[m_count] = m_count;\n"
+        "            ++m_count;\n"
+        "        }\n\n"
+        "        return false;\n"
+        "    }\n\n"
+        "    template <typename THandler>\n"
+        "    void dispatchBatchInternal(THandler& handler)\n"
+        "    {\n"
+        "        auto& elements = m_elements;\n"
+        "        std::stable_sort(\n"
+        "            m_order.begin(), m_order.begin() + m_count,\n"
+        "            [&elements](std::size_t first, std::size_t second)\n"
+        "            {\n"
+        "                return\n"
+        "                    (elements[first].m_id < elements[second].m_id) ||\n"
+        "                    ((elements[first].m_id == elements[second].m_id) && (elements[first].m_idx < elements[second].m_idx));\n"
+        "            });\n\n"
+        "        for (auto idx = 0U; idx < m_count; ++idx) {\n"
+        "            auto& elem = elements[m_order[idx]];\n"
+        "            #^#MAIN_NS#$#::dispatch::dispatch#^#NAME#$#Message<TProtOptions>(elem.m_id, elem.m_idx, *elem.m_msg, handler);\n"
+        "            elem.m_msg.reset();\n"
+        "        }\n"
+        "    }\n\n"
+        "    std::array<Element, TBatchSize> m_elements;\n"
+        "    std::array<std::size_t, TBatchSize> m_order;\n"
+        "    std::size_t m_count = 0U;\n"
+        "};\n";
+
+    util::ReplacementMap repl = {
+        {"NAME", inputPrefix},
+        {"MAIN_NS", m_generator.currentSchema().mainNamespace()},
+        {"DEFAULT_OPTIONS", comms::scopeForOptions(strings::defaultOptionsStr(), m_generator)},
+        {"HEADERFILE", comms::relHeaderForDispatch(getBatchProcessorFileName(inputPrefix), m_generator)},
+    };
+    return util::processTemplate(Templ, repl);
+}
+
 } // namespace commsdsl2comms
@@ -854,6 +854,9 @@ std::string CommsDoxygen::commsCustomizeDocInternal() const
         "/// Also there is @ref #^#BARE_METAL_OPTIONS#$#\n"
         "/// (defined in @b #^#BARE_METAL_OPTIONS_HDR#$# file) which can help in defining\n"
         "/// options for bare-metal applications. It exclude all usage of dynamic memory allocation.\n"
+        "/// The @ref #^#BOUNDED_BARE_METAL_OPTIONS#$# (defined in @b #^#BOUNDED_BARE_METAL_OPTIONS_HDR#$#\n"
+        "/// file) extend them by deriving the storage capacity of the lists, strings, and data fields\n"
+        "/// from the maximal values of their count / length prefixes.\n"
         "///\n"
         "/// In case non-custom &lt;id&gt; layer has been used in schema (files), custom,\n"
         "/// application-specific allocation options to it may include\n"
@@ -874,6 +877,7 @@ std::string CommsDoxygen::commsCustomizeDocInternal() const
         "/// @li @ref #^#CLIENT_OPTIONS#$#T\n"
         "/// @li @ref #^#SERVER_OPTIONS#$#T\n"
         "/// @li @ref #^#BARE_METAL_OPTIONS#$#T\n"
+        "/// @li @ref #^#BOUNDED_BARE_METAL_OPTIONS#$#T\n"
         "/// @li @ref #^#DATA_VIEW_OPTIONS#$#T\n"
         "///\n"
         "/// As the result it is possible to combine them. For example:\n"
@@ -899,6 +903,8 @@ std::string CommsDoxygen::commsCustomizeDocInternal() const
         {"SERVER_OPTIONS_HDR", comms::relHeaderForOptions("Server" + strings::defaultOptionsStr(), m_generator)},
         {"BARE_METAL_OPTIONS", comms::scopeForOptions(strings::bareMetalStr() + strings::defaultOptionsStr(), m_generator)},
         {"BARE_METAL_OPTIONS_HDR", comms::relHeaderForOptions(strings::bareMetalStr() + strings::defaultOptionsStr(), m_generator)},
+        {"BOUNDED_BARE_METAL_OPTIONS", comms::scopeForOptions("Bounded" + strings::bareMetalStr() + strings::defaultOptionsStr(), m_generator)},
+        {"BOUNDED_BARE_METAL_OPTIONS_HDR", comms::relHeaderForOptions("Bounded" + strings::bareMetalStr() + strings::defaultOptionsStr(), m_generator)},
         {"DATA_VIEW_OPTIONS", comms::scopeForOptions(strings::dataViewStr() + strings::defaultOptionsStr(), m_generator)},
         {"DATA_VIEW_OPTIONS_HDR", comms::relHeaderForOptions(strings::dataViewStr() + strings::defaultOptionsStr(), m_generator)},
     };
@@ -940,10 +946,22 @@ std::string CommsDoxygen::commsVersionDocInternal() const
         "///     #^#PROT_NAMESPACE#$#::message::SomeMsg<MyOutputMsg> msg;\n"
         "///     msg.version() = 4U;\n"
         "///     msg.doRefresh(); // will update exists/missing state of every dependent field\n"
+        "/// @endcode\n"
+        "/// When the code is known to communicate with a single version of the protocol,\n"
+        "/// the version can be frozen at compile time by wrapping the protocol options with\n"
+        "/// @ref #^#FIXED_VERSION_OPTIONS#$#T (defined in\n"
+        "/// @b #^#FIXED_VERSION_OPTIONS_HDR#$# header file). Both the existence of the\n"
+        "/// version dependent fields and their validity checks defined with such options\n"
+        "/// follow the frozen version and ignore the runtime version information,\n"
+        "/// while the classes defined with other options still check the latter.\n"
+        "/// @code\n"
+        "/// using MyOptions = #^#FIXED_VERSION_OPTIONS#$#T<4U>;\n"
         "/// @endcode";
 
     util::ReplacementMap repl = {
         {"PROT_NAMESPACE", m_generator.currentSchema().mainNamespace()},
+        {"FIXED_VERSION_OPTIONS", comms::scopeForOptions("FixedVersion" + strings::defaultOptionsStr(), m_generator)},
+        {"FIXED_VERSION_OPTIONS_HDR", comms::relHeaderForOptions("FixedVersion" + strings::defaultOptionsStr(), m_generator)},
     };
     return util::processTemplate(Templ, repl);
 }
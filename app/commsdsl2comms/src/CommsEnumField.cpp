@@ -150,6 +150,33 @@ commsdsl::gen::util::StringsList CommsEnumField::commsEnumValues() const
     return valuesStrings;    
 }
 
+std::string CommsEnumField::commsVariantPropKeyType(const StringsList& customOpts) const
+{
+    static const std::string Templ = 
+        "comms::field::IntValue<\n"
+        "    #^#PROT_NAMESPACE#$#::field::FieldBase<#^#FIELD_BASE_PARAMS#$#>,\n"
+        "    #^#FIELD_TYPE#$##^#COMMA#$#\n"
+        "    #^#FIELD_OPTS#$#\n"
+        ">";  
+
+    util::StringsList opts = customOpts;
+    commsAddLengthOptInternal(opts);
+
+    auto& gen = generator();
+    auto dslObj = enumDslObj();
+    util::ReplacementMap repl = {
+        {"PROT_NAMESPACE", gen.schemaOf(*this).mainNamespace()},
+        {"FIELD_BASE_PARAMS", commsFieldBaseParams(dslObj.endian())},
+        {"FIELD_TYPE", comms::cppIntTypeFor(dslObj.type(), dslObj.maxLength())},
+        {"FIELD_OPTS", util::strListToString(opts, ",\n", "")}
+    };
+
+    if (!repl["FIELD_OPTS"].empty()) {
+        repl["COMMA"] = ",";
+    }
+    return util::processTemplate(Templ, repl);
+}
+
 bool CommsEnumField::prepareImpl()
 {
     return 
@@ -167,6 +194,7 @@ CommsEnumField::IncludesList CommsEnumField::commsCommonIncludesImpl() const
 {
     IncludesList result = {
         "<cstdint>",
+        "<cstring>",
         "<type_traits>",
         "<utility>"
     };
@@ -176,8 +204,7 @@ CommsEnumField::IncludesList CommsEnumField::commsCommonIncludesImpl() const
         result.push_back(std::move(inc));
     }  
 
-    if ((MaxRangesInOpts < m_validRanges.size()) ||
-        (!commsIsDirectValueNameMappingInternal())) {
+    if (MaxRangesInOpts < m_validRanges.size()) {
         result.insert(result.end(), {
             "<algorithm>",
             "<iterator>"
@@ -195,6 +222,7 @@ std::string CommsEnumField::commsCommonCodeBodyImpl() const
         "#^#NAME_FUNC#$#\n"
         "#^#VAL_NAME_FUNC#$#\n"
         "#^#VAL_VALUE_NAMES_MAP_FUNC#$#\n"
+        "#^#VAL_FROM_NAME_FUNC#$#\n"
     ;
 
     util::ReplacementMap repl = {
@@ -202,7 +230,8 @@ std::string CommsEnumField::commsCommonCodeBodyImpl() const
         {"VALUE_NAME_MAP_DEF", commsCommonValueNameMapInternal()},
         {"NAME_FUNC", commsCommonNameFuncCode()},
         {"VAL_NAME_FUNC", commsCommonValueNameFuncCodeInternal()},
-        {"VAL_VALUE_NAMES_MAP_FUNC", commsCommonValueNamesMapFuncCodeInternal()}
+        {"VAL_VALUE_NAMES_MAP_FUNC", commsCommonValueNamesMapFuncCodeInternal()},
+        {"VAL_FROM_NAME_FUNC", commsCommonValueFromNameFuncCodeInternal()}
     };
 
     return util::processTemplate(Templ, repl);
@@ -274,12 +303,14 @@ std::string CommsEnumField::commsDefPublicCodeImpl() const
         "#^#VALUE_NAMES_MAP_DEFS#$#\n"
         "#^#VALUE_NAME#$#\n"
         "#^#VALUE_NAMES_MAP#$#\n"    
+        "#^#VALUE_FROM_NAME#$#\n"
     ;
 
     util::ReplacementMap repl = {
         {"VALUE_NAMES_MAP_DEFS", commsDefValueNameMapInternal()},
         {"VALUE_NAME", commsDefValueNameFuncCodeInternal()},
         {"VALUE_NAMES_MAP", commsDefValueNamesMapFuncCodeInternal()},
+        {"VALUE_FROM_NAME", commsDefValueFromNameFuncCodeInternal()},
     };
 
     return util::processTemplate(Templ, repl);
@@ -362,18 +393,18 @@ std::string CommsEnumField::commsDefValidFuncBodyImpl() const
     }
 
     static const std::string VersionBothCondTempl =
-        "if ((#^#FROM_VERSION#$# <= Base::getVersion()) &&\n"
-        "    (Base::getVersion() < #^#UNTIL_VERSION#$#)) {\n"
+        "if ((#^#FROM_VERSION#$# <= #^#VERSION#$#) &&\n"
+        "    (#^#VERSION#$# < #^#UNTIL_VERSION#$#)) {\n"
         "    #^#COMPARISONS#$#\n"
         "}\n";
 
     static const std::string VersionFromCondTempl =
-        "if (#^#FROM_VERSION#$# <= Base::getVersion()) {\n"
+        "if (#^#FROM_VERSION#$# <= #^#VERSION#$#) {\n"
         "    #^#COMPARISONS#$#\n"
         "}\n";
 
     static const std::string VersionUntilCondTempl =
-        "if (Base::getVersion() < #^#UNTIL_VERSION#$#) {\n"
+        "if (#^#VERSION#$# < #^#UNTIL_VERSION#$#) {\n"
         "    #^#COMPARISONS#$#\n"
         "}\n";
 
@@ -435,7 +466,8 @@ std::string CommsEnumField::commsDefValidFuncBodyImpl() const
         util::ReplacementMap repl = {
             {"COMPARISONS", util::strListToString(comparisons, "\n\n", "")},
             {"FROM_VERSION", util::numToString(l.front().m_sinceVersion)},
-            {"UNTIL_VERSION", util::numToString(l.front().m_deprecatedSince)}
+            {"UNTIL_VERSION", util::numToString(l.front().m_deprecatedSince)},
+            {"VERSION", commsDefVersionAccessStr()},
         };
         conditions.push_back(util::processTemplate(*condTempl, repl));
     }
@@ -676,6 +708,34 @@ bool CommsEnumField::commsIsDirectValueNameMappingInternal() const
     return true;    
 }
 
+bool CommsEnumField::commsIsBigUnsignedNamesMapInternal() const
+{
+    auto obj = enumDslObj();
+    auto type = obj.type();
+    return 
+        (type == commsdsl::parse::EnumField::Type::Uint64) ||
+        ((type == commsdsl::parse::EnumField::Type::Uintvar) && (sizeof(std::uint64_t) <= obj.maxLength()));
+}
+
+CommsEnumField::ValueLookupList CommsEnumField::commsSparseValuesInternal() const
+{
+    // Must follow the order of the elements in the generated valueNamesMap()
+    auto obj = enumDslObj();
+    auto& revValues = obj.revValues();
+    ValueLookupList result;
+    result.reserve(revValues.size());
+    for (auto& v : revValues) {
+        result.push_back(static_cast<std::uint64_t>(v.first));
+    }
+
+    if (commsIsBigUnsignedNamesMapInternal()) {
+        std::sort(result.begin(), result.end());
+    }
+
+    result.erase(std::unique(result.begin(), result.end()), result.end());
+    return result;
+}
+
 std::string CommsEnumField::commsCommonEnumInternal() const
 {
     auto& gen = generator();
@@ -734,7 +794,7 @@ std::string CommsEnumField::commsCommonValueNameFuncCodeInternal() const
         body = commsCommonValueNameDirectBodyInternal();
     }
     else {
-        body = commsCommonValueNameBinSearchBodyInternal();
+        body = commsCommonValueNameHashBodyInternal();
     }
     assert(!body.empty());
 
@@ -765,25 +825,27 @@ const std::string& CommsEnumField::commsCommonValueNameDirectBodyInternal() cons
     return Templ;    
 }
 
-const std::string& CommsEnumField::commsCommonValueNameBinSearchBodyInternal() const
+std::string CommsEnumField::commsCommonValueNameHashBodyInternal() const
 {
+    auto values = commsSparseValuesInternal();
+    std::string lookupCode = 
+        commsValueLookupIdxCode(
+            values, 
+            "static_cast<typename std::underlying_type<ValueType>::type>(val)");
+
     static const std::string Templ = 
         "auto namesMapInfo = valueNamesMap();\n"
-        "auto begIter = namesMapInfo.first;\n"
-        "auto endIter = begIter + namesMapInfo.second;\n"
-        "auto iter = std::lower_bound(\n"
-        "    begIter, endIter, val,\n"
-        "    [](const ValueNameInfo& info, ValueType v) -> bool\n"
-        "    {\n"
-        "        return info.first < v;\n"
-        "    });\n\n"
-        "if ((iter == endIter) || (iter->first != val)) {\n"
+        "#^#LOOKUP#$#\n"
+        "if ((namesMapInfo.second <= idx) || (namesMapInfo.first[idx].first != val)) {\n"
         "    return nullptr;\n"
         "}\n\n"
-        "return iter->second;";
+        "return namesMapInfo.first[idx].second;";
 
+    util::ReplacementMap repl = {
+        {"LOOKUP", std::move(lookupCode)}
+    };
 
-    return Templ;
+    return util::processTemplate(Templ, repl);
 }
 
 std::string CommsEnumField::commsCommonValueNamesMapFuncCodeInternal() const
@@ -897,12 +959,8 @@ std::string CommsEnumField::commsCommonValueNamesMapDirectBodyInternal() const
 
 std::string CommsEnumField::commsCommonValueNamesMapBinSearchBodyInternal() const
 {
-    auto obj = enumDslObj();
-    auto type = obj.type();
-
     std::string names;
-    if ((type == commsdsl::parse::EnumField::Type::Uint64) ||
-        ((type == commsdsl::parse::EnumField::Type::Uintvar) && (sizeof(std::uint64_t) <= obj.maxLength()))) {
+    if (commsIsBigUnsignedNamesMapInternal()) {
         names = commsCommonBigUnsignedValueNameBinSearchPairsInternal();
     }
     else {
@@ -1094,6 +1152,44 @@ std::string CommsEnumField::commsCommonValueNameBinSearchPairsInternal() const
     return util::strListToString(names, ",\n", "");
 }
 
+std::string CommsEnumField::commsCommonValueFromNameFuncCodeInternal() const
+{
+    auto obj = enumDslObj();
+    auto& values = obj.values();
+    bool isMessageId =
+        obj.semanticType() == commsdsl::parse::Field::SemanticType::MessageId;    
+
+    auto& gen = generator();
+    std::string valuePrefix = "ValueType::";
+    if (isMessageId) {
+        valuePrefix = gen.schemaOf(*this).mainNamespace() + "::" + strings::msgIdPrefixStr();
+    }
+
+    NameLookupList names;
+    names.reserve(values.size() * 2U);
+    for (auto& v : values) {
+        if (!gen.doesElementExist(v.second.m_sinceVersion, v.second.m_deprecatedSince, false)) {
+            continue;
+        }
+
+        commsAddNameLookupElem(names, v.first, valuePrefix + v.first);
+    }
+
+    for (auto& v : values) {
+        if (!gen.doesElementExist(v.second.m_sinceVersion, v.second.m_deprecatedSince, false)) {
+            continue;
+        }
+
+        commsAddNameLookupElem(names, v.second.m_displayName, valuePrefix + v.first);
+    }    
+
+    return 
+        commsNameLookupFuncCode(
+            names, "valueFromName", "ValueType",
+            "enum value",
+            "value", "value");
+}
+
 std::string CommsEnumField::commsDefFieldOptsInternal() const
 {
     util::StringsList opts;
@@ -1167,6 +1263,22 @@ std::string CommsEnumField::commsDefValueNamesMapFuncCodeInternal() const
     return util::processTemplate(Templ, repl);
 }
 
+std::string CommsEnumField::commsDefValueFromNameFuncCodeInternal() const
+{
+    static const std::string Templ = 
+        "/// @brief Retrieve enum value by its name.\n"
+        "/// @see @ref #^#COMMON_SCOPE#$#::valueFromName().\n"
+        "static std::pair<ValueType, bool> valueFromName(const char* name, std::size_t len)\n"
+        "{\n"
+        "    return #^#COMMON_SCOPE#$#::valueFromName(name, len);\n"
+        "}\n";
+
+    util::ReplacementMap repl = {
+        {"COMMON_SCOPE", comms::commonScopeFor(*this, generator())}
+    };
+    return util::processTemplate(Templ, repl);
+}
+
 void CommsEnumField::commsAddDefaultValueOptInternal(StringsList& opts) const
 {
     auto obj = enumDslObj();
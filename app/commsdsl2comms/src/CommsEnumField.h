@@ -34,6 +34,7 @@ public:
     CommsEnumField(CommsGenerator& generator, commsdsl::parse::Field dslObj, commsdsl::gen::Elem* parent);
 
     commsdsl::gen::util::StringsList commsEnumValues() const;
+    std::string commsVariantPropKeyType(const StringsList& customOpts) const;
 
 protected:
     // Base overrides
@@ -67,20 +68,24 @@ private:
 
     bool commsPrepareValidRangesInternal();
     bool commsIsDirectValueNameMappingInternal() const;
+    bool commsIsBigUnsignedNamesMapInternal() const;
+    ValueLookupList commsSparseValuesInternal() const;
     std::string commsCommonEnumInternal() const;
     std::string commsCommonValueNameMapInternal() const;
     std::string commsCommonValueNameFuncCodeInternal() const;
     const std::string& commsCommonValueNameDirectBodyInternal() const;
-    const std::string& commsCommonValueNameBinSearchBodyInternal() const;
+    std::string commsCommonValueNameHashBodyInternal() const;
     std::string commsCommonValueNamesMapFuncCodeInternal() const;
     std::string commsCommonValueNamesMapDirectBodyInternal() const;
     std::string commsCommonValueNamesMapBinSearchBodyInternal() const;
     std::string commsCommonBigUnsignedValueNameBinSearchPairsInternal() const;
     std::string commsCommonValueNameBinSearchPairsInternal() const;
+    std::string commsCommonValueFromNameFuncCodeInternal() const;
     std::string commsDefFieldOptsInternal() const;
     std::string commsDefValueNameMapInternal() const;
     std::string commsDefValueNameFuncCodeInternal() const;
     std::string commsDefValueNamesMapFuncCodeInternal() const;
+    std::string commsDefValueFromNameFuncCodeInternal() const;
 
     void commsAddDefaultValueOptInternal(StringsList& opts) const;
     void commsAddLengthOptInternal(StringsList& opts) const;
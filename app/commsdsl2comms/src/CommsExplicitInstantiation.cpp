@@ -0,0 +1,198 @@
+//
+// Copyright 2019 - 2023 (C). Alex Robenko. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "CommsExplicitInstantiation.h"
+
+#include "CommsGenerator.h"
+#include "CommsMessage.h"
+
+#include "commsdsl/gen/comms.h"
+#include "commsdsl/gen/strings.h"
+#include "commsdsl/gen/util.h"
+
+#include <cassert>
+#include <fstream>
+
+namespace comms = commsdsl::gen::comms;
+namespace strings = commsdsl::gen::strings;
+namespace util = commsdsl::gen::util;
+
+namespace commsdsl2comms
+{
+
+namespace 
+{
+
+const std::string ExplicitInstantiationStr("ExplicitInstantiation");
+
+bool writeFileInternal(
+    const std::string& filePath,
+    CommsGenerator& generator,
+    const std::string& data)
+{
+    generator.logger().info("Generating " + filePath);
+
+    auto dirPath = util::pathUp(filePath);
+    assert(!dirPath.empty());
+    if (!generator.createDirectory(dirPath)) {
+        return false;
+    }      
+
+    std::ofstream stream(filePath);
+    if (!stream) {
+        generator.logger().error("Failed to open \"" + filePath + "\" for writing.");
+        return false;
+    }    
+
+    stream << data;
+    stream.flush();
+    if (!stream.good()) {
+        generator.logger().error("Failed to write \"" + filePath + "\".");
+        return false;
+    }
+
+    return true;
+}
+
+} // namespace 
+
+bool CommsExplicitInstantiation::write(CommsGenerator& generator)
+{
+    CommsExplicitInstantiation obj(generator);
+    return obj.commsWriteInternal();
+}
+
+bool CommsExplicitInstantiation::commsWriteInternal() const
+{
+    return 
+        commsWriteHeaderInternal() &&
+        commsWriteSrcInternal();
+}
+
+bool CommsExplicitInstantiation::commsWriteHeaderInternal() const
+{
+    static const std::string Templ = 
+        "#^#GENERATED#$#\n"
+        "/// @file\n"
+        "/// @brief Contains explicit template instantiation helpers of the protocol definition.\n"
+        "/// @details When @b #^#NS#$#_EXPLICIT_INSTANTIATION_INTERFACE macro is defined (usually by\n"
+        "///     linking to the protocol explicit instantiation library), the messages, their\n"
+        "///     @b comms::MessageBase base classes and the frames defined with the default,\n"
+        "///     client, server and bare metal options are declared as @b extern templates\n"
+        "///     and are not instantiated again by every translation unit including this header.\n"
+        "///     The internal implementation layers of the @b COMMS library as well as the\n"
+        "///     fields are still instantiated by the including code.\n\n"
+        "#pragma once\n\n"
+        "#^#INCLUDES#$#\n"
+        "#ifdef #^#NS#$#_EXPLICIT_INSTANTIATION_INTERFACE_HEADER\n"
+        "#include #^#NS#$#_EXPLICIT_INSTANTIATION_INTERFACE_HEADER\n"
+        "#endif\n\n"
+        "/// @brief Declare or define explicit instantiation of all the messages and frames.\n"
+        "/// @param extern_ Either @b extern for the declaration or empty for the definition.\n"
+        "/// @param interface_ Type of the common message interface, must not contain commas.\n"
+        "/// @param opts_ Type of the used protocol definition options, must not contain commas.\n"
+        "#define #^#NS#$#_EXPLICIT_INSTANTIATION(extern_, interface_, opts_) \\\n"
+        "    #^#CLASSES#$#\n\n"
+        "/// @brief Declare or define explicit instantiation of all the messages and frames\n"
+        "///     for all the provided default options.\n"
+        "/// @param extern_ Either @b extern for the declaration or empty for the definition.\n"
+        "/// @param interface_ Type of the common message interface, must not contain commas.\n"
+        "#define #^#NS#$#_EXPLICIT_INSTANTIATION_DEFAULT_OPTIONS(extern_, interface_) \\\n"
+        "    #^#OPTIONS#$#\n\n"
+        "#ifdef #^#NS#$#_EXPLICIT_INSTANTIATION_INTERFACE\n"
+        "#^#NS#$#_EXPLICIT_INSTANTIATION_DEFAULT_OPTIONS(extern, #^#NS#$#_EXPLICIT_INSTANTIATION_INTERFACE)\n"
+        "#endif\n"
+        ;
+
+    auto& gen = m_generator;
+    util::StringsList includes;
+    util::StringsList classes;
+    for (auto* m : gen.getAllMessagesIdSorted()) {
+        assert(m != nullptr);
+        includes.push_back(comms::relHeaderPathFor(*m, gen));
+
+        // The base class implements most of the message functionality
+        auto base = static_cast<const CommsMessage*>(m)->commsExplicitInstantiationBase("interface_", "opts_");
+        classes.push_back("extern_ template class " + util::strReplace(base, "\n", " \\\n") + ";");
+        classes.push_back("extern_ template class " + comms::scopeFor(*m, gen) + "<interface_, opts_>;");
+    }
+
+    auto allMessages = comms::scopeForInput(strings::allMessagesStr(), gen) + "<interface_, opts_>";
+    for (auto* f : gen.getAllFrames()) {
+        assert(f != nullptr);
+        includes.push_back(comms::relHeaderPathFor(*f, gen));
+        classes.push_back("extern_ template class " + comms::scopeFor(*f, gen) + "<interface_, " + allMessages + ", opts_>;");
+    }
+
+    includes.push_back(comms::relHeaderForInput(strings::allMessagesStr(), gen));
+
+    static const std::string OptionsPrefixes[] = {
+        strings::emptyString(),
+        "Client",
+        "Server",
+        strings::bareMetalStr(),
+    };
+
+    util::StringsList options;
+    for (auto& p : OptionsPrefixes) {
+        auto name = p + strings::defaultOptionsStr();
+        includes.push_back(comms::relHeaderForOptions(name, gen));
+        options.push_back(
+            util::strToUpper(gen.currentSchema().mainNamespace()) + "_EXPLICIT_INSTANTIATION(extern_, interface_, " + 
+            comms::scopeForOptions(name, gen) + ")");
+    }
+
+    comms::prepareIncludeStatement(includes);
+
+    util::ReplacementMap repl = {
+        {"GENERATED", CommsGenerator::commsFileGeneratedComment()},
+        {"NS", util::strToUpper(gen.currentSchema().mainNamespace())},
+        {"INCLUDES", util::strListToString(includes, "\n", "\n")},
+        {"CLASSES", util::strListToString(classes, " \\\n", "")},
+        {"OPTIONS", util::strListToString(options, " \\\n", "")},
+    };
+
+    auto filePath = comms::headerPathRoot(ExplicitInstantiationStr, gen);
+    return writeFileInternal(filePath, m_generator, util::processTemplate(Templ, repl, true));
+}
+
+bool CommsExplicitInstantiation::commsWriteSrcInternal() const
+{
+    static const std::string Templ = 
+        "#^#GENERATED#$#\n"
+        "/// @file\n"
+        "/// @brief Contains explicit template instantiation of the protocol definition.\n\n"
+        "#include \"#^#HEADER#$#\"\n\n"
+        "#ifndef #^#NS#$#_EXPLICIT_INSTANTIATION_INTERFACE\n"
+        "#error \"The #^#NS#$#_EXPLICIT_INSTANTIATION_INTERFACE macro must be defined\"\n"
+        "#endif\n\n"
+        "#^#NS#$#_EXPLICIT_INSTANTIATION_DEFAULT_OPTIONS(, #^#NS#$#_EXPLICIT_INSTANTIATION_INTERFACE)\n"
+        ;
+
+    util::ReplacementMap repl = {
+        {"GENERATED", CommsGenerator::commsFileGeneratedComment()},
+        {"NS", util::strToUpper(m_generator.currentSchema().mainNamespace())},
+        {"HEADER", comms::relHeaderForRoot(ExplicitInstantiationStr, m_generator)},
+    };
+
+    auto filePath = 
+        util::pathAddElem(
+            util::pathAddElem(m_generator.getOutputDir(), strings::srcDirStr()), 
+            ExplicitInstantiationStr + strings::cppSourceSuffixStr());
+
+    return writeFileInternal(filePath, m_generator, util::processTemplate(Templ, repl));
+}
+
+} // namespace commsdsl2comms
@@ -24,10 +24,13 @@
 #include "commsdsl/gen/comms.h"
 #include "commsdsl/gen/strings.h"
 #include "commsdsl/gen/util.h"
+#include "commsdsl/parse/IntField.h"
+#include "commsdsl/parse/RefField.h"
 
 #include <algorithm>
 #include <cassert>
 #include <fstream>
+#include <numeric>
 
 namespace comms = commsdsl::gen::comms;
 namespace strings = commsdsl::gen::strings;
@@ -65,6 +68,174 @@ void readCustomCodeInternal(const std::string& codePath, std::string& code)
     code = util::readFileContents(codePath);
 }
 
+struct PerfectHashInfo
+{
+    std::uint32_t m_salt = 0U;
+    std::vector<std::uint32_t> m_seeds;
+    std::vector<std::size_t> m_slots;
+};
+
+const std::uint32_t NameHashBasis = 2166136261U;
+const std::uint32_t NameHashPrime = 16777619U;
+
+std::uint32_t nameHash(const std::string& name, std::uint32_t salt)
+{
+    std::uint32_t hash = NameHashBasis ^ salt;
+    for (auto ch : name) {
+        hash ^= static_cast<std::uint32_t>(static_cast<std::uint8_t>(ch));
+        hash *= NameHashPrime;
+    }
+    return hash;
+}
+
+std::uint32_t valueHash(std::uint64_t value, std::uint32_t salt)
+{
+    auto key = value ^ salt;
+    key ^= key >> 33U;
+    key *= 0xff51afd7ed558ccdULL;
+    key ^= key >> 33U;
+    return static_cast<std::uint32_t>(key);
+}
+
+std::uint32_t slotHash(std::uint32_t hash, std::uint32_t seed)
+{
+    auto slot = hash ^ seed;
+    slot ^= slot >> 16U;
+    slot *= 0x85ebca6bU;
+    slot ^= slot >> 13U;
+    slot *= 0xc2b2ae35U;
+    slot ^= slot >> 16U;
+    return slot;
+}
+
+// Hash and displace: keys are split into buckets by their hash, every bucket 
+// receives a seed which places all its keys into the free slots of the table.
+template <typename TKeyFunc>
+bool buildPerfectHash(std::size_t count, TKeyFunc&& keyFunc, PerfectHashInfo& info)
+{
+    static const std::uint32_t MaxSalt = 64U;
+    static const std::uint32_t MaxSeed = 0x10000;
+    static const std::size_t MaxTableGrowth = 4U;
+
+    assert(0U < count);
+    std::size_t minTableSize = 1U;
+    while (minTableSize < count) {
+        minTableSize <<= 1U;
+    }
+
+    auto bucketsCount = std::max(std::size_t(1U), (count + 1U) / 2U);
+    for (std::uint32_t salt = 0U; salt < MaxSalt; ++salt) {
+        std::vector<std::uint32_t> hashes;
+        hashes.reserve(count);
+        for (auto idx = 0U; idx < count; ++idx) {
+            hashes.push_back(keyFunc(idx, salt));
+        }
+
+        auto sortedHashes = hashes;
+        std::sort(sortedHashes.begin(), sortedHashes.end());
+        if (std::adjacent_find(sortedHashes.begin(), sortedHashes.end()) != sortedHashes.end()) {
+            continue;
+        }
+
+        std::vector<std::vector<std::size_t> > buckets(bucketsCount);
+        for (auto idx = 0U; idx < count; ++idx) {
+            buckets[hashes[idx] % bucketsCount].push_back(idx);
+        }
+
+        std::vector<std::size_t> order(bucketsCount);
+        std::iota(order.begin(), order.end(), 0U);
+        std::stable_sort(
+            order.begin(), order.end(),
+            [&buckets](std::size_t b1, std::size_t b2)
+            {
+                return buckets[b2].size() < buckets[b1].size();
+            });
+
+        auto tableSize = minTableSize;
+        for (auto growth = 0U; growth < MaxTableGrowth; ++growth, tableSize <<= 1U) {
+            std::vector<std::size_t> slots(tableSize, count);
+            std::vector<std::uint32_t> seeds(bucketsCount, 0U);
+            std::vector<std::size_t> positions;
+            bool success = true;
+            for (auto b : order) {
+                auto& bucket = buckets[b];
+                if (bucket.empty()) {
+                    break;
+                }
+
+                bool placed = false;
+                for (std::uint32_t seed = 0U; seed < MaxSeed; ++seed) {
+                    positions.clear();
+                    for (auto idx : bucket) {
+                        auto pos = static_cast<std::size_t>(slotHash(hashes[idx], seed)) & (tableSize - 1U);
+                        if ((slots[pos] != count) ||
+                            (std::find(positions.begin(), positions.end(), pos) != positions.end())) {
+                            break;
+                        }
+
+                        positions.push_back(pos);
+                    }
+
+                    if (positions.size() != bucket.size()) {
+                        continue;
+                    }
+
+                    for (auto idx = 0U; idx < bucket.size(); ++idx) {
+                        slots[positions[idx]] = bucket[idx];
+                    }
+
+                    seeds[b] = seed;
+                    placed = true;
+                    break;
+                }
+
+                if (!placed) {
+                    success = false;
+                    break;
+                }
+            }
+
+            if (!success) {
+                continue;
+            }
+
+            info.m_salt = salt;
+            info.m_seeds = std::move(seeds);
+            info.m_slots = std::move(slots);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+std::string perfectHashSeedsStr(const PerfectHashInfo& info)
+{
+    util::StringsList seeds;
+    seeds.reserve(info.m_seeds.size());
+    for (auto s : info.m_seeds) {
+        seeds.push_back(util::numToString(static_cast<std::uintmax_t>(s)));
+    }
+
+    return util::strListToString(seeds, ", ", "");
+}
+
+const std::string& perfectHashSlotCode()
+{
+    static const std::string Code = 
+        "std::uint32_t slot = hash ^ Seeds[hash % SeedsCount];\n"
+        "slot ^= slot >> 16U;\n"
+        "slot *= 0x85ebca6bU;\n"
+        "slot ^= slot >> 13U;\n"
+        "slot *= 0xc2b2ae35U;\n"
+        "slot ^= slot >> 16U;\n";
+
+    return Code;
+}
+
+// Sequences occupying more bytes are not expected to reside in static storage
+const std::size_t MaxBoundedStorageSize = 0xffff;
+
 } // namespace 
     
 
@@ -252,6 +423,7 @@ CommsField::IncludesList CommsField::commsDefIncludes() const
 
     if (commsIsVersionOptional()) {
         list.push_back("comms/field/Optional.h");
+        list.push_back("<limits>");
     }
 
     auto extraList = commsDefIncludesImpl();
@@ -400,6 +572,15 @@ std::string CommsField::commsBareMetalDefaultOptions() const
             true);
 }
 
+std::string CommsField::commsBoundedBareMetalDefaultOptions() const
+{
+    return 
+        commsCustomizationOptionsInternal(
+            &CommsField::commsBoundedBareMetalDefaultOptions,
+            &CommsField::commsExtraBoundedBareMetalDefaultOptionsInternal,
+            true);
+}
+
 bool CommsField::commsHasCustomValue() const
 {
     return !m_customCode.m_value.empty();
@@ -410,6 +591,11 @@ bool CommsField::commsHasCustomValid() const
     return (!m_customCode.m_valid.empty()) || (!commsDefValidFuncBodyImpl().empty());
 }
 
+bool CommsField::commsHasCustomReadWrite() const
+{
+    return (!m_customCode.m_read.empty()) || (!m_customCode.m_write.empty());
+}
+
 bool CommsField::commsHasCustomLength(bool deepCheck) const
 {
     if ((!m_customCode.m_length.empty()) || (!commsDefLengthFuncBodyImpl().empty())) {
@@ -631,6 +817,11 @@ CommsField::StringsList CommsField::commsExtraBareMetalDefaultOptionsImpl() cons
     return StringsList();
 }
 
+CommsField::StringsList CommsField::commsExtraBoundedBareMetalDefaultOptionsImpl() const
+{
+    return StringsList();
+}
+
 std::size_t CommsField::commsMinLengthImpl() const
 {
     return m_field.dslObj().minLength();
@@ -718,6 +909,257 @@ std::string CommsField::commsCommonNameFuncCode() const
     return util::processTemplate(Templ, repl);
 }
 
+void CommsField::commsAddNameLookupElem(NameLookupList& names, const std::string& name, const std::string& valueStr)
+{
+    if (name.empty() || (name == "_")) {
+        return;
+    }
+
+    auto iter = 
+        std::find_if(
+            names.begin(), names.end(),
+            [&name](auto& elem)
+            {
+                return elem.first == name;
+            });
+
+    if (iter != names.end()) {
+        return;
+    }
+
+    names.emplace_back(name, valueStr);
+}
+
+std::string CommsField::commsNameLookupFuncCode(
+    const NameLookupList& names,
+    const std::string& funcName,
+    const std::string& valueType,
+    const std::string& brief,
+    const std::string& elemDesc,
+    const std::string& resultDesc)
+{
+    static const std::string Templ = 
+        "#^#BRIEF#$#\n"
+        "/// @details Both the #^#ELEM#$# name as defined in the schema and its display name\n"
+        "///     are recognised. The lookup uses perfect hash table prepared at\n"
+        "///     the code generation time and doesn't perform any allocation.\n"
+        "/// @param[in] name Name of the #^#ELEM#$#, doesn't need to be null terminated.\n"
+        "/// @param[in] len Length of the name.\n"
+        "/// @return Pair of the found #^#RESULT#$# and @b true on success,\n"
+        "///     the second value is @b false when the name is not recognised.\n"
+        "static std::pair<#^#VALUE_TYPE#$#, bool> #^#FUNC#$#(const char* name, std::size_t len)\n"
+        "{\n"
+        "    #^#BODY#$#\n"
+        "}\n";
+
+    util::ReplacementMap repl = {
+        {"BRIEF", "/// @brief Retrieve " + brief + " by its name."},
+        {"ELEM", elemDesc},
+        {"RESULT", resultDesc},
+        {"VALUE_TYPE", valueType},
+        {"FUNC", funcName},
+        {"BODY", commsNameLookupBodyCode(names, valueType)},
+    };
+
+    return util::processTemplate(Templ, repl);
+}
+
+std::string CommsField::commsNameLookupBodyCode(const NameLookupList& names, const std::string& valueType)
+{
+    static const std::string EmptyTempl = 
+        "static_cast<void>(name);\n"
+        "static_cast<void>(len);\n"
+        "return std::make_pair(#^#VALUE_TYPE#$#(), false);";
+
+    util::ReplacementMap repl = {
+        {"VALUE_TYPE", valueType}
+    };
+
+    if (names.empty()) {
+        return util::processTemplate(EmptyTempl, repl);
+    }
+
+    PerfectHashInfo info;
+    bool built = 
+        buildPerfectHash(
+            names.size(), 
+            [&names](std::size_t idx, std::uint32_t salt)
+            {
+                return nameHash(names[idx].first, salt);
+            },
+            info);
+
+    if (!built) {
+        static constexpr bool Should_not_happen = false;
+        static_cast<void>(Should_not_happen);
+        assert(Should_not_happen);
+        return util::processTemplate(EmptyTempl, repl);
+    }
+
+    util::StringsList entries;
+    entries.reserve(info.m_slots.size());
+    for (auto idx : info.m_slots) {
+        if (names.size() <= idx) {
+            entries.push_back("{nullptr, 0U, " + valueType + "()}");
+            continue;
+        }
+
+        auto& n = names[idx];
+        entries.push_back("{\"" + n.first + "\", " + util::numToString(static_cast<std::uintmax_t>(n.first.size())) + ", " + n.second + "}");
+    }
+
+    static const std::string Templ = 
+        "struct NameInfo\n"
+        "{\n"
+        "    const char* m_name;\n"
+        "    std::size_t m_len;\n"
+        "    #^#VALUE_TYPE#$# m_value;\n"
+        "};\n\n"
+        "static const NameInfo Map[] = {\n"
+        "    #^#ENTRIES#$#\n"
+        "};\n"
+        "static const std::size_t MapSize = std::extent<decltype(Map)>::value;\n"
+        "static_assert((MapSize & (MapSize - 1U)) == 0U, \"Map size must be power of 2\");\n\n"
+        "static const std::uint32_t Seeds[] = {\n"
+        "    #^#SEEDS#$#\n"
+        "};\n"
+        "static const std::size_t SeedsCount = std::extent<decltype(Seeds)>::value;\n\n"
+        "std::uint32_t hash = #^#BASIS#$#;\n"
+        "for (std::size_t idx = 0U; idx < len; ++idx) {\n"
+        "    hash ^= static_cast<std::uint32_t>(static_cast<std::uint8_t>(name[idx]));\n"
+        "    hash *= #^#PRIME#$#;\n"
+        "}\n\n"
+        "#^#SLOT#$#\n"
+        "auto& info = Map[slot & (MapSize - 1U)];\n"
+        "if ((info.m_name == nullptr) || (info.m_len != len) || (std::memcmp(info.m_name, name, len) != 0)) {\n"
+        "    return std::make_pair(#^#VALUE_TYPE#$#(), false);\n"
+        "}\n\n"
+        "return std::make_pair(info.m_value, true);";
+
+    repl.insert({
+        {"ENTRIES", util::strListToString(entries, ",\n", "")},
+        {"SEEDS", util::strMakeMultiline(perfectHashSeedsStr(info))},
+        {"BASIS", util::numToString(static_cast<std::uintmax_t>(NameHashBasis ^ info.m_salt))},
+        {"PRIME", util::numToString(static_cast<std::uintmax_t>(NameHashPrime))},
+        {"SLOT", perfectHashSlotCode()},
+    });
+
+    return util::processTemplate(Templ, repl);
+}
+
+std::string CommsField::commsValueLookupIdxCode(const ValueLookupList& values, const std::string& valueExpr)
+{
+    assert(!values.empty());
+    PerfectHashInfo info;
+    bool built = 
+        buildPerfectHash(
+            values.size(), 
+            [&values](std::size_t idx, std::uint32_t salt)
+            {
+                return valueHash(values[idx], salt);
+            },
+            info);
+
+    if (!built) {
+        static constexpr bool Should_not_happen = false;
+        static_cast<void>(Should_not_happen);
+        assert(Should_not_happen);
+        return strings::emptyString();
+    }
+
+    util::StringsList indices;
+    indices.reserve(info.m_slots.size());
+    for (auto idx : info.m_slots) {
+        indices.push_back(util::numToString(static_cast<std::uintmax_t>(idx)));
+    }
+
+    static const std::string Templ = 
+        "static const std::size_t Indices[] = {\n"
+        "    #^#INDICES#$#\n"
+        "};\n"
+        "static const std::size_t IndicesCount = std::extent<decltype(Indices)>::value;\n"
+        "static_assert((IndicesCount & (IndicesCount - 1U)) == 0U, \"Indices count must be power of 2\");\n\n"
+        "static const std::uint32_t Seeds[] = {\n"
+        "    #^#SEEDS#$#\n"
+        "};\n"
+        "static const std::size_t SeedsCount = std::extent<decltype(Seeds)>::value;\n\n"
+        "auto key = static_cast<std::uint64_t>(#^#VALUE#$#) ^ #^#SALT#$#;\n"
+        "key ^= key >> 33U;\n"
+        "key *= 0xff51afd7ed558ccdULL;\n"
+        "key ^= key >> 33U;\n"
+        "auto hash = static_cast<std::uint32_t>(key);\n"
+        "#^#SLOT#$#\n"
+        "auto idx = Indices[slot & (IndicesCount - 1U)];";
+
+    util::ReplacementMap repl = {
+        {"INDICES", util::strMakeMultiline(util::strListToString(indices, ", ", ""))},
+        {"SEEDS", util::strMakeMultiline(perfectHashSeedsStr(info))},
+        {"VALUE", valueExpr},
+        {"SALT", util::numToString(static_cast<std::uintmax_t>(info.m_salt))},
+        {"SLOT", perfectHashSlotCode()},
+    };
+
+    return util::processTemplate(Templ, repl);
+}
+
+std::uintmax_t CommsField::commsBoundedStorageMaxPrefixValue(commsdsl::parse::Field prefix)
+{
+    if (prefix.kind() == commsdsl::parse::Field::Kind::Ref) {
+        return commsBoundedStorageMaxPrefixValue(commsdsl::parse::RefField(prefix).field());
+    }
+
+    if (prefix.kind() != commsdsl::parse::Field::Kind::Int) {
+        return 0U;
+    }
+
+    // The reported maximal value already excludes the serialisation offset
+    commsdsl::parse::IntField intPrefix(prefix);
+    auto maxValue = intPrefix.maxValue();
+    auto& validRanges = intPrefix.validRanges();
+    if (prefix.isFailOnInvalid() && (!validRanges.empty())) {
+        auto iter = 
+            std::max_element(
+                validRanges.begin(), validRanges.end(),
+                [](const commsdsl::parse::IntField::ValidRangeInfo& first, const commsdsl::parse::IntField::ValidRangeInfo& second)
+                {
+                    return first.m_max < second.m_max;
+                });
+
+        maxValue = std::min(maxValue, iter->m_max);
+    }
+
+    if (maxValue <= 0) {
+        return 0U;
+    }
+
+    return static_cast<std::uintmax_t>(maxValue);
+}
+
+CommsField::StringsList CommsField::commsBoundedStorageOpts(std::uintmax_t capacity, std::size_t elemSize) const
+{
+    assert(0U < elemSize);
+    if (capacity == 0U) {
+        m_field.generator().logger().info(
+            "Storage capacity of the \"" + comms::scopeFor(m_field, m_field.generator()) + 
+            "\" field cannot be bounded by the schema, keeping the bare metal default.");
+        return StringsList();
+    }
+
+    if ((MaxBoundedStorageSize / elemSize) < capacity) {
+        m_field.generator().logger().info(
+            "Storage capacity of the \"" + comms::scopeFor(m_field, m_field.generator()) + 
+            "\" field bounded by the schema (" + std::to_string(capacity) + " elements of up to " + 
+            std::to_string(elemSize) + " bytes) exceeds the limit of " + std::to_string(MaxBoundedStorageSize) + 
+            " bytes, keeping the bare metal default.");
+        return StringsList();
+    }
+
+    return 
+        StringsList{
+            "comms::option::app::FixedSizeStorage<" + util::numToString(static_cast<std::uintmax_t>(capacity)) + ">"
+        };
+}
+
 std::string CommsField::commsFieldBaseParams(commsdsl::parse::Endian endian) const
 {
     auto& schema = commsdsl::gen::Generator::schemaOf(m_field);
@@ -733,16 +1175,29 @@ std::string CommsField::commsFieldBaseParams(commsdsl::parse::Endian endian) con
     return comms::dslEndianToOpt(endian);
 }
 
+std::string CommsField::commsDefVersionAccessStr() const
+{
+    auto& schema = commsdsl::gen::Generator::schemaOf(m_field);
+    return schema.mainNamespace() + "::fieldVersion<TOpt>(Base::getVersion())";
+}
+
+void CommsField::commsAddCustomizationOption(StringsList& opts) const
+{
+    if (!commsIsFieldCustomizable()) {
+        return;
+    }
+
+    auto& gen = static_cast<const CommsGenerator&>(m_field.generator());
+    opts.push_back("typename TOpt::" + comms::scopeFor(m_field, m_field.generator(), gen.commsHasMainNamespaceInOptions(), true));
+}
+
 void CommsField::commsAddFieldDefOptions(commsdsl::gen::util::StringsList& opts) const
 {
     if (comms::isGlobalField(m_field)) {
         opts.push_back("TExtraOpts...");
     }
 
-    if (commsIsFieldCustomizable()) {
-        auto& gen = static_cast<const CommsGenerator&>(m_field.generator());
-        opts.push_back("typename TOpt::" + comms::scopeFor(m_field, m_field.generator(), gen.commsHasMainNamespaceInOptions(), true));
-    }
+    commsAddCustomizationOption(opts);
 
     do {
         auto checkFieldTypeFunc = 
@@ -1065,8 +1520,13 @@ std::string CommsField::commsOptionalDefCodeInternal() const
         "struct #^#CLASS_NAME#$# : public\n"
         "    comms::field::Optional<\n"
         "        #^#CLASS_NAME#$#Field#^#FIELD_PARAMS#$#,\n"
-        "        comms::option::def::#^#DEFAULT_MODE_OPT#$#,\n"
-        "        comms::option::def::#^#VERSIONS_OPT#$#\n"
+        "        #^#PROT_NAMESPACE#$#::VersionOptionalFieldOptions<\n"
+        "            TOpt,\n"
+        "            #^#FROM_VERSION#$#,\n"
+        "            #^#UNTIL_VERSION#$#,\n"
+        "            comms::option::def::#^#DEFAULT_MODE_OPT#$#,\n"
+        "            comms::option::def::#^#VERSIONS_OPT#$#\n"
+        "        >\n"
         "    >\n"
         "{\n"
         "    /// @brief Name of the field.\n"
@@ -1091,7 +1551,9 @@ std::string CommsField::commsOptionalDefCodeInternal() const
         }
 
         std::string versionOpt = "ExistsSinceVersion<" + util::numToString(dslObj.sinceVersion()) + '>';
+        std::string untilVersion = "std::numeric_limits<unsigned>::max()";
         if (dslObj.isDeprecatedRemoved()) {
+            untilVersion = util::numToString(dslObj.deprecatedSince() - 1);
             assert(dslObj.deprecatedSince() < commsdsl::parse::Protocol::notYetDeprecated());
             if (dslObj.sinceVersion() == 0U) {
                 versionOpt = "ExistsUntilVersion<" + util::numToString(dslObj.deprecatedSince() - 1) + '>';
@@ -1112,6 +1574,9 @@ std::string CommsField::commsOptionalDefCodeInternal() const
         {"CLASS_NAME", comms::className(dslObj.name())},
         {"DEFAULT_MODE_OPT", std::move(defaultModeOpt)},
         {"VERSIONS_OPT", std::move(versionOpt)},
+        {"PROT_NAMESPACE", generator.schemaOf(m_field).mainNamespace()},
+        {"FROM_VERSION", util::numToString(dslObj.sinceVersion())},
+        {"UNTIL_VERSION", std::move(untilVersion)},
     };
 
     if (comms::isGlobalField(m_field)) {
@@ -1847,4 +2312,9 @@ CommsField::StringsList CommsField::commsExtraBareMetalDefaultOptionsInternal()
     return commsExtraBareMetalDefaultOptionsImpl();
 }
 
+CommsField::StringsList CommsField::commsExtraBoundedBareMetalDefaultOptionsInternal() const
+{
+    return commsExtraBoundedBareMetalDefaultOptionsImpl();
+}
+
 } // namespace commsdsl2comms
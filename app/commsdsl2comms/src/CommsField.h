@@ -20,7 +20,9 @@
 
 #include "commsdsl/parse/Endian.h"
 
+#include <cstdint>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace commsdsl2comms
@@ -33,6 +35,9 @@ public:
     using IncludesList = StringsList;
     using CommsFieldsList = std::vector<CommsField*>;
     using FieldOptsFunc = std::string (CommsField::*)() const;
+    using NameLookupElem = std::pair<std::string, std::string>;
+    using NameLookupList = std::vector<NameLookupElem>;
+    using ValueLookupList = std::vector<std::uint64_t>;
 
     explicit CommsField(commsdsl::gen::Field& field);
     virtual ~CommsField();
@@ -86,11 +91,14 @@ public:
     std::string commsDefaultOptions() const;
     std::string commsDataViewDefaultOptions() const;
     std::string commsBareMetalDefaultOptions() const;
+    std::string commsBoundedBareMetalDefaultOptions() const;
 
     bool commsHasCustomValue() const;
     bool commsHasCustomValid() const;
+    bool commsHasCustomReadWrite() const;
     bool commsHasCustomLength(bool deepCheck = true) const;
     const CommsField* commsFindSibling(const std::string& name) const;
+    void commsAddCustomizationOption(StringsList& opts) const;
 
 protected:
     virtual IncludesList commsCommonIncludesImpl() const;
@@ -123,6 +131,7 @@ protected:
     virtual std::string commsMembersCustomizationOptionsBodyImpl(FieldOptsFunc fieldOptsFunc) const;
     virtual StringsList commsExtraDataViewDefaultOptionsImpl() const;
     virtual StringsList commsExtraBareMetalDefaultOptionsImpl() const;
+    virtual StringsList commsExtraBoundedBareMetalDefaultOptionsImpl() const;
     virtual std::size_t commsMinLengthImpl() const;
     virtual std::size_t commsMaxLengthImpl() const;    
     virtual std::string commsValueAccessStrImpl(const std::string& accStr, const std::string& prefix) const;
@@ -135,7 +144,20 @@ protected:
     virtual bool commsMustDefineDefaultConstructorImpl() const;
 
     std::string commsCommonNameFuncCode() const;
+    static void commsAddNameLookupElem(NameLookupList& names, const std::string& name, const std::string& valueStr);
+    static std::string commsNameLookupFuncCode(
+        const NameLookupList& names,
+        const std::string& funcName,
+        const std::string& valueType,
+        const std::string& brief,
+        const std::string& elemDesc,
+        const std::string& resultDesc);
+    static std::string commsNameLookupBodyCode(const NameLookupList& names, const std::string& valueType);
+    static std::string commsValueLookupIdxCode(const ValueLookupList& values, const std::string& valueExpr);
+    static std::uintmax_t commsBoundedStorageMaxPrefixValue(commsdsl::parse::Field prefix);
+    StringsList commsBoundedStorageOpts(std::uintmax_t capacity, std::size_t elemSize = 1U) const;
     std::string commsFieldBaseParams(commsdsl::parse::Endian endian) const;
+    std::string commsDefVersionAccessStr() const;
     void commsAddFieldDefOptions(commsdsl::gen::util::StringsList& opts) const;
     void commsAddFieldTypeOption(commsdsl::gen::util::StringsList& opts) const;
     bool commsIsFieldCustomizable() const;
@@ -198,6 +220,7 @@ private:
         bool hasBase) const;
     StringsList commsExtraDataViewDefaultOptionsInternal() const;
     StringsList commsExtraBareMetalDefaultOptionsInternal() const;
+    StringsList commsExtraBoundedBareMetalDefaultOptionsInternal() const;
 
     commsdsl::gen::Field& m_field;
     CustomCode m_customCode;
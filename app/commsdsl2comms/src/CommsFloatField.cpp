@@ -224,6 +224,16 @@ CommsFloatField::IncludesList CommsFloatField::commsCommonIncludesImpl() const
         result.push_back("<limits>");
     }
 
+    if (!specials.empty()) {
+        result.insert(result.end(),
+            {
+                "<cstdint>",
+                "<cstring>",
+                "<type_traits>", 
+                "<utility>"
+            });
+    }
+
     return result;
 }
 
@@ -237,7 +247,8 @@ std::string CommsFloatField::commsCommonCodeBodyImpl() const
         "#^#NAME_FUNC#$#\n"
         "#^#HAS_SPECIAL_FUNC#$#\n"
         "#^#SPECIALS#$#\n"
-        "#^#SPECIAL_NAMES_MAP#$#\n"    
+        "#^#SPECIAL_NAMES_MAP#$#\n"
+        "#^#SPECIAL_FROM_NAME#$#\n"
     ;
 
     auto& gen = generator();
@@ -254,6 +265,7 @@ std::string CommsFloatField::commsCommonCodeBodyImpl() const
             {"SPECIAL_VALUE_NAMES_MAP_DEFS", commsCommonValueNamesMapCodeInternal()},
             {"SPECIALS", commsCommonSpecialsCodeInternal()},
             {"SPECIAL_NAMES_MAP", commsCommonSpecialNamesMapCodeInternal()},
+            {"SPECIAL_FROM_NAME", commsCommonSpecialValueFromNameCodeInternal()},
         });
     }
 
@@ -348,6 +360,7 @@ std::string CommsFloatField::commsDefPublicCodeImpl() const
         "#^#HAS_SPECIALS#$#\n"
         "#^#SPECIALS#$#\n"
         "#^#SPECIAL_NAMES_MAP#$#\n"
+        "#^#SPECIAL_FROM_NAME#$#\n"
         "#^#DISPLAY_DECIMALS#$#\n"
     ;
 
@@ -356,6 +369,7 @@ std::string CommsFloatField::commsDefPublicCodeImpl() const
         {"HAS_SPECIALS", commsDefHasSpecialsFuncCodeInternal()},
         {"SPECIALS", commsDefSpecialsCodeInternal()},
         {"SPECIAL_NAMES_MAP", commsDefSpecialNamesMapCodeInternal()},
+        {"SPECIAL_FROM_NAME", commsDefSpecialValueFromNameCodeInternal()},
         {"DISPLAY_DECIMALS", commsDefDisplayDecimalsCodeInternal()},
     };
 
@@ -624,6 +638,28 @@ std::string CommsFloatField::commsDefSpecialNamesMapCodeInternal() const
     return util::processTemplate(Templ, repl);    
 }
 
+std::string CommsFloatField::commsDefSpecialValueFromNameCodeInternal() const
+{
+    auto& specials = specialsSortedByValue();
+    if (specials.empty()) {
+        return strings::emptyString();
+    }
+
+    static const std::string Templ = 
+        "/// @brief Retrieve special value by its name.\n"
+        "/// @see @ref #^#COMMON#$#::specialValueFromName().\n"
+        "static std::pair<ValueType, bool> specialValueFromName(const char* name, std::size_t len)\n"
+        "{\n"
+        "    return #^#COMMON#$#::specialValueFromName(name, len);\n"
+        "}\n";    
+
+    util::ReplacementMap repl {
+        {"COMMON", comms::commonScopeFor(*this, generator())}
+    };
+
+    return util::processTemplate(Templ, repl);    
+}
+
 std::string CommsFloatField::commsDefDisplayDecimalsCodeInternal() const
 {
     static const std::string Templ = 
@@ -641,6 +677,39 @@ std::string CommsFloatField::commsDefDisplayDecimalsCodeInternal() const
     return util::processTemplate(Templ, repl);
 }
 
+std::string CommsFloatField::commsCommonSpecialValueFromNameCodeInternal() const
+{
+    auto& specials = specialsSortedByValue();
+    if (specials.empty()) {
+        return strings::emptyString();
+    }
+
+    NameLookupList names;
+    names.reserve(specials.size() * 2U);
+    auto& gen = generator();
+    for (auto& s : specials) {
+        if (!gen.doesElementExist(s.second.m_sinceVersion, s.second.m_deprecatedSince, true)) {
+            continue;
+        }
+
+        commsAddNameLookupElem(names, s.first, "value" + comms::className(s.first) + "()");
+    }
+
+    for (auto& s : specials) {
+        if (!gen.doesElementExist(s.second.m_sinceVersion, s.second.m_deprecatedSince, true)) {
+            continue;
+        }
+
+        commsAddNameLookupElem(names, s.second.m_displayName, "value" + comms::className(s.first) + "()");
+    }
+
+    return 
+        commsNameLookupFuncCode(
+            names, "specialValueFromName", "ValueType",
+            "special value",
+            "special value", "value");
+}
+
 std::string CommsFloatField::commsDefFieldOptsInternal() const
 {
     util::StringsList opts;
@@ -830,18 +899,18 @@ CommsFloatField::StringsList CommsFloatField::commsValidVersionBasedConditionsIn
         }
 
         static const std::string VersionConditionTemplate =
-            "if ((#^#MIN_VERSION#$# <= Base::getVersion()) &&\n"
-            "    (Base::getVersion() < #^#MAX_VERSION#$#)) {\n"
+            "if ((#^#MIN_VERSION#$# <= #^#VERSION#$#) &&\n"
+            "    (#^#VERSION#$# < #^#MAX_VERSION#$#)) {\n"
             "    #^#CONDITIONS#$#\n"
             "}\n";
 
         static const std::string FromVersionConditionTemplate =
-            "if (#^#MIN_VERSION#$# <= Base::getVersion()) {\n"
+            "if (#^#MIN_VERSION#$# <= #^#VERSION#$#) {\n"
             "    #^#CONDITIONS#$#\n"
             "}\n";
 
         static const std::string UntilVersionConditionTemplate =
-            "if (Base::getVersion() < #^#MAX_VERSION#$#) {\n"
+            "if (#^#VERSION#$# < #^#MAX_VERSION#$#) {\n"
             "    #^#CONDITIONS#$#\n"
             "}\n";        
 
@@ -857,6 +926,7 @@ CommsFloatField::StringsList CommsFloatField::commsValidVersionBasedConditionsIn
         util::ReplacementMap repl = {
             {"MIN_VERSION", util::numToString(fromVersion)},
             {"MAX_VERSION", util::numToString(untilVersion)},
+            {"VERSION", commsDefVersionAccessStr()},
             {"CONDITIONS", util::strListToString(innerConditions, "\n", "")},
         };
 
@@ -51,11 +51,13 @@ private:
     std::string commsCommonValueNamesMapCodeInternal() const;
     std::string commsCommonSpecialsCodeInternal() const;
     std::string commsCommonSpecialNamesMapCodeInternal() const;
+    std::string commsCommonSpecialValueFromNameCodeInternal() const;
     std::string commsDefFieldOptsInternal() const;
     std::string commsDefValueNamesMapCodeInternal() const;
     std::string commsDefHasSpecialsFuncCodeInternal() const;
     std::string commsDefSpecialsCodeInternal() const;
     std::string commsDefSpecialNamesMapCodeInternal() const;
+    std::string commsDefSpecialValueFromNameCodeInternal() const;
     std::string commsDefDisplayDecimalsCodeInternal() const;
 
     void commsAddUnitsOptInternal(StringsList& opts) const;
@@ -22,11 +22,15 @@
 #include "commsdsl/gen/strings.h"
 #include "commsdsl/gen/util.h"
 
+#include "commsdsl/parse/IntField.h"
+#include "commsdsl/parse/RefField.h"
 
 #include <algorithm>
 #include <cassert>
 #include <fstream>
+#include <iomanip>
 #include <iterator>
+#include <sstream>
 
 namespace comms = commsdsl::gen::comms;
 namespace strings = commsdsl::gen::strings;
@@ -58,6 +62,50 @@ bool hasIdLayerInternal(const CommsFrame::CommsLayersList& commsLayers)
     });
 }
 
+commsdsl::parse::Field resolvedRefFieldInternal(commsdsl::parse::Field field)
+{
+    if (field.kind() != commsdsl::parse::Field::Kind::Ref) {
+        return field;
+    }
+
+    return resolvedRefFieldInternal(commsdsl::parse::RefField(field).field());
+}
+
+std::string sizeRangeCondInternal(const commsdsl::gen::Layer& layer, const std::string& name)
+{
+    auto* field = layer.externalField();
+    if (field == nullptr) {
+        field = layer.memberField();
+    }
+
+    assert(field != nullptr);
+    auto fieldDslObj = resolvedRefFieldInternal(field->dslObj());
+    if ((fieldDslObj.kind() != commsdsl::parse::Field::Kind::Int) ||
+        (fieldDslObj.minLength() != fieldDslObj.maxLength()) ||
+        (sizeof(std::uintmax_t) <= fieldDslObj.minLength())) {
+        // The stored value must be the same as the assigned one
+        return "static_cast<std::uintmax_t>(" + name + "Field.getValue()) != static_cast<std::uintmax_t>(remLen)";
+    }
+
+    commsdsl::parse::IntField intDslObj(fieldDslObj);
+    auto serOffset = intDslObj.serOffset();
+    auto maxSerValue = (static_cast<std::uintmax_t>(1U) << (fieldDslObj.minLength() * 8U)) - 1U;
+    std::uintmax_t maxValue = 0U;
+    if (serOffset < 0) {
+        maxValue = maxSerValue + static_cast<std::uintmax_t>(-serOffset);
+    }
+    else if (static_cast<std::uintmax_t>(serOffset) < maxSerValue) {
+        maxValue = maxSerValue - static_cast<std::uintmax_t>(serOffset);
+    }
+
+    auto cond = util::numToString(maxValue) + " < static_cast<std::uintmax_t>(remLen)";
+    if (serOffset < 0) {
+        cond = "(static_cast<std::uintmax_t>(remLen) < " + util::numToString(static_cast<std::uintmax_t>(-serOffset)) + ") || (" + cond + ")";
+    }
+
+    return cond;
+}
+
 } // namespace 
    
 
@@ -266,7 +314,9 @@ bool CommsFrame::commsWriteDefInternal() const
         "    #^#ACCESS_FUNCS_DOC#$#\n"
         "    COMMS_PROTOCOL_LAYERS_NAMES(\n"
         "        #^#LAYERS_ACCESS_LIST#$#\n"
-        "    );\n"
+        "    );\n\n"
+        "    #^#RESYNC#$#\n"
+        "    #^#WRITE_SEGMENTS#$#\n"
         "    #^#PUBLIC#$#\n"
         "#^#PROTECTED#$#\n"
         "#^#PRIVATE#$#\n"
@@ -290,6 +340,8 @@ bool CommsFrame::commsWriteDefInternal() const
         {"INPUT_MESSAGES", commsDefInputMessagesParamInternal()},
         {"ACCESS_FUNCS_DOC", commsDefAccessDocInternal()},
         {"LAYERS_ACCESS_LIST", commsDefAccessListInternal()},
+        {"RESYNC", commsDefResyncFuncInternal()},
+        {"WRITE_SEGMENTS", commsDefWriteSegmentsFuncInternal()},
         {"PUBLIC", util::readFileContents(inputCodePrefix + strings::publicFileSuffixStr())},
         {"PROTECTED", commsDefProtectedInternal()},
         {"PRIVATE", commsDefPrivateInternal()},
@@ -339,6 +391,10 @@ std::string CommsFrame::commsDefIncludesInternal() const
 {
     auto& gen = generator();
     util::StringsList includes = {
+        "<algorithm>",
+        "<cstddef>",
+        "<cstdint>",
+        "<cstring>",
         comms::relHeaderForOptions(strings::defaultOptionsClassStr(), gen),
         comms::relHeaderForInput(strings::allMessagesStr(), gen)
     };
@@ -347,6 +403,15 @@ std::string CommsFrame::commsDefIncludesInternal() const
         includes.push_back(comms::relCommonHeaderPathFor(*this, gen));
     }
 
+    if (commsIsWriteSegmentsSupportedInternal()) {
+        includes.insert(includes.end(), {
+            "<type_traits>",
+            "<utility>",
+            "comms/ErrorStatus.h",
+            "comms/Message.h",
+        });
+    }
+
     for (auto* commsLayer : m_commsLayers) {
         assert(commsLayer != nullptr);
 
@@ -478,20 +543,287 @@ std::string CommsFrame::commsDefProtectedInternal() const
 std::string CommsFrame::commsDefPrivateInternal() const
 {
     auto code = util::readFileContents(comms::inputCodePathFor(*this, generator()) + strings::privateFileSuffixStr());
-    if (code.empty()) {
+    auto writeSegmentsCode = commsDefWriteSegmentsPrivateInternal();
+    if (code.empty() && writeSegmentsCode.empty()) {
         return strings::emptyString();
     }
 
     static const std::string Templ = 
     "private:\n"
+    "    #^#WRITE_SEGMENTS#$#\n"
     "    #^#CODE#$#\n";
 
     util::ReplacementMap repl = {
+        {"WRITE_SEGMENTS", std::move(writeSegmentsCode)},
         {"CODE", std::move(code)},
     };
     return util::processTemplate(Templ, repl);
 }
 
+bool CommsFrame::commsIsWriteSegmentsSupportedInternal() const
+{
+    if (m_commsLayers.size() < 2U) {
+        return false;
+    }
+
+    if (m_commsLayers.back()->layer().dslObj().kind() != commsdsl::parse::Layer::Kind::Payload) {
+        return false;
+    }
+
+    return 
+        std::all_of(
+            m_commsLayers.begin(), m_commsLayers.end() - 1,
+            [](auto* l)
+            {
+                using LayerKind = commsdsl::parse::Layer::Kind;
+                auto kind = l->layer().dslObj().kind();
+                return 
+                    (kind == LayerKind::Sync) ||
+                    (kind == LayerKind::Size) ||
+                    (kind == LayerKind::Id);
+            });
+}
+
+std::string CommsFrame::commsDefWriteSegmentsFuncInternal() const
+{
+    if (!commsIsWriteSegmentsSupportedInternal()) {
+        return strings::emptyString();
+    }
+
+    static const std::string Templ = 
+        "/// @brief Serialise the frame as a sequence of memory segments.\n"
+        "/// @details The transport header (all the fields preceding the payload) is\n"
+        "///     written into the beginning of the scratch buffer and reported as\n"
+        "///     a separate segment. The message payload is serialised using\n"
+        "///     @b writeSegments() member function of the message class, which references\n"
+        "///     raw data fields in place, when such exists. Otherwise the payload is\n"
+        "///     written into the remaining scratch buffer as a whole.\n"
+        "/// @tparam TMsg Type of the message object, must be the actual message class.\n"
+        "/// @param[in] msg Message object.\n"
+        "/// @param[in] scratch Buffer for the bytes that are not referenced in place.\n"
+        "/// @param[in] scratchLen Size of the scratch buffer.\n"
+        "/// @param[in] handler Functor invoked for every segment in order with\n"
+        "///     <b>(const std::uint8_t* data, std::size_t len)</b> parameters.\n"
+        "/// @return Status of the operation.\n"
+        "template <typename TMsg, typename THandler>\n"
+        "comms::ErrorStatus writeSegments(const TMsg& msg, std::uint8_t* scratch, std::size_t scratchLen, THandler&& handler) const\n"
+        "{\n"
+        "    static_assert(comms::isMessageBase<TMsg>(), \"Must be actual message class\");\n"
+        "    auto* iter = scratch;\n"
+        "    auto* end = scratch + scratchLen;\n"
+        "    auto es = comms::ErrorStatus::Success;\n"
+        "    std::size_t remLen = msg.doLength();\n"
+        "    static_cast<void>(remLen);\n\n"
+        "    #^#PREPARE#$#\n"
+        "    #^#WRITE#$#\n"
+        "    if (iter != scratch) {\n"
+        "        handler(static_cast<const std::uint8_t*>(scratch), static_cast<std::size_t>(iter - scratch));\n"
+        "    }\n\n"
+        "    using Tag = typename WriteSegmentsTagInternal<TMsg, THandler>::Type;\n"
+        "    return writeSegmentsPayloadInternal(msg, iter, static_cast<std::size_t>(end - iter), std::forward<THandler>(handler), Tag());\n"
+        "}\n";
+
+    static const std::string SyncTempl = 
+        "typename Layer_#^#NAME#$#::Field #^#NAME#$#Field;\n"
+        "remLen += #^#NAME#$#Field.length();\n";
+
+    static const std::string SizeTempl = 
+        "typename Layer_#^#NAME#$#::Field #^#NAME#$#Field;\n"
+        "#^#NAME#$#Field.setValue(remLen);\n"
+        "if (#^#RANGE_COND#$#) {\n"
+        "    // The length doesn't fit into the size field\n"
+        "    return comms::ErrorStatus::BufferOverflow;\n"
+        "}\n\n"
+        "remLen += #^#NAME#$#Field.length();\n";
+
+    static const std::string IdTempl = 
+        "typename Layer_#^#NAME#$#::Field #^#NAME#$#Field;\n"
+        "#^#NAME#$#Field.setValue(msg.doGetId());\n"
+        "remLen += #^#NAME#$#Field.length();\n";
+
+    static const std::string WriteTempl = 
+        "es = #^#NAME#$#Field.write(iter, static_cast<std::size_t>(end - iter));\n"
+        "if (es != comms::ErrorStatus::Success) {\n"
+        "    return es;\n"
+        "}\n";
+
+    util::StringsList prepare;
+    util::StringsList writes;
+    for (auto iter = m_commsLayers.rbegin() + 1; iter != m_commsLayers.rend(); ++iter) {
+        auto& layer = (*iter)->layer();
+        util::ReplacementMap repl = {
+            {"NAME", comms::accessName(layer.dslObj().name())},
+        };
+
+        auto* templ = &SyncTempl;
+        auto kind = layer.dslObj().kind();
+        if (kind == commsdsl::parse::Layer::Kind::Size) {
+            templ = &SizeTempl;
+            repl["RANGE_COND"] = sizeRangeCondInternal(layer, repl["NAME"]);
+        }
+        else if (kind == commsdsl::parse::Layer::Kind::Id) {
+            templ = &IdTempl;
+        }
+
+        prepare.push_back(util::processTemplate(*templ, repl));
+        writes.insert(writes.begin(), util::processTemplate(WriteTempl, repl));
+    }
+
+    util::ReplacementMap repl = {
+        {"PREPARE", util::strListToString(prepare, "\n", "\n")},
+        {"WRITE", util::strListToString(writes, "\n", "\n")},
+    };
+
+    return util::processTemplate(Templ, repl);
+}
+
+std::string CommsFrame::commsDefWriteSegmentsPrivateInternal() const
+{
+    if (!commsIsWriteSegmentsSupportedInternal()) {
+        return strings::emptyString();
+    }
+
+    static const std::string Templ = 
+        "template <typename TMsg, typename THandler>\n"
+        "struct WriteSegmentsTagInternal\n"
+        "{\n"
+        "    template <typename T>\n"
+        "    static auto test(int) -> decltype(std::declval<const T&>().writeSegments(std::declval<std::uint8_t*>(), std::size_t(0U), std::declval<THandler>()), std::true_type());\n\n"
+        "    template <typename>\n"
+        "    static std::false_type test(...);\n\n"
+        "    using Type = decltype(test<TMsg>(0));\n"
+        "};\n\n"
+        "template <typename TMsg, typename THandler>\n"
+        "static comms::ErrorStatus writeSegmentsPayloadInternal(const TMsg& msg, std::uint8_t* scratch, std::size_t scratchLen, THandler&& handler, std::true_type)\n"
+        "{\n"
+        "    return msg.writeSegments(scratch, scratchLen, std::forward<THandler>(handler));\n"
+        "}\n\n"
+        "template <typename TMsg, typename THandler>\n"
+        "static comms::ErrorStatus writeSegmentsPayloadInternal(const TMsg& msg, std::uint8_t* scratch, std::size_t scratchLen, THandler&& handler, std::false_type)\n"
+        "{\n"
+        "    auto* iter = scratch;\n"
+        "    auto es = msg.doWrite(iter, scratchLen);\n"
+        "    if (es != comms::ErrorStatus::Success) {\n"
+        "        return es;\n"
+        "    }\n\n"
+        "    if (iter != scratch) {\n"
+        "        handler(static_cast<const std::uint8_t*>(scratch), static_cast<std::size_t>(iter - scratch));\n"
+        "    }\n\n"
+        "    return comms::ErrorStatus::Success;\n"
+        "}\n";
+
+    return Templ;
+}
+
+std::string CommsFrame::commsDefResyncFuncInternal() const
+{
+    auto prefix = commsSyncPrefixInternal();
+    if (prefix.empty()) {
+        static const std::string NoSyncTempl = 
+            "/// @brief Find offset of the next possible frame start after a protocol error.\n"
+            "/// @details The frame doesn't start with a constant sync prefix, hence\n"
+            "///     every offset is a candidate.\n"
+            "/// @param[in] buf Input buffer.\n"
+            "/// @param[in] len Length of the input buffer.\n"
+            "/// @return @b 1 for non-empty buffer, @b 0 otherwise.\n"
+            "static std::size_t resyncOffset(const void* buf, std::size_t len)\n"
+            "{\n"
+            "    static_cast<void>(buf);\n"
+            "    return std::min(len, static_cast<std::size_t>(1U));\n"
+            "}\n";
+
+        return NoSyncTempl;
+    }
+
+    static const std::string Templ = 
+        "/// @brief Find offset of the next possible frame start after a protocol error.\n"
+        "/// @details Searches for the constant prefix of the leading sync layer,\n"
+        "///     starting from offset @b 1. A prefix cut off at the end of the buffer\n"
+        "///     is still reported as a candidate.\n"
+        "/// @param[in] buf Input buffer.\n"
+        "/// @param[in] len Length of the input buffer.\n"
+        "/// @return Offset of the next candidate, @b len if none was found.\n"
+        "static std::size_t resyncOffset(const void* buf, std::size_t len)\n"
+        "{\n"
+        "    static const std::uint8_t Prefix[] = {#^#PREFIX#$#};\n"
+        "    static const std::size_t PrefixLen = sizeof(Prefix);\n"
+        "    auto* bytes = static_cast<const std::uint8_t*>(buf);\n"
+        "    std::size_t pos = 1U;\n"
+        "    while (pos < len) {\n"
+        "        auto* found = static_cast<const std::uint8_t*>(std::memchr(bytes + pos, Prefix[0], len - pos));\n"
+        "        if (found == nullptr) {\n"
+        "            break;\n"
+        "        }\n\n"
+        "        pos = static_cast<std::size_t>(found - bytes);\n"
+        "        if (std::memcmp(found, &Prefix[0], std::min(PrefixLen, len - pos)) == 0) {\n"
+        "            return pos;\n"
+        "        }\n\n"
+        "        ++pos;\n"
+        "    }\n"
+        "    return len;\n"
+        "}\n";
+
+    util::StringsList bytes;
+    for (auto b : prefix) {
+        std::stringstream stream;
+        stream << "0x" << std::hex << std::setfill('0') << std::setw(2) << static_cast<unsigned>(b);
+        bytes.push_back(stream.str());
+    }
+
+    util::ReplacementMap repl = {
+        {"PREFIX", util::strListToString(bytes, ", ", "")},
+    };
+
+    return util::processTemplate(Templ, repl);
+}
+
+std::vector<std::uint8_t> CommsFrame::commsSyncPrefixInternal() const
+{
+    std::vector<std::uint8_t> result;
+    if (m_commsLayers.empty()) {
+        return result;
+    }
+
+    auto& firstLayer = m_commsLayers.front()->layer();
+    if (firstLayer.dslObj().kind() != commsdsl::parse::Layer::Kind::Sync) {
+        return result;
+    }
+
+    auto* field = firstLayer.externalField();
+    if (field == nullptr) {
+        field = firstLayer.memberField();
+    }
+
+    if (field == nullptr) {
+        return result;
+    }
+
+    auto fieldDslObj = resolvedRefFieldInternal(field->dslObj());
+
+    if ((fieldDslObj.kind() != commsdsl::parse::Field::Kind::Int) ||
+        (fieldDslObj.minLength() != fieldDslObj.maxLength()) ||
+        (sizeof(std::uintmax_t) < fieldDslObj.minLength())) {
+        return result;
+    }
+
+    // The sync layer compares the read field with the default constructed one
+    commsdsl::parse::IntField intDslObj(fieldDslObj);
+    auto value = static_cast<std::uintmax_t>(intDslObj.defaultValue() + intDslObj.serOffset());
+    auto len = fieldDslObj.minLength();
+    result.resize(len);
+    for (auto idx = 0U; idx < len; ++idx) {
+        auto byte = static_cast<std::uint8_t>((value >> (idx * 8U)) & 0xffU);
+        if (intDslObj.endian() == commsdsl::parse::Endian_Big) {
+            result[len - idx - 1U] = byte;
+            continue;
+        }
+
+        result[idx] = byte;
+    }
+
+    return result;
+}
+
 std::string CommsFrame::commsCustomizationOptionsInternal(
     LayerOptsFunc layerOptsFunc,
     bool hasBase) const
@@ -20,6 +20,7 @@
 
 #include "CommsLayer.h"
 
+#include <cstdint>
 #include <vector>
 #include <string>
 
@@ -61,6 +62,11 @@ private:
     std::string commsDefAccessListInternal() const;
     std::string commsDefProtectedInternal() const;
     std::string commsDefPrivateInternal() const;
+    std::string commsDefResyncFuncInternal() const;
+    bool commsIsWriteSegmentsSupportedInternal() const;
+    std::string commsDefWriteSegmentsFuncInternal() const;
+    std::string commsDefWriteSegmentsPrivateInternal() const;
+    std::vector<std::uint8_t> commsSyncPrefixInternal() const;
     std::string commsCustomizationOptionsInternal(
         LayerOptsFunc layerOptsFunc,
         bool hasBase) const;    
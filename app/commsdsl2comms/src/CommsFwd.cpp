@@ -0,0 +1,200 @@
+//
+// Copyright 2019 - 2023 (C). Alex Robenko. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "CommsFwd.h"
+
+#include "CommsGenerator.h"
+#include "CommsSchema.h"
+
+#include "commsdsl/gen/comms.h"
+#include "commsdsl/gen/strings.h"
+#include "commsdsl/gen/util.h"
+
+#include <cassert>
+#include <fstream>
+#include <utility>
+#include <vector>
+
+namespace comms = commsdsl::gen::comms;
+namespace strings = commsdsl::gen::strings;
+namespace util = commsdsl::gen::util;
+
+namespace commsdsl2comms
+{
+
+namespace 
+{
+
+const std::string FwdStr("Fwd");
+
+using FwdDecl = std::pair<std::string, std::string>; // scope, declaration
+using FwdDeclsList = std::vector<FwdDecl>;
+
+void addDeclInternal(const std::string& scope, const std::string& templ, FwdDeclsList& decls)
+{
+    auto pos = scope.rfind("::");
+    assert(pos != std::string::npos);
+    decls.emplace_back(scope.substr(0, pos), templ + ' ' + scope.substr(pos + 2) + ';');
+}
+
+std::string declsCodeInternal(const FwdDeclsList& decls)
+{
+    static const std::string Templ = 
+        "#^#BEGIN#$#\n"
+        "#^#DECLS#$#\n"
+        "#^#END#$#\n";
+
+    util::StringsList blocks;
+    auto iter = decls.begin();
+    while (iter != decls.end()) {
+        auto& scope = iter->first;
+        util::StringsList declsList;
+        while ((iter != decls.end()) && (iter->first == scope)) {
+            declsList.push_back(iter->second);
+            ++iter;
+        }
+
+        auto namespaces = util::strSplitByAnyChar(scope, ":");
+        util::StringsList begins;
+        util::StringsList ends;
+        for (auto& ns : namespaces) {
+            begins.push_back("namespace " + ns + "\n{\n");
+            ends.insert(ends.begin(), "} // namespace " + ns + "\n");
+        }
+
+        util::ReplacementMap repl = {
+            {"BEGIN", util::strListToString(begins, "\n", "")},
+            {"DECLS", util::strListToString(declsList, "\n\n", "\n")},
+            {"END", util::strListToString(ends, "\n", "")},
+        };
+
+        blocks.push_back(util::processTemplate(Templ, repl));
+    }
+
+    return util::strListToString(blocks, "\n", "");
+}
+
+} // namespace 
+
+bool CommsFwd::write(CommsGenerator& generator)
+{
+    auto& thisSchema = static_cast<CommsSchema&>(generator.currentSchema());
+    if ((!generator.isCurrentProtocolSchema()) && (!thisSchema.commsHasAnyGeneratedCode())) {
+        return true;
+    }
+
+    CommsFwd obj(generator);
+    return obj.commsWriteInternal();
+}
+
+bool CommsFwd::commsWriteInternal() const
+{
+    auto& gen = m_generator;
+    FwdDeclsList decls;
+
+    auto emptyOptionsScope = comms::scopeForOptions("EmptyOptions", gen);
+    addDeclInternal(emptyOptionsScope, "struct", decls);
+
+    auto& defaultOptionsName = strings::defaultOptionsClassStr();
+    auto defaultOptionsExtended = 
+        !util::readFileContents(comms::inputCodePathForOptions(defaultOptionsName, gen) + strings::extendFileSuffixStr()).empty();
+
+    if (defaultOptionsExtended) {
+        addDeclInternal(comms::scopeForOptions(defaultOptionsName + strings::origSuffixStr() + 'T', gen), "template <typename TBase>\nstruct", decls);
+    }
+    else {
+        auto defaultOptionsScope = comms::scopeForOptions(defaultOptionsName, gen);
+        addDeclInternal(defaultOptionsScope + 'T', "template <typename TBase>\nstruct", decls);
+        decls.back().second += "\n\nusing " + defaultOptionsName + " = " + defaultOptionsName + "T<" + emptyOptionsScope + ">;";
+    }
+
+    static const std::string ExtOptionsPrefixes[] = {
+        "Client",
+        "Server",
+        strings::dataViewStr(),
+        strings::bareMetalStr(),
+        "Bounded" + strings::bareMetalStr(),
+    };
+
+    for (auto& p : ExtOptionsPrefixes) {
+        addDeclInternal(comms::scopeForOptions(p + defaultOptionsName + 'T', gen), "template <typename TBase>\nstruct", decls);
+    }
+
+    addDeclInternal(comms::scopeForOptions("FixedVersion" + defaultOptionsName + 'T', gen), "template <unsigned TVersion, typename TBase>\nstruct", decls);
+
+    for (auto* i : gen.getAllInterfaces()) {
+        assert(i != nullptr);
+        addDeclInternal(comms::scopeFor(*i, gen), "template <typename... TOpt>\nclass", decls);
+    }
+
+    for (auto* f : gen.currentSchema().getAllFields()) {
+        assert(f != nullptr);
+        if (!f->isReferenced()) {
+            continue;
+        }
+
+        addDeclInternal(comms::scopeFor(*f, gen), "template <typename TOpt, typename... TExtraOpts>\nclass", decls);
+    }
+
+    for (auto* m : gen.getAllMessages()) {
+        assert(m != nullptr);
+        if (!m->isReferenced()) {
+            continue;
+        }
+
+        addDeclInternal(comms::scopeFor(*m, gen), "template <typename TMsgBase, typename TOpt>\nclass", decls);
+    }
+
+    for (auto* f : gen.getAllFrames()) {
+        assert(f != nullptr);
+        addDeclInternal(comms::scopeFor(*f, gen), "template <typename TMessage, typename TAllMessages, typename TOpt>\nclass", decls);
+    }
+
+    static const std::string Templ = 
+        "#^#GENERATED#$#\n"
+        "/// @file\n"
+        "/// @brief Contains forward declarations of the protocol definition classes.\n"
+        "/// @details Allows referencing the classes without including their full\n"
+        "///     definitions. Default template arguments are specified by the\n"
+        "///     definitions only, so all the template parameters must be provided.\n\n"
+        "#pragma once\n\n"
+        "#^#DECLS#$#\n"
+        "#^#APPEND#$#\n";
+
+    util::ReplacementMap repl = {
+        {"GENERATED", CommsGenerator::commsFileGeneratedComment()},
+        {"DECLS", declsCodeInternal(decls)},
+        {"APPEND", util::readFileContents(comms::inputCodePathForRoot(FwdStr, gen))},
+    };
+
+    auto filePath = comms::headerPathRoot(FwdStr, gen);
+    gen.logger().info("Generating " + filePath);
+    std::ofstream stream(filePath);
+    if (!stream) {
+        gen.logger().error("Failed to open \"" + filePath + "\" for writing.");
+        return false;
+    }
+
+    stream << util::processTemplate(Templ, repl, true);
+    stream.flush();
+    if (!stream.good()) {
+        gen.logger().error("Failed to write \"" + filePath + "\".");
+        return false;
+    }
+
+    return true;
+}
+
+} // namespace commsdsl2comms
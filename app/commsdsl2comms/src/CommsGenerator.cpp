@@ -17,22 +17,27 @@
 
 #include "CommsBitfieldField.h"
 #include "CommsBundleField.h"
+#include "CommsChecksumBench.h"
 #include "CommsChecksumLayer.h"
 #include "CommsCmake.h"
+#include "CommsColumnar.h"
 #include "CommsCustomLayer.h"
 #include "CommsDataField.h"
 #include "CommsDefaultOptions.h"
 #include "CommsDispatch.h"
 #include "CommsDoxygen.h"
 #include "CommsEnumField.h"
+#include "CommsExplicitInstantiation.h"
 #include "CommsFieldBase.h"
 #include "CommsFloatField.h"
 #include "CommsFrame.h"
+#include "CommsFwd.h"
 #include "CommsInputMessages.h"
 #include "CommsIntField.h"
 #include "CommsListField.h"
 #include "CommsIdLayer.h"
 #include "CommsInterface.h"
+#include "CommsJson.h"
 #include "CommsMessage.h"
 #include "CommsMsgFactory.h"
 #include "CommsMsgId.h"
@@ -47,6 +52,7 @@
 #include "CommsStringField.h"
 #include "CommsValueLayer.h"
 #include "CommsVariantField.h"
+#include "CommsVarintBench.h"
 #include "CommsVersion.h"
 
 #include "commsdsl/version.h"
@@ -291,10 +297,12 @@ bool CommsGenerator::writeImpl()
             CommsMsgId::write(*this) &&
             CommsFieldBase::write(*this) &&
             CommsVersion::write(*this) &&
+            CommsFwd::write(*this) &&
             CommsInputMessages::write(*this) &&
             CommsDefaultOptions::write(*this) &&
             CommsDispatch::write(*this) &&
-            CommsMsgFactory::write(*this);
+            CommsMsgFactory::write(*this) &&
+            CommsChecksumLayer::commsWriteCrcCalcs(*this);
 
         if (!result) {
             return false;
@@ -305,6 +313,11 @@ bool CommsGenerator::writeImpl()
     return 
         CommsCmake::write(*this) &&
         CommsDoxygen::write(*this) &&
+        CommsExplicitInstantiation::write(*this) &&
+        CommsJson::write(*this) &&
+        CommsColumnar::write(*this) &&
+        CommsVarintBench::write(*this) &&
+        CommsChecksumBench::write(*this) &&
         commsWriteExtraFilesInternal();
 }
 
@@ -71,79 +71,9 @@ CommsIntField::CommsIntField(
 {
 }
 
-std::string CommsIntField::commsVariantPropKeyType() const
+std::string CommsIntField::commsVariantPropKeyType(const StringsList& customOpts) const
 {
-    return commsDefBaseClassInternal(true);
-}
-
-std::string CommsIntField::commsVariantPropKeyValueStr() const
-{
-    auto obj = intDslObj();
-    if (!isUnsignedType()) {
-        return util::numToString(obj.defaultValue());
-    }
-
-    unsigned hexWidth = static_cast<unsigned>(obj.maxLength() * 2U);
-    auto val = static_cast<std::uintmax_t>(obj.defaultValue());
-    auto decValue = util::numToString(val);
-    auto hexValue = util::numToString(val, hexWidth);
-
-    static const std::string Templ = 
-        "#^#DEC#$# /* #^#HEX#$# */";
-
-    util::ReplacementMap repl = {
-        {"DEC", std::move(decValue)},
-        {"HEX", std::move(hexValue)},
-    };
-    return util::processTemplate(Templ, repl);
-}
-
-bool CommsIntField::commsVariantIsValidPropKey() const
-{
-    auto obj = intDslObj();
-    if (!obj.isFailOnInvalid()) {
-        return false;
-    }
-
-    if (obj.isPseudo()) {
-        return false;
-    }
-
-    auto& validRanges = obj.validRanges();
-    if (validRanges.size() != 1U) {
-        return false;
-    }
-
-    auto& r = validRanges.front();
-    if (r.m_min != r.m_max) {
-        return false;
-    }
-
-    if (r.m_min != obj.defaultValue()) {
-        return false;
-    }
-
-    return true;
-}
-
-bool CommsIntField::commsVariantIsPropKeyEquivalent(const CommsIntField& other) const
-{
-    auto thisDslObj = intDslObj();
-    auto otherDslObj = other.intDslObj();
-
-    auto thisType = comms::cppIntTypeFor(thisDslObj.type(), thisDslObj.maxLength());
-    auto otherType = comms::cppIntTypeFor(otherDslObj.type(), otherDslObj.maxLength());
-    if (thisType != otherType) {
-        return false;
-    }
-
-    auto thisOpts = commsDefFieldOptsInternal(true);
-    auto otherOpts = other.commsDefFieldOptsInternal(true);
-    if (thisOpts != otherOpts) {
-        return false;
-    }
-
-    return thisDslObj.endian() == otherDslObj.endian();
+    return commsDefBaseClassInternal(true, customOpts);
 }
 
 bool CommsIntField::prepareImpl()
@@ -166,6 +96,7 @@ CommsIntField::IncludesList CommsIntField::commsCommonIncludesImpl() const
     if (!specials.empty()) {
         list.insert(list.end(),
             {
+                "<cstring>",
                 "<type_traits>", 
                 "<utility>"
             });
@@ -184,7 +115,8 @@ std::string CommsIntField::commsCommonCodeBodyImpl() const
         "#^#NAME_FUNC#$#\n"
         "#^#HAS_SPECIAL_FUNC#$#\n"
         "#^#SPECIALS#$#\n"
-        "#^#SPECIAL_NAMES_MAP#$#\n"   
+        "#^#SPECIAL_NAMES_MAP#$#\n"
+        "#^#SPECIAL_FROM_NAME#$#\n"
     ;
 
     //auto& specials = specialsSortedByValue();
@@ -199,6 +131,7 @@ std::string CommsIntField::commsCommonCodeBodyImpl() const
         {"HAS_SPECIAL_FUNC", commsCommonHasSpecialsFuncCodeInternal()},
         {"SPECIALS", commsCommonSpecialsCodeInternal()},
         {"SPECIAL_NAMES_MAP", commsCommonSpecialNamesMapCodeInternal()},
+        {"SPECIAL_FROM_NAME", commsCommonSpecialValueFromNameCodeInternal()},
     };
     return util::processTemplate(Templ, repl);
 }
@@ -210,6 +143,12 @@ CommsIntField::IncludesList CommsIntField::commsDefIncludesImpl() const
         "comms/field/IntValue.h"
     };
 
+    if (commsHasFixedPointInternal()) {
+        list.push_back("<limits>");
+        list.push_back("<ratio>");
+        list.push_back("<type_traits>");
+    }
+
     return list;
 }
 
@@ -227,6 +166,7 @@ std::string CommsIntField::commsDefPublicCodeImpl() const
         "#^#HAS_SPECIALS#$#\n"
         "#^#SPECIALS#$#\n"
         "#^#SPECIAL_NAMES_MAP#$#\n"
+        "#^#SPECIAL_FROM_NAME#$#\n"
         "#^#DISPLAY_DECIMALS#$#\n";
 
     util::ReplacementMap repl = {
@@ -234,12 +174,23 @@ std::string CommsIntField::commsDefPublicCodeImpl() const
         {"HAS_SPECIALS", commsDefHasSpecialsFuncCodeInternal()},
         {"SPECIALS", commsDefSpecialsCodeInternal()},
         {"SPECIAL_NAMES_MAP", commsDefSpecialNamesMapCodeInternal()},
+        {"SPECIAL_FROM_NAME", commsDefSpecialValueFromNameCodeInternal()},
         {"DISPLAY_DECIMALS", commsDefDisplayDecimalsCodeInternal()},
     };
+
+    auto fixedPoint = commsDefFixedPointCodeInternal();
+    if (!fixedPoint.empty()) {
+        repl["DISPLAY_DECIMALS"] += "\n\n" + fixedPoint;
+    }
     
     return util::processTemplate(Templ, repl);
 }
 
+std::string CommsIntField::commsDefPrivateCodeImpl() const
+{
+    return commsDefFixedPointPrivateCodeInternal();
+}
+
 std::string CommsIntField::commsDefRefreshFuncBodyImpl() const
 {
     if (!commsRequiresFailOnInvalidRefreshInternal()) {
@@ -326,11 +277,11 @@ std::string CommsIntField::commsDefValidFuncBodyImpl() const
 
         util::StringsList conds;
         if (0U < r.m_sinceVersion) {
-            conds.push_back('(' + util::numToString(r.m_sinceVersion) + " <= Base::getVersion())");
+            conds.push_back('(' + util::numToString(r.m_sinceVersion) + " <= " + commsDefVersionAccessStr() + ')');
         }
 
         if (r.m_deprecatedSince < commsdsl::parse::Protocol::notYetDeprecated()) {
-            conds.push_back("(Base::getVersion() < " + util::numToString(r.m_deprecatedSince) + ")");
+            conds.push_back('(' + commsDefVersionAccessStr() + " < " + util::numToString(r.m_deprecatedSince) + ')');
         }
 
         if (r.m_min == r.m_max) {
@@ -587,11 +538,50 @@ std::string CommsIntField::commsCommonSpecialNamesMapCodeInternal() const
     return util::processTemplate(Templ, repl);
 }
 
-std::string CommsIntField::commsDefFieldOptsInternal(bool variantPropKey) const
+std::string CommsIntField::commsCommonSpecialValueFromNameCodeInternal() const
+{
+    auto& specials = specialsSortedByValue();
+    if (specials.empty()) {
+        return strings::emptyString();
+    }
+
+    NameLookupList names;
+    names.reserve(specials.size() * 2U);
+    auto& gen = generator();
+    for (auto& s : specials) {
+        if (!gen.doesElementExist(s.second.m_sinceVersion, s.second.m_deprecatedSince, true)) {
+            continue;
+        }
+
+        commsAddNameLookupElem(names, s.first, "value" + comms::className(s.first) + "()");
+    }
+
+    for (auto& s : specials) {
+        if (!gen.doesElementExist(s.second.m_sinceVersion, s.second.m_deprecatedSince, true)) {
+            continue;
+        }
+
+        commsAddNameLookupElem(names, s.second.m_displayName, "value" + comms::className(s.first) + "()");
+    }
+
+    return 
+        commsNameLookupFuncCode(
+            names, "specialValueFromName", "ValueType",
+            "special value",
+            "special value", "value");
+}
+
+std::string CommsIntField::commsDefFieldOptsInternal(bool variantPropKey, const StringsList& customOpts) const
 {
     util::StringsList opts;
 
-    commsAddFieldDefOptions(opts);
+    if (!variantPropKey) {
+        commsAddFieldDefOptions(opts);
+    }
+    else {
+        opts = customOpts;
+    }
+
     commsAddLengthOptInternal(opts);
     commsAddSerOffsetOptInternal(opts);
     commsAddScalingOptInternal(opts);
@@ -697,6 +687,28 @@ std::string CommsIntField::commsDefSpecialNamesMapCodeInternal() const
     return util::processTemplate(Templ, repl);    
 }
 
+std::string CommsIntField::commsDefSpecialValueFromNameCodeInternal() const
+{
+    auto& specials = specialsSortedByValue();
+    if (specials.empty()) {
+        return strings::emptyString();
+    }
+
+    static const std::string Templ = 
+        "/// @brief Retrieve special value by its name.\n"
+        "/// @see @ref #^#COMMON#$#::specialValueFromName().\n"
+        "static std::pair<ValueType, bool> specialValueFromName(const char* name, std::size_t len)\n"
+        "{\n"
+        "    return #^#COMMON#$#::specialValueFromName(name, len);\n"
+        "}\n";    
+
+    util::ReplacementMap repl {
+        {"COMMON", comms::commonScopeFor(*this, generator())}
+    };
+
+    return util::processTemplate(Templ, repl);    
+}
+
 std::string CommsIntField::commsDefDisplayDecimalsCodeInternal() const
 {
     auto obj = intDslObj();
@@ -721,7 +733,181 @@ std::string CommsIntField::commsDefDisplayDecimalsCodeInternal() const
     return util::processTemplate(Templ, repl);
 }
 
-std::string CommsIntField::commsDefBaseClassInternal(bool variantPropKey) const
+std::string CommsIntField::commsDefFixedPointCodeInternal() const
+{
+    if (!commsHasFixedPointInternal()) {
+        return strings::emptyString();
+    }
+
+    static const std::string Templ = 
+        "/// @brief Scaling ratio of the value, reduced at compile time.\n"
+        "using FixedPointRatio = std::ratio<#^#NUM#$#, #^#DENOM#$#>;\n\n"
+        "/// @brief Get the scaled value as fixed-point integer.\n"
+        "/// @details Integer only alternative to @b getScaled(). The returned\n"
+        "///     value is the scaled one multiplied by 10^TPrecision and rounded\n"
+        "///     to the nearest integer (half away from zero). The value which\n"
+        "///     doesn't fit into @b TRet is saturated to its limits.\n"
+        "/// @tparam TPrecision Number of decimal digits after the point, up to 18.\n"
+        "/// @tparam TRet Integral type of the returned value.\n"
+        "template <unsigned TPrecision = #^#DISPLAY_DECIMALS#$#, typename TRet = #^#CALC_TYPE#$#>\n"
+        "TRet getFixedPoint() const\n"
+        "{\n"
+        "    static_assert(TPrecision <= FixedPointMaxPrecision, \"The precision is too big\");\n"
+        "    using Ratio = std::ratio_multiply<FixedPointRatio, std::ratio<fixedPointPow10Internal(TPrecision)> >;\n"
+        "    auto value = static_cast<#^#CALC_TYPE#$#>(Base::getValue());\n"
+        "    if (fixedPointMulInternal(value, Ratio::num)) {\n"
+        "        value = fixedPointDivInternal(value, Ratio::den);\n"
+        "    }\n"
+        "    return fixedPointClampInternal<TRet>(value);\n"
+        "}\n\n"
+        "/// @brief Set the scaled value from fixed-point integer.\n"
+        "/// @details Integer only alternative to @b setScaled(). The stored\n"
+        "///     value is rounded to the nearest integer (half away from zero).\n"
+        "///     The value which doesn't fit into @b ValueType#^#NEGATIVE_DOC#$#\n"
+        "///     is saturated to its limits.\n"
+        "/// @tparam TPrecision Number of decimal digits after the point in the provided value, up to 18.\n"
+        "/// @param[in] fixedPointValue Scaled value multiplied by 10^TPrecision.\n"
+        "template <unsigned TPrecision = #^#DISPLAY_DECIMALS#$#, typename TVal>\n"
+        "void setFixedPoint(TVal fixedPointValue)\n"
+        "{\n"
+        "    static_assert(TPrecision <= FixedPointMaxPrecision, \"The precision is too big\");\n"
+        "    using Ratio = std::ratio_multiply<FixedPointRatio, std::ratio<fixedPointPow10Internal(TPrecision)> >;\n"
+        "    auto value = fixedPointClampInternal<#^#CALC_TYPE#$#>(fixedPointValue);\n"
+        "    if (fixedPointMulInternal(value, Ratio::den)) {\n"
+        "        value = fixedPointDivInternal(value, Ratio::num);\n"
+        "    }\n"
+        "    Base::setValue(fixedPointClampInternal<ValueType>(value));\n"
+        "}";
+
+    auto obj = intDslObj();
+    auto scaling = obj.scaling();
+    bool unsignedType = isUnsignedType();
+    util::ReplacementMap repl = {
+        {"NUM", util::numToString(scaling.first)},
+        {"DENOM", util::numToString(scaling.second)},
+        {"DISPLAY_DECIMALS", util::numToString(obj.displayDecimals())},
+        {"CALC_TYPE", unsignedType ? "std::uintmax_t" : "std::intmax_t"},
+    };
+
+    if (unsignedType) {
+        repl["NEGATIVE_DOC"] = " (including negative one)";
+    }
+
+    return util::processTemplate(Templ, repl);
+}
+
+std::string CommsIntField::commsDefFixedPointPrivateCodeInternal() const
+{
+    if (!commsHasFixedPointInternal()) {
+        return strings::emptyString();
+    }
+
+    static const std::string Templ = 
+        "static const unsigned FixedPointMaxPrecision = 18U;\n\n"
+        "static constexpr std::intmax_t fixedPointPow10Internal(unsigned exp)\n"
+        "{\n"
+        "    return (exp == 0U) ? 1 : (10 * fixedPointPow10Internal(exp - 1U));\n"
+        "}\n\n"
+        "// Returns false and saturates the value on overflow\n"
+        "static bool fixedPointMulInternal(#^#CALC_TYPE#$#& value, std::intmax_t factor)\n"
+        "{\n"
+        "    #^#MUL_BODY#$#\n"
+        "}\n\n"
+        "static #^#CALC_TYPE#$# fixedPointDivInternal(#^#CALC_TYPE#$# value, std::intmax_t divisor)\n"
+        "{\n"
+        "    #^#DIV_BODY#$#\n"
+        "}\n\n"
+        "template <typename TTo, typename TFrom>\n"
+        "static TTo fixedPointClampInternal(TFrom value)\n"
+        "{\n"
+        "    static_assert(std::is_integral<TFrom>::value && std::is_integral<TTo>::value, \"Integral types are expected\");\n"
+        "    using ToLimits = std::numeric_limits<TTo>;\n"
+        "    if (fixedPointIsNegativeInternal(value, std::is_signed<TFrom>())) {\n"
+        "        if ((!ToLimits::is_signed) || (static_cast<std::intmax_t>(value) < static_cast<std::intmax_t>(ToLimits::min()))) {\n"
+        "            return ToLimits::min();\n"
+        "        }\n\n"
+        "        return static_cast<TTo>(value);\n"
+        "    }\n\n"
+        "    if (static_cast<std::uintmax_t>(ToLimits::max()) < static_cast<std::uintmax_t>(value)) {\n"
+        "        return ToLimits::max();\n"
+        "    }\n\n"
+        "    return static_cast<TTo>(value);\n"
+        "}\n\n"
+        "template <typename T>\n"
+        "static bool fixedPointIsNegativeInternal(T value, std::true_type)\n"
+        "{\n"
+        "    return value < 0;\n"
+        "}\n\n"
+        "template <typename T>\n"
+        "static bool fixedPointIsNegativeInternal(T, std::false_type)\n"
+        "{\n"
+        "    return false;\n"
+        "}\n";
+
+    // The ratio is positive for the unsigned fields
+    static const std::string UnsignedMulBody = 
+        "auto unsignedFactor = static_cast<std::uintmax_t>(factor);\n"
+        "if ((std::numeric_limits<std::uintmax_t>::max() / unsignedFactor) < value) {\n"
+        "    value = std::numeric_limits<std::uintmax_t>::max();\n"
+        "    return false;\n"
+        "}\n\n"
+        "value *= unsignedFactor;\n"
+        "return true;";
+
+    static const std::string UnsignedDivBody = 
+        "auto unsignedDivisor = static_cast<std::uintmax_t>(divisor);\n"
+        "auto quotient = value / unsignedDivisor;\n"
+        "auto remainder = value % unsignedDivisor;\n"
+        "if (remainder < (unsignedDivisor - remainder)) {\n"
+        "    return quotient;\n"
+        "}\n\n"
+        "return quotient + 1U;";
+
+    // The std::ratio members are never equal to the minimal intmax_t value
+    static const std::string SignedMulBody = 
+        "static const auto Max = std::numeric_limits<std::intmax_t>::max();\n"
+        "static const auto Min = std::numeric_limits<std::intmax_t>::min();\n"
+        "bool overflow = false;\n"
+        "if (0 < factor) {\n"
+        "    overflow = ((Max / factor) < value) || (value < (Min / factor));\n"
+        "}\n"
+        "else if (0 < value) {\n"
+        "    overflow = (factor < (Min / value));\n"
+        "}\n"
+        "else {\n"
+        "    overflow = (value < (Max / factor));\n"
+        "}\n\n"
+        "if (overflow) {\n"
+        "    value = ((value < 0) == (factor < 0)) ? Max : Min;\n"
+        "    return false;\n"
+        "}\n\n"
+        "value *= factor;\n"
+        "return true;";
+
+    static const std::string SignedDivBody = 
+        "if (divisor == -1) {\n"
+        "    return (value == std::numeric_limits<std::intmax_t>::min()) ? std::numeric_limits<std::intmax_t>::max() : -value;\n"
+        "}\n\n"
+        "auto quotient = value / divisor;\n"
+        "auto remainder = value % divisor;\n"
+        "auto absRemainder = (remainder < 0) ? -remainder : remainder;\n"
+        "auto absDivisor = (divisor < 0) ? -divisor : divisor;\n"
+        "if (absRemainder < (absDivisor - absRemainder)) {\n"
+        "    return quotient;\n"
+        "}\n\n"
+        "return ((value < 0) == (divisor < 0)) ? (quotient + 1) : (quotient - 1);";
+
+    bool unsignedType = isUnsignedType();
+    util::ReplacementMap repl = {
+        {"CALC_TYPE", unsignedType ? "std::uintmax_t" : "std::intmax_t"},
+        {"MUL_BODY", unsignedType ? UnsignedMulBody : SignedMulBody},
+        {"DIV_BODY", unsignedType ? UnsignedDivBody : SignedDivBody},
+    };
+
+    return util::processTemplate(Templ, repl);
+}
+
+std::string CommsIntField::commsDefBaseClassInternal(bool variantPropKey, const StringsList& customOpts) const
 {
     static const std::string Templ = 
         "comms::field::IntValue<\n"
@@ -736,7 +922,7 @@ std::string CommsIntField::commsDefBaseClassInternal(bool variantPropKey) const
         {"PROT_NAMESPACE", gen.schemaOf(*this).mainNamespace()},
         {"FIELD_BASE_PARAMS", commsFieldBaseParams(dslObj.endian())},
         {"FIELD_TYPE", comms::cppIntTypeFor(dslObj.type(), dslObj.maxLength())},
-        {"FIELD_OPTS", commsDefFieldOptsInternal(variantPropKey)}
+        {"FIELD_OPTS", commsDefFieldOptsInternal(variantPropKey, customOpts)}
     };
 
     if (!repl["FIELD_OPTS"].empty()) {
@@ -1070,6 +1256,20 @@ void CommsIntField::commsAddAvailableLengthLimitOptInternal(StringsList& opts) c
     }
 }
 
+bool CommsIntField::commsHasFixedPointInternal() const
+{
+    auto scaling = intDslObj().scaling();
+    if ((scaling.first == scaling.second) || (scaling.first == 0) || (scaling.second == 0)) {
+        return false;
+    }
+
+    if (isUnsignedType()) {
+        return (0 < scaling.first) && (0 < scaling.second);
+    }
+
+    return true;
+}
+
 bool CommsIntField::commsRequiresFailOnInvalidRefreshInternal() const
 {
     if (!dslObj().isFailOnInvalid()) {
@@ -30,10 +30,7 @@ class CommsIntField final : public commsdsl::gen::IntField, public CommsField
 public:
     CommsIntField(CommsGenerator& generator, commsdsl::parse::Field dslObj, commsdsl::gen::Elem* parent);
 
-    std::string commsVariantPropKeyType() const;
-    std::string commsVariantPropKeyValueStr() const;
-    bool commsVariantIsValidPropKey() const;
-    bool commsVariantIsPropKeyEquivalent(const CommsIntField& other) const;
+    std::string commsVariantPropKeyType(const StringsList& customOpts) const;
 
 protected:
     // Base overrides
@@ -46,6 +43,7 @@ protected:
     virtual IncludesList commsDefIncludesImpl() const override;
     virtual std::string commsDefBaseClassImpl() const override;
     virtual std::string commsDefPublicCodeImpl() const override;
+    virtual std::string commsDefPrivateCodeImpl() const override;
     virtual std::string commsDefRefreshFuncBodyImpl() const override;
     virtual std::string commsDefValidFuncBodyImpl() const override;
     virtual bool commsIsVersionDependentImpl() const override;
@@ -58,13 +56,17 @@ private:
     std::string commsCommonValueNamesMapCodeInternal() const;
     std::string commsCommonSpecialsCodeInternal() const;
     std::string commsCommonSpecialNamesMapCodeInternal() const;
-    std::string commsDefFieldOptsInternal(bool variantPropKey = false) const;
+    std::string commsCommonSpecialValueFromNameCodeInternal() const;
+    std::string commsDefFieldOptsInternal(bool variantPropKey = false, const StringsList& customOpts = StringsList()) const;
     std::string commsDefValueNamesMapCodeInternal() const;
     std::string commsDefHasSpecialsFuncCodeInternal() const;
     std::string commsDefSpecialsCodeInternal() const;
     std::string commsDefSpecialNamesMapCodeInternal() const;
+    std::string commsDefSpecialValueFromNameCodeInternal() const;
     std::string commsDefDisplayDecimalsCodeInternal() const;
-    std::string commsDefBaseClassInternal(bool variantPropKey = false) const;
+    std::string commsDefFixedPointCodeInternal() const;
+    std::string commsDefFixedPointPrivateCodeInternal() const;
+    std::string commsDefBaseClassInternal(bool variantPropKey = false, const StringsList& customOpts = StringsList()) const;
 
     void commsAddLengthOptInternal(StringsList& opts) const;
     void commsAddSerOffsetOptInternal(StringsList& opts) const;
@@ -75,6 +77,7 @@ private:
     void commsAddCustomRefreshOptInternal(StringsList& opts) const;
     void commsAddAvailableLengthLimitOptInternal(StringsList& opts) const;
     bool commsRequiresFailOnInvalidRefreshInternal() const;
+    bool commsHasFixedPointInternal() const;
 };
 
 } // namespace commsdsl2comms
@@ -0,0 +1,737 @@
+//
+// Copyright 2019 - 2023 (C). Alex Robenko. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "CommsJson.h"
+
+#include "CommsGenerator.h"
+
+#include "commsdsl/gen/comms.h"
+#include "commsdsl/gen/strings.h"
+#include "commsdsl/gen/util.h"
+
+#include <cassert>
+#include <fstream>
+
+namespace comms = commsdsl::gen::comms;
+namespace strings = commsdsl::gen::strings;
+namespace util = commsdsl::gen::util;
+
+namespace commsdsl2comms
+{
+
+namespace 
+{
+
+const std::string JsonStr("Json");
+const std::string JsonBenchStr("JsonBench");
+
+bool writeFileInternal(
+    const std::string& filePath,
+    CommsGenerator& generator,
+    const std::string& data)
+{
+    generator.logger().info("Generating " + filePath);
+    auto dirPath = util::pathUp(filePath);
+    assert(!dirPath.empty());
+    if (!generator.createDirectory(dirPath)) {
+        return false;
+    }      
+
+    std::ofstream stream(filePath);
+    if (!stream) {
+        generator.logger().error("Failed to open \"" + filePath + "\" for writing.");
+        return false;
+    }    
+
+    stream << data;
+    stream.flush();
+    if (!stream.good()) {
+        generator.logger().error("Failed to write \"" + filePath + "\".");
+        return false;
+    }
+
+    return true;
+}
+
+} // namespace 
+
+bool CommsJson::write(CommsGenerator& generator)
+{
+    CommsJson obj(generator);
+    return obj.commsWriteInternal();
+}
+
+bool CommsJson::commsWriteInternal() const
+{
+    return 
+        commsWriteHeaderInternal() &&
+        commsWriteBenchInternal();
+}
+
+bool CommsJson::commsWriteHeaderInternal() const
+{
+    static const std::string Templ = 
+        "#^#GENERATED#$#\n"
+        "/// @file\n"
+        "/// @brief Contains JSON serialization of the protocol messages and fields.\n"
+        "/// @details Not used by the protocol definition itself and needs to be\n"
+        "///     included explicitly. The serialization doesn't allocate any memory, it streams\n"
+        "///     into the caller provided buffer. The names of the fields, enum values,\n"
+        "///     special values, and bits are taken from the generated definitions.\n"
+        "///     Every message is serialized as a single JSON object, which allows\n"
+        "///     producing NDJSON (newline delimited JSON) output.\n\n"
+        "#pragma once\n\n"
+        "#include <cmath>\n"
+        "#include <cstddef>\n"
+        "#include <cstdint>\n"
+        "#include <cstdio>\n"
+        "#include <cstring>\n"
+        "#include <type_traits>\n\n"
+        "#include \"comms/MessageBase.h\"\n"
+        "#include \"comms/fields.h\"\n"
+        "#include \"comms/util/Tuple.h\"\n\n"
+        "namespace #^#PROT_NAMESPACE#$#\n"
+        "{\n\n"
+        "namespace json\n"
+        "{\n\n"
+        "/// @brief JSON writer into the caller provided buffer.\n"
+        "/// @details When the buffer capacity is exceeded the @ref overflow() flag is\n"
+        "///     set and the rest of the output is discarded.\n"
+        "class Writer\n"
+        "{\n"
+        "public:\n"
+        "    /// @brief Constructor\n"
+        "    /// @param[in] buf Output buffer, not owned by the writer\n"
+        "    /// @param[in] capacity Capacity of the output buffer\n"
+        "    Writer(char* buf, std::size_t capacity) :\n"
+        "        m_buf(buf),\n"
+        "        m_capacity(capacity)\n"
+        "    {\n"
+        "    }\n\n"
+        "    /// @brief Access to the written data, not null terminated.\n"
+        "    const char* data() const\n"
+        "    {\n"
+        "        return m_buf;\n"
+        "    }\n\n"
+        "    /// @brief Amount of the written bytes.\n"
+        "    std::size_t size() const\n"
+        "    {\n"
+        "        return m_size;\n"
+        "    }\n\n"
+        "    /// @brief Check whether the output buffer capacity was exceeded.\n"
+        "    bool overflow() const\n"
+        "    {\n"
+        "        return m_overflow;\n"
+        "    }\n\n"
+        "    /// @brief Discard all the written data to reuse the buffer.\n"
+        "    void clear()\n"
+        "    {\n"
+        "        m_size = 0U;\n"
+        "        m_overflow = false;\n"
+        "        m_comma = false;\n"
+        "    }\n\n"
+        "    /// @brief Terminate the NDJSON record.\n"
+        "    void endRecord()\n"
+        "    {\n"
+        "        put('\\n');\n"
+        "        m_comma = false;\n"
+        "    }\n\n"
+        "    /// @brief Start JSON object.\n"
+        "    void beginObject()\n"
+        "    {\n"
+        "        separate();\n"
+        "        put('{');\n"
+        "        m_comma = false;\n"
+        "    }\n\n"
+        "    /// @brief Finish JSON object.\n"
+        "    void endObject()\n"
+        "    {\n"
+        "        put('}');\n"
+        "        m_comma = true;\n"
+        "    }\n\n"
+        "    /// @brief Start JSON array.\n"
+        "    void beginArray()\n"
+        "    {\n"
+        "        separate();\n"
+        "        put('[');\n"
+        "        m_comma = false;\n"
+        "    }\n\n"
+        "    /// @brief Finish JSON array.\n"
+        "    void endArray()\n"
+        "    {\n"
+        "        put(']');\n"
+        "        m_comma = true;\n"
+        "    }\n\n"
+        "    /// @brief Write key of the object member.\n"
+        "    void key(const char* str)\n"
+        "    {\n"
+        "        separate();\n"
+        "        putString(str, std::strlen(str));\n"
+        "        put(':');\n"
+        "        m_comma = false;\n"
+        "    }\n\n"
+        "    /// @brief Write @b null value.\n"
+        "    void valueNull()\n"
+        "    {\n"
+        "        separate();\n"
+        "        append(\"null\", 4U);\n"
+        "        m_comma = true;\n"
+        "    }\n\n"
+        "    /// @brief Write boolean value.\n"
+        "    void valueBool(bool value)\n"
+        "    {\n"
+        "        separate();\n"
+        "        if (value) {\n"
+        "            append(\"true\", 4U);\n"
+        "        }\n"
+        "        else {\n"
+        "            append(\"false\", 5U);\n"
+        "        }\n"
+        "        m_comma = true;\n"
+        "    }\n\n"
+        "    /// @brief Write string value, escaped when needed.\n"
+        "    void valueString(const char* str, std::size_t len)\n"
+        "    {\n"
+        "        separate();\n"
+        "        putString(str, len);\n"
+        "        m_comma = true;\n"
+        "    }\n\n"
+        "    /// @brief Write null terminated string value, escaped when needed.\n"
+        "    void valueString(const char* str)\n"
+        "    {\n"
+        "        valueString(str, std::strlen(str));\n"
+        "    }\n\n"
+        "    /// @brief Write unsigned integral value.\n"
+        "    void valueUnsigned(std::uintmax_t value)\n"
+        "    {\n"
+        "        separate();\n"
+        "        putUnsigned(value);\n"
+        "        m_comma = true;\n"
+        "    }\n\n"
+        "    /// @brief Write signed integral value.\n"
+        "    void valueSigned(std::intmax_t value)\n"
+        "    {\n"
+        "        separate();\n"
+        "        if (value < 0) {\n"
+        "            put('-');\n"
+        "            putUnsigned(static_cast<std::uintmax_t>(-(value + 1)) + 1U);\n"
+        "        }\n"
+        "        else {\n"
+        "            putUnsigned(static_cast<std::uintmax_t>(value));\n"
+        "        }\n"
+        "        m_comma = true;\n"
+        "    }\n\n"
+        "    /// @brief Write integral value of any type.\n"
+        "    template <typename T>\n"
+        "    void valueInt(T value)\n"
+        "    {\n"
+        "        using Tag = \n"
+        "            typename std::conditional<\n"
+        "                std::is_signed<T>::value,\n"
+        "                SignedTag,\n"
+        "                UnsignedTag\n"
+        "            >::type;\n\n"
+        "        valueIntInternal(value, Tag());\n"
+        "    }\n\n"
+        "    /// @brief Write floating point value, @b null for NaN and infinite values.\n"
+        "    void valueFloat(double value)\n"
+        "    {\n"
+        "        if (std::isnan(value) || std::isinf(value)) {\n"
+        "            valueNull();\n"
+        "            return;\n"
+        "        }\n\n"
+        "        separate();\n"
+        "        char str[32] = {0};\n"
+        "        auto len = std::snprintf(str, sizeof(str), \"%.17g\", value);\n"
+        "        if (0 < len) {\n"
+        "            append(str, static_cast<std::size_t>(len));\n"
+        "        }\n"
+        "        m_comma = true;\n"
+        "    }\n\n"
+        "    /// @brief Write raw bytes as hexadecimal string.\n"
+        "    template <typename TIter>\n"
+        "    void valueHex(TIter begin, TIter end)\n"
+        "    {\n"
+        "        static const char Digits[] = \"0123456789abcdef\";\n"
+        "        separate();\n"
+        "        put('\"');\n"
+        "        for (auto iter = begin; iter != end; ++iter) {\n"
+        "            auto byte = static_cast<std::uint8_t>(*iter);\n"
+        "            put(Digits[byte >> 4U]);\n"
+        "            put(Digits[byte & 0xfU]);\n"
+        "        }\n"
+        "        put('\"');\n"
+        "        m_comma = true;\n"
+        "    }\n\n"
+        "private:\n"
+        "    struct SignedTag {};\n"
+        "    struct UnsignedTag {};\n\n"
+        "    template <typename T>\n"
+        "    void valueIntInternal(T value, SignedTag)\n"
+        "    {\n"
+        "        valueSigned(static_cast<std::intmax_t>(value));\n"
+        "    }\n\n"
+        "    template <typename T>\n"
+        "    void valueIntInternal(T value, UnsignedTag)\n"
+        "    {\n"
+        "        valueUnsigned(static_cast<std::uintmax_t>(value));\n"
+        "    }\n\n"
+        "    void separate()\n"
+        "    {\n"
+        "        if (m_comma) {\n"
+        "            put(',');\n"
+        "        }\n"
+        "    }\n\n"
+        "    void put(char ch)\n"
+        "    {\n"
+        "        if ((m_overflow) || (m_capacity <= m_size)) {\n"
+        "            m_overflow = true;\n"
+        "            return;\n"
+        "        }\n\n"
+        "        m_buf[m_size] = ch;\n"
+        "        ++m_size;\n"
+        "    }\n\n"
+        "    void append(const char* str, std::size_t len)\n"
+        "    {\n"
+        "        if ((m_overflow) || ((m_capacity - m_size) < len)) {\n"
+        "            m_overflow = true;\n"
+        "            return;\n"
+        "        }\n\n"
+        "        std::memcpy(&m_buf[m_size], str, len);\n"
+        "        m_size += len;\n"
+        "    }\n\n"
+        "    void putUnsigned(std::uintmax_t value)\n"
+        "    {\n"
+        "        char str[24];\n"
+        "        auto pos = sizeof(str);\n"
+        "        do {\n"
+        "            --pos;\n"
+        "            str[pos] = static_cast<char>('0' + static_cast<int>(value % 10U));\n"
+        "            value /= 10U;\n"
+        "        } while (value != 0U);\n\n"
+        "        append(&str[pos], sizeof(str) - pos);\n"
+        "    }\n\n"
+        "    void putString(const char* str, std::size_t len)\n"
+        "    {\n"
+        "        static const char Digits[] = \"0123456789abcdef\";\n"
+        "        put('\"');\n"
+        "        std::size_t begin = 0U;\n"
+        "        for (std::size_t idx = 0U; idx < len; ++idx) {\n"
+        "            auto ch = static_cast<unsigned char>(str[idx]);\n"
+        "            if ((0x20 <= ch) && (ch != '\"') && (ch != '\\\\')) {\n"
+        "                continue;\n"
+        "            }\n\n"
+        "            append(&str[begin], idx - begin);\n"
+        "            begin = idx + 1U;\n"
+        "            put('\\\\');\n"
+        "            switch (ch) {\n"
+        "                case '\"': put('\"'); break;\n"
+        "                case '\\\\': put('\\\\'); break;\n"
+        "                case '\\n': put('n'); break;\n"
+        "                case '\\r': put('r'); break;\n"
+        "                case '\\t': put('t'); break;\n"
+        "                default:\n"
+        "                    append(\"u00\", 3U);\n"
+        "                    put(Digits[ch >> 4U]);\n"
+        "                    put(Digits[ch & 0xfU]);\n"
+        "                    break;\n"
+        "            }\n"
+        "        }\n\n"
+        "        append(&str[begin], len - begin);\n"
+        "        put('\"');\n"
+        "    }\n\n"
+        "    char* m_buf = nullptr;\n"
+        "    std::size_t m_capacity = 0U;\n"
+        "    std::size_t m_size = 0U;\n"
+        "    bool m_overflow = false;\n"
+        "    bool m_comma = false;\n"
+        "};\n\n"
+        "namespace details\n"
+        "{\n\n"
+        "template <typename TField>\n"
+        "class HasSpecialNamesMap\n"
+        "{\n"
+        "    template <typename T>\n"
+        "    static auto test(int) -> decltype(T::specialNamesMap(), std::true_type());\n\n"
+        "    template <typename>\n"
+        "    static std::false_type test(...);\n\n"
+        "public:\n"
+        "    static const bool Value = decltype(test<TField>(0))::value;\n"
+        "};\n\n"
+        "class FieldWriter\n"
+        "{\n"
+        "public:\n"
+        "    explicit FieldWriter(Writer& writer) : m_writer(writer) {}\n\n"
+        "    // Writes the member field as \"name\":value\n"
+        "    template <typename TField>\n"
+        "    void operator()(const TField& field) const\n"
+        "    {\n"
+        "        m_writer.key(field.name());\n"
+        "        writeValue(field);\n"
+        "    }\n\n"
+        "    // Writes the variant member field as \"name\":value\n"
+        "    template <std::size_t TIdx, typename TField>\n"
+        "    void operator()(const TField& field) const\n"
+        "    {\n"
+        "        m_writer.key(field.name());\n"
+        "        writeValue(field);\n"
+        "    }\n\n"
+        "    template <typename TField>\n"
+        "    void writeValue(const TField& field) const\n"
+        "    {\n"
+        "        writeValueInternal<TField>(field);\n"
+        "    }\n\n"
+        "private:\n"
+        "    struct SpecialsTag {};\n"
+        "    struct NoSpecialsTag {};\n"
+        "    struct BytesTag {};\n"
+        "    struct IntElementsTag {};\n"
+        "    struct FieldElementsTag {};\n\n"
+        "    template <typename TField, typename TFieldBase, typename T, typename... TOptions>\n"
+        "    void writeValueInternal(const comms::field::IntValue<TFieldBase, T, TOptions...>& field) const\n"
+        "    {\n"
+        "        using Tag = \n"
+        "            typename std::conditional<\n"
+        "                HasSpecialNamesMap<TField>::Value,\n"
+        "                SpecialsTag,\n"
+        "                NoSpecialsTag\n"
+        "            >::type;\n\n"
+        "        writeIntInternal(static_cast<const TField&>(field), Tag());\n"
+        "    }\n\n"
+        "    template <typename TField>\n"
+        "    void writeIntInternal(const TField& field, SpecialsTag) const\n"
+        "    {\n"
+        "        auto namesMap = TField::specialNamesMap();\n"
+        "        for (std::size_t idx = 0U; idx < namesMap.second; ++idx) {\n"
+        "            auto& info = namesMap.first[idx];\n"
+        "            if (info.first == field.value()) {\n"
+        "                m_writer.valueString(info.second);\n"
+        "                return;\n"
+        "            }\n"
+        "        }\n\n"
+        "        m_writer.valueInt(field.value());\n"
+        "    }\n\n"
+        "    template <typename TField>\n"
+        "    void writeIntInternal(const TField& field, NoSpecialsTag) const\n"
+        "    {\n"
+        "        m_writer.valueInt(field.value());\n"
+        "    }\n\n"
+        "    template <typename TField, typename TFieldBase, typename T, typename... TOptions>\n"
+        "    void writeValueInternal(const comms::field::EnumValue<TFieldBase, T, TOptions...>& field) const\n"
+        "    {\n"
+        "        auto& actField = static_cast<const TField&>(field);\n"
+        "        auto* name = actField.valueName(actField.value());\n"
+        "        if (name != nullptr) {\n"
+        "            m_writer.valueString(name);\n"
+        "            return;\n"
+        "        }\n\n"
+        "        using UnderlyingType = typename std::underlying_type<T>::type;\n"
+        "        m_writer.valueInt(static_cast<UnderlyingType>(actField.value()));\n"
+        "    }\n\n"
+        "    template <typename TField, typename TFieldBase, typename... TOptions>\n"
+        "    void writeValueInternal(const comms::field::BitmaskValue<TFieldBase, TOptions...>& field) const\n"
+        "    {\n"
+        "        auto& actField = static_cast<const TField&>(field);\n"
+        "        m_writer.beginObject();\n"
+        "        for (auto idx = 0U; idx < static_cast<unsigned>(TField::BitIdx_numOfValues); ++idx) {\n"
+        "            auto bitIdx = static_cast<typename TField::BitIdx>(idx);\n"
+        "            auto* name = actField.bitName(bitIdx);\n"
+        "            if (name == nullptr) {\n"
+        "                continue;\n"
+        "            }\n\n"
+        "            m_writer.key(name);\n"
+        "            m_writer.valueBool(actField.getBitValue(bitIdx));\n"
+        "        }\n"
+        "        m_writer.endObject();\n"
+        "    }\n\n"
+        "    template <typename TField, typename TFieldBase, typename TMembers, typename... TOptions>\n"
+        "    void writeValueInternal(const comms::field::Bitfield<TFieldBase, TMembers, TOptions...>& field) const\n"
+        "    {\n"
+        "        m_writer.beginObject();\n"
+        "        comms::util::tupleForEach(static_cast<const TField&>(field).value(), FieldWriter(m_writer));\n"
+        "        m_writer.endObject();\n"
+        "    }\n\n"
+        "    template <typename TField, typename TFieldBase, typename TMembers, typename... TOptions>\n"
+        "    void writeValueInternal(const comms::field::Bundle<TFieldBase, TMembers, TOptions...>& field) const\n"
+        "    {\n"
+        "        m_writer.beginObject();\n"
+        "        comms::util::tupleForEach(static_cast<const TField&>(field).value(), FieldWriter(m_writer));\n"
+        "        m_writer.endObject();\n"
+        "    }\n\n"
+        "    template <typename TField, typename TFieldBase, typename T, typename... TOptions>\n"
+        "    void writeValueInternal(const comms::field::FloatValue<TFieldBase, T, TOptions...>& field) const\n"
+        "    {\n"
+        "        m_writer.valueFloat(static_cast<double>(static_cast<const TField&>(field).value()));\n"
+        "    }\n\n"
+        "    template <typename TField, typename TFieldBase, typename... TOptions>\n"
+        "    void writeValueInternal(const comms::field::String<TFieldBase, TOptions...>& field) const\n"
+        "    {\n"
+        "        auto& str = static_cast<const TField&>(field).value();\n"
+        "        m_writer.valueString(str.data(), static_cast<std::size_t>(str.size()));\n"
+        "    }\n\n"
+        "    template <typename TField, typename TFieldBase, typename TElement, typename... TOptions>\n"
+        "    void writeValueInternal(const comms::field::ArrayList<TFieldBase, TElement, TOptions...>& field) const\n"
+        "    {\n"
+        "        using Tag = \n"
+        "            typename std::conditional<\n"
+        "                std::is_integral<TElement>::value,\n"
+        "                typename std::conditional<\n"
+        "                    sizeof(TElement) == 1U,\n"
+        "                    BytesTag,\n"
+        "                    IntElementsTag\n"
+        "                >::type,\n"
+        "                FieldElementsTag\n"
+        "            >::type;\n\n"
+        "        writeListInternal(static_cast<const TField&>(field).value(), Tag());\n"
+        "    }\n\n"
+        "    template <typename TData>\n"
+        "    void writeListInternal(const TData& data, BytesTag) const\n"
+        "    {\n"
+        "        m_writer.valueHex(data.begin(), data.end());\n"
+        "    }\n\n"
+        "    template <typename TData>\n"
+        "    void writeListInternal(const TData& data, IntElementsTag) const\n"
+        "    {\n"
+        "        m_writer.beginArray();\n"
+        "        for (auto& elem : data) {\n"
+        "            m_writer.valueInt(elem);\n"
+        "        }\n"
+        "        m_writer.endArray();\n"
+        "    }\n\n"
+        "    template <typename TData>\n"
+        "    void writeListInternal(const TData& data, FieldElementsTag) const\n"
+        "    {\n"
+        "        m_writer.beginArray();\n"
+        "        for (auto& elem : data) {\n"
+        "            writeValue(elem);\n"
+        "        }\n"
+        "        m_writer.endArray();\n"
+        "    }\n\n"
+        "    template <typename TField, typename TOptField, typename... TOptions>\n"
+        "    void writeValueInternal(const comms::field::Optional<TOptField, TOptions...>& field) const\n"
+        "    {\n"
+        "        auto& actField = static_cast<const TField&>(field);\n"
+        "        if (!actField.doesExist()) {\n"
+        "            m_writer.valueNull();\n"
+        "            return;\n"
+        "        }\n\n"
+        "        writeValue(actField.field());\n"
+        "    }\n\n"
+        "    template <typename TField, typename TFieldBase, typename TMembers, typename... TOptions>\n"
+        "    void writeValueInternal(const comms::field::Variant<TFieldBase, TMembers, TOptions...>& field) const\n"
+        "    {\n"
+        "        auto& actField = static_cast<const TField&>(field);\n"
+        "        if (!actField.currentFieldValid()) {\n"
+        "            m_writer.valueNull();\n"
+        "            return;\n"
+        "        }\n\n"
+        "        m_writer.beginObject();\n"
+        "        actField.currentFieldExec(FieldWriter(m_writer));\n"
+        "        m_writer.endObject();\n"
+        "    }\n\n"
+        "    template <typename TField, typename TFieldBase>\n"
+        "    void writeValueInternal(const comms::field::NoValue<TFieldBase>&) const\n"
+        "    {\n"
+        "        m_writer.valueNull();\n"
+        "    }\n\n"
+        "    Writer& m_writer;\n"
+        "};\n\n"
+        "} // namespace details\n\n"
+        "/// @brief Write value of the field.\n"
+        "/// @details Bundles and bitfields are written as objects of their members,\n"
+        "///     variants as objects with a single currently selected member.\n"
+        "///     Enum and special values are written as names when known, raw data lists\n"
+        "///     as hexadecimal strings, missing optional fields as @b null.\n"
+        "template <typename TField>\n"
+        "void fieldToJson(const TField& field, Writer& writer)\n"
+        "{\n"
+        "    details::FieldWriter(writer).writeValue(field);\n"
+        "}\n\n"
+        "/// @brief Write the message as a JSON object with \"id\", \"name\" and \"fields\" members.\n"
+        "template <typename TMsg>\n"
+        "void toJson(const TMsg& msg, Writer& writer)\n"
+        "{\n"
+        "    writer.beginObject();\n"
+        "    writer.key(\"id\");\n"
+        "    writer.valueUnsigned(static_cast<std::uintmax_t>(msg.doGetId()));\n"
+        "    writer.key(\"name\");\n"
+        "    writer.valueString(msg.doName());\n"
+        "    writer.key(\"fields\");\n"
+        "    writer.beginObject();\n"
+        "    comms::util::tupleForEach(msg.fields(), details::FieldWriter(writer));\n"
+        "    writer.endObject();\n"
+        "    writer.endObject();\n"
+        "}\n\n"
+        "/// @brief Message handler writing every handled message as a NDJSON record.\n"
+        "/// @details Can be used with both polymorphic and static dispatch of the messages.\n"
+        "class NdjsonHandler\n"
+        "{\n"
+        "public:\n"
+        "    explicit NdjsonHandler(Writer& writer) : m_writer(writer) {}\n\n"
+        "    template <typename TMsg>\n"
+        "    void handle(const TMsg& msg)\n"
+        "    {\n"
+        "        using Tag = \n"
+        "            typename std::conditional<\n"
+        "                comms::isMessageBase<TMsg>(),\n"
+        "                ActualMsgTag,\n"
+        "                InterfaceTag\n"
+        "            >::type;\n\n"
+        "        handleInternal(msg, Tag());\n"
+        "    }\n\n"
+        "private:\n"
+        "    struct ActualMsgTag {};\n"
+        "    struct InterfaceTag {};\n\n"
+        "    template <typename TMsg>\n"
+        "    void handleInternal(const TMsg& msg, ActualMsgTag)\n"
+        "    {\n"
+        "        toJson(msg, m_writer);\n"
+        "        m_writer.endRecord();\n"
+        "    }\n\n"
+        "    template <typename TMsg>\n"
+        "    void handleInternal(const TMsg&, InterfaceTag)\n"
+        "    {\n"
+        "    }\n\n"
+        "    Writer& m_writer;\n"
+        "};\n\n"
+        "} // namespace json\n\n"
+        "} // namespace #^#PROT_NAMESPACE#$#\n\n"
+        "#^#APPEND#$#\n"
+        ;
+
+    util::ReplacementMap repl = {
+        {"GENERATED", CommsGenerator::commsFileGeneratedComment()},
+        {"PROT_NAMESPACE", m_generator.currentSchema().mainNamespace()},
+        {"APPEND", util::readFileContents(comms::inputCodePathForRoot(JsonStr, m_generator))},
+    };
+
+    auto filePath = comms::headerPathRoot(JsonStr, m_generator);
+    return writeFileInternal(filePath, m_generator, util::processTemplate(Templ, repl, true));
+}
+
+bool CommsJson::commsWriteBenchInternal() const
+{
+    static const std::string Templ = 
+        "#^#GENERATED#$#\n"
+        "/// @file\n"
+        "/// @brief Measures throughput of the JSON serialization of all the protocol messages.\n"
+        "/// @details Usage: json_bench_#^#PROT_NAMESPACE#$# [iterations]\n\n"
+        "#include <chrono>\n"
+        "#include <cstddef>\n"
+        "#include <cstdint>\n"
+        "#include <cstdlib>\n"
+        "#include <iostream>\n"
+        "#include <vector>\n\n"
+        "#^#INCLUDES#$#\n\n"
+        "namespace\n"
+        "{\n\n"
+        "using Interface = #^#INTERFACE#$#<>;\n"
+        "using AllMessages = #^#ALL_MESSAGES#$#<Interface, #^#OPTIONS#$#>;\n\n"
+        "class MessageBench\n"
+        "{\n"
+        "public:\n"
+        "    MessageBench(std::size_t iterations, std::vector<char>& buf) :\n"
+        "        m_iterations(iterations),\n"
+        "        m_buf(buf)\n"
+        "    {\n"
+        "    }\n\n"
+        "    template <typename TMsg>\n"
+        "    void operator()()\n"
+        "    {\n"
+        "        using Clock = std::chrono::high_resolution_clock;\n\n"
+        "        TMsg msg;\n"
+        "        #^#PROT_NAMESPACE#$#::json::Writer writer(m_buf.data(), m_buf.size());\n"
+        "        auto start = Clock::now();\n"
+        "        for (std::size_t idx = 0U; idx < m_iterations; ++idx) {\n"
+        "            writer.clear();\n"
+        "            #^#PROT_NAMESPACE#$#::json::toJson(msg, writer);\n"
+        "            writer.endRecord();\n"
+        "        }\n"
+        "        auto diff = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start);\n\n"
+        "        if (writer.overflow()) {\n"
+        "            std::cerr << \"ERROR: Insufficient buffer to serialize \" << msg.doName() << std::endl;\n"
+        "            std::exit(-1);\n"
+        "        }\n\n"
+        "        auto nsPerOp = static_cast<double>(diff.count()) / static_cast<double>(m_iterations);\n"
+        "        double mbPerSec = 0.0;\n"
+        "        if (0.0 < nsPerOp) {\n"
+        "            mbPerSec = (static_cast<double>(writer.size()) * 1000.0) / nsPerOp;\n"
+        "        }\n\n"
+        "        if (0U < m_count) {\n"
+        "            std::cout << \",\";\n"
+        "        }\n\n"
+        "        std::cout << \"\\n    {\"\n"
+        "            \"\\\"name\\\":\\\"\" << msg.doName() << \"\\\",\"\n"
+        "            \"\\\"id\\\":\" << static_cast<std::intmax_t>(msg.doGetId()) << \",\"\n"
+        "            \"\\\"bytes_per_op\\\":\" << writer.size() << \",\"\n"
+        "            \"\\\"ns_per_op\\\":\" << nsPerOp << \",\"\n"
+        "            \"\\\"mb_per_sec\\\":\" << mbPerSec << \"}\";\n"
+        "        ++m_count;\n"
+        "    }\n\n"
+        "private:\n"
+        "    std::size_t m_iterations = 0U;\n"
+        "    std::vector<char>& m_buf;\n"
+        "    std::size_t m_count = 0U;\n"
+        "};\n\n"
+        "} // namespace\n\n"
+        "int main(int argc, const char* argv[])\n"
+        "{\n"
+        "    std::size_t iterations = 100000U;\n"
+        "    if (1 < argc) {\n"
+        "        iterations = static_cast<std::size_t>(std::strtoull(argv[1], nullptr, 10));\n"
+        "    }\n\n"
+        "    if (iterations == 0U) {\n"
+        "        std::cerr << \"Invalid number of iterations\" << std::endl;\n"
+        "        return -1;\n"
+        "    }\n\n"
+        "    std::vector<char> buf(1024U * 1024U);\n"
+        "    std::cout << \"{\\n  \\\"iterations\\\":\" << iterations << \",\\n\"\n"
+        "        \"  \\\"messages\\\":[\";\n\n"
+        "    comms::util::tupleForEachType<AllMessages>(MessageBench(iterations, buf));\n"
+        "    std::cout << \"\\n  ]\\n}\" << std::endl;\n"
+        "    return 0;\n"
+        "}\n"
+        ;
+
+    auto& gen = m_generator;
+    auto interfaces = gen.currentSchema().getAllInterfaces();
+    assert(!interfaces.empty());
+    auto* iFace = interfaces.front();
+
+    util::StringsList includes = {
+        comms::relHeaderForRoot(JsonStr, gen),
+        comms::relHeaderPathFor(*iFace, gen),
+        comms::relHeaderForInput(strings::allMessagesStr(), gen),
+        comms::relHeaderForOptions(strings::defaultOptionsStr(), gen),
+    };
+
+    comms::prepareIncludeStatement(includes);
+    util::ReplacementMap repl = {
+        {"GENERATED", CommsGenerator::commsFileGeneratedComment()},
+        {"PROT_NAMESPACE", gen.currentSchema().mainNamespace()},
+        {"INCLUDES", util::strListToString(includes, "\n", "")},
+        {"INTERFACE", comms::scopeFor(*iFace, gen)},
+        {"ALL_MESSAGES", comms::scopeForInput(strings::allMessagesStr(), gen)},
+        {"OPTIONS", comms::scopeForOptions(strings::defaultOptionsStr(), gen)},
+    };
+
+    auto filePath = 
+        util::pathAddElem(
+            util::pathAddElem(gen.getOutputDir(), strings::srcDirStr()), 
+            JsonBenchStr + strings::cppSourceSuffixStr());
+    return writeFileInternal(filePath, gen, util::processTemplate(Templ, repl, true));
+}
+
+} // namespace commsdsl2comms
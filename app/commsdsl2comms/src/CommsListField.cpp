@@ -16,6 +16,7 @@
 #include "CommsListField.h"
 
 #include "CommsGenerator.h"
+#include "CommsRefField.h"
 
 #include "commsdsl/gen/comms.h"
 #include "commsdsl/gen/util.h"
@@ -24,6 +25,7 @@
 #include <algorithm>
 #include <cassert>
 #include <iterator>
+#include <type_traits>
 
 namespace util = commsdsl::gen::util;
 namespace comms = commsdsl::gen::comms;
@@ -32,6 +34,113 @@ namespace strings = commsdsl::gen::strings;
 namespace commsdsl2comms
 {
 
+namespace 
+{
+
+const CommsField* getReferenceFieldInternal(const CommsField* field)
+{
+    while (field->field().dslObj().kind() == commsdsl::parse::Field::Kind::Ref) {
+        auto& refField = static_cast<const CommsRefField&>(*field);
+        field = dynamic_cast<decltype(field)>(refField.referencedField());
+        assert(field != nullptr);
+    }
+
+    return field;
+}
+
+std::size_t bulkIntElemLengthInternal(const commsdsl::parse::IntField& obj)
+{
+    static const std::size_t LengthMap[] = {
+        /* Int8 */ 1,
+        /* Uint8 */ 1,
+        /* Int16 */ 2,
+        /* Uint16 */ 2,
+        /* Int32 */ 4,
+        /* Uint32 */ 4,
+        /* Int64 */ 8,
+        /* Uint64 */ 8,
+        /* Intvar */ 0,
+        /* Uintvar */ 0
+    };
+
+    static const std::size_t LengthMapSize = std::extent<decltype(LengthMap)>::value;
+    static_assert(LengthMapSize == static_cast<std::size_t>(commsdsl::parse::IntField::Type::NumOfValues),
+            "Incorrect map");
+
+    auto idx = static_cast<std::size_t>(obj.type());
+    if (LengthMapSize <= idx) {
+        return 0U;
+    }
+
+    auto len = LengthMap[idx];
+    if ((len != obj.minLength()) || (len != obj.maxLength()) || (obj.bitLength() != 0U)) {
+        return 0U;
+    }
+
+    if ((obj.serOffset() != 0) || (!obj.signExt())) {
+        return 0U;
+    }
+
+    return len;
+}
+
+std::size_t bulkElemLengthInternal(const CommsField& elem)
+{
+    auto obj = elem.field().dslObj();
+    auto kind = obj.kind();
+    if (kind == commsdsl::parse::Field::Kind::Int) {
+        return bulkIntElemLengthInternal(commsdsl::parse::IntField(obj));
+    }
+
+    if (kind == commsdsl::parse::Field::Kind::Float) {
+        return obj.maxLength();
+    }
+
+    return 0U;
+}
+
+bool isBulkVarElemInternal(const CommsField& elem)
+{
+    auto obj = elem.field().dslObj();
+    if (obj.kind() != commsdsl::parse::Field::Kind::Int) {
+        return false;
+    }
+
+    commsdsl::parse::IntField intObj(obj);
+    auto type = intObj.type();
+    if ((type != commsdsl::parse::IntField::Type::Intvar) &&
+        (type != commsdsl::parse::IntField::Type::Uintvar)) {
+        return false;
+    }
+
+    // Serialised value must fit into std::uint64_t
+    static const std::size_t MaxVarLength = ((sizeof(std::uint64_t) * 8U) + 6U) / 7U;
+    return 
+        (intObj.minLength() == 1U) &&
+        (intObj.maxLength() <= MaxVarLength) &&
+        (intObj.serOffset() == 0) &&
+        (intObj.signExt());
+}
+
+bool isBulkVarSignedElemInternal(const CommsField& elem)
+{
+    assert(isBulkVarElemInternal(elem));
+    return commsdsl::parse::IntField(elem.field().dslObj()).type() == commsdsl::parse::IntField::Type::Intvar;
+}
+
+commsdsl::parse::Endian bulkElemEndianInternal(const CommsField& elem)
+{
+    auto obj = elem.field().dslObj();
+    if (obj.kind() == commsdsl::parse::Field::Kind::Int) {
+        return commsdsl::parse::IntField(obj).endian();
+    }
+
+    assert(obj.kind() == commsdsl::parse::Field::Kind::Float);
+    return commsdsl::parse::FloatField(obj).endian();
+}
+
+} // namespace 
+
 CommsListField::CommsListField(
     CommsGenerator& generator, 
     commsdsl::parse::Field dslObj, 
@@ -41,6 +150,16 @@ CommsListField::CommsListField(
 {
 }
 
+const CommsField* CommsListField::commsBulkVarElementField() const
+{
+    auto* bulkElem = commsBulkElementFieldInternal();
+    if ((bulkElem == nullptr) || (!isBulkVarElemInternal(*bulkElem))) {
+        return nullptr;
+    }
+
+    return bulkElem;
+}
+
 bool CommsListField::prepareImpl()
 {
     bool result = Base::prepareImpl() && commsPrepare();
@@ -187,6 +306,23 @@ CommsListField::IncludesList CommsListField::commsDefIncludesImpl() const
     if (!obj.detachedElemLengthPrefixFieldName().empty()) {
         result.push_back("comms/Assert.h");
     } 
+
+    auto* bulkElem = commsBulkElementFieldInternal();
+    if (bulkElem != nullptr) {
+        result.push_back("<cstdint>");
+        if (bulkElem->field().dslObj().kind() == commsdsl::parse::Field::Kind::Float) {
+            result.push_back("<cstring>");
+        }
+
+        if (isBulkVarElemInternal(*bulkElem)) {
+            result.insert(result.end(), {
+                "<algorithm>",
+                "<iterator>",
+                "<limits>",
+                "<type_traits>"
+            });
+        }
+    }
     return result;
 }
 
@@ -233,6 +369,156 @@ std::string CommsListField::commsDefBaseClassImpl() const
     return util::processTemplate(Templ, repl);
 }
 
+std::string CommsListField::commsDefPrivateCodeImpl() const
+{
+    if (commsBulkElementFieldInternal() == nullptr) {
+        return strings::emptyString();
+    }
+
+    if (isBulkVarElemInternal(*commsBulkElementFieldInternal())) {
+        return 
+            commsDefBulkReadVarElementsCodeInternal() + '\n' +
+            commsDefBulkWriteVarElementsCodeInternal();
+    }
+
+    return 
+        commsDefBulkReadElementsCodeInternal() + '\n' +
+        commsDefBulkWriteElementsCodeInternal();
+}
+
+std::string CommsListField::commsDefReadFuncBodyImpl() const
+{
+    auto* bulkElem = commsBulkElementFieldInternal();
+    if (bulkElem == nullptr) {
+        return strings::emptyString();
+    }
+
+    if (isBulkVarElemInternal(*bulkElem)) {
+        return commsDefBulkReadVarFuncBodyInternal();
+    }
+
+    auto elemLenStr = util::numToString(static_cast<std::uintmax_t>(bulkElemLengthInternal(*bulkElem)));
+    auto fixedCount = listDslObj().fixedCount();
+    if (fixedCount != 0U) {
+        return "return readElementsInternal(" + util::numToString(static_cast<std::uintmax_t>(fixedCount)) + ", iter, len);\n";
+    }
+
+    auto prefixType = commsDefPrefixTypeInternal(m_commsMemberCountPrefixField, m_commsExternalCountPrefixField);
+    if (!prefixType.empty()) {
+        static const std::string Templ = 
+            "using PrefixField =\n"
+            "    #^#PREFIX#$#;\n"
+            "PrefixField prefixField;\n"
+            "auto es = prefixField.read(iter, len);\n"
+            "if (es != comms::ErrorStatus::Success) {\n"
+            "    return es;\n"
+            "}\n\n"
+            "len -= prefixField.length();\n"
+            "return readElementsInternal(static_cast<std::size_t>(prefixField.getValue()), iter, len);\n";
+
+        util::ReplacementMap repl = {
+            {"PREFIX", std::move(prefixType)},
+        };
+        return util::processTemplate(Templ, repl);
+    }
+
+    prefixType = commsDefPrefixTypeInternal(m_commsMemberLengthPrefixField, m_commsExternalLengthPrefixField);
+    if (!prefixType.empty()) {
+        static const std::string Templ = 
+            "using PrefixField =\n"
+            "    #^#PREFIX#$#;\n"
+            "PrefixField prefixField;\n"
+            "auto es = prefixField.read(iter, len);\n"
+            "if (es != comms::ErrorStatus::Success) {\n"
+            "    return es;\n"
+            "}\n\n"
+            "len -= prefixField.length();\n"
+            "auto serLen = static_cast<std::size_t>(prefixField.getValue());\n"
+            "if (len < serLen) {\n"
+            "    return comms::ErrorStatus::NotEnoughData;\n"
+            "}\n\n"
+            "if ((serLen % #^#ELEM_LEN#$#) != 0U) {\n"
+            "    return comms::ErrorStatus::ProtocolError;\n"
+            "}\n\n"
+            "return readElementsInternal(serLen / #^#ELEM_LEN#$#, iter, serLen);\n";
+
+        util::ReplacementMap repl = {
+            {"PREFIX", std::move(prefixType)},
+            {"ELEM_LEN", elemLenStr},
+        };
+        return util::processTemplate(Templ, repl);
+    }
+
+    static const std::string Templ = 
+        "if ((len % #^#ELEM_LEN#$#) != 0U) {\n"
+        "    return comms::ErrorStatus::NotEnoughData;\n"
+        "}\n\n"
+        "return readElementsInternal(len / #^#ELEM_LEN#$#, iter, len);\n";
+
+    util::ReplacementMap repl = {
+        {"ELEM_LEN", elemLenStr},
+    };
+    return util::processTemplate(Templ, repl);
+}
+
+std::string CommsListField::commsDefWriteFuncBodyImpl() const
+{
+    auto* bulkElem = commsBulkElementFieldInternal();
+    if (bulkElem == nullptr) {
+        return strings::emptyString();
+    }
+
+    if (isBulkVarElemInternal(*bulkElem)) {
+        return commsDefBulkWriteVarFuncBodyInternal();
+    }
+
+    auto fixedCount = listDslObj().fixedCount();
+    if (fixedCount != 0U) {
+        static const std::string Templ = 
+            "if (Base::value().size() != #^#COUNT#$#) {\n"
+            "    return Base::write(iter, len);\n"
+            "}\n\n"
+            "return writeElementsInternal(iter, len);\n";
+
+        util::ReplacementMap repl = {
+            {"COUNT", util::numToString(static_cast<std::uintmax_t>(fixedCount))},
+        };
+        return util::processTemplate(Templ, repl);
+    }
+
+    static const std::string PrefixTempl = 
+        "using PrefixField =\n"
+        "    #^#PREFIX#$#;\n"
+        "PrefixField prefixField;\n"
+        "prefixField.setValue(#^#VALUE#$#);\n"
+        "auto es = prefixField.write(iter, len);\n"
+        "if (es != comms::ErrorStatus::Success) {\n"
+        "    return es;\n"
+        "}\n\n"
+        "len -= prefixField.length();\n"
+        "return writeElementsInternal(iter, len);\n";
+
+    auto prefixType = commsDefPrefixTypeInternal(m_commsMemberCountPrefixField, m_commsExternalCountPrefixField);
+    if (!prefixType.empty()) {
+        util::ReplacementMap repl = {
+            {"PREFIX", std::move(prefixType)},
+            {"VALUE", "Base::value().size()"},
+        };
+        return util::processTemplate(PrefixTempl, repl);
+    }
+
+    prefixType = commsDefPrefixTypeInternal(m_commsMemberLengthPrefixField, m_commsExternalLengthPrefixField);
+    if (!prefixType.empty()) {
+        util::ReplacementMap repl = {
+            {"PREFIX", std::move(prefixType)},
+            {"VALUE", "Base::value().size() * " + util::numToString(static_cast<std::uintmax_t>(bulkElemLengthInternal(*bulkElem)))},
+        };
+        return util::processTemplate(PrefixTempl, repl);
+    }
+
+    return "return writeElementsInternal(iter, len);\n";
+}
+
 std::string CommsListField::commsDefBundledReadPrepareFuncBodyImpl(const CommsFieldsList& siblings) const
 {
     auto obj = listDslObj();
@@ -539,6 +825,42 @@ CommsListField::StringsList CommsListField::commsExtraBareMetalDefaultOptionsImp
         };     
 }
 
+CommsListField::StringsList CommsListField::commsExtraBoundedBareMetalDefaultOptionsImpl() const
+{
+    auto obj = listDslObj();
+    if (obj.fixedCount() != 0U) {
+        return StringsList();
+    }
+
+    std::uintmax_t capacity = 0U;
+    do {
+        if (obj.hasCountPrefixField()) {
+            capacity = commsBoundedStorageMaxPrefixValue(obj.countPrefixField());
+            break;
+        }
+
+        if (!obj.hasLengthPrefixField()) {
+            break;
+        }
+
+        auto elemMinLength = obj.elementField().minLength();
+        if (obj.hasElemLengthPrefixField()) {
+            elemMinLength += obj.elemLengthPrefixField().minLength();
+        }
+
+        if (elemMinLength == 0U) {
+            break;
+        }
+
+        capacity = commsBoundedStorageMaxPrefixValue(obj.lengthPrefixField()) / elemMinLength;
+    } while (false);
+
+    // The maximal serialization length of the element estimates its storage size,
+    // the elements of unbounded length make the whole list unbounded.
+    auto elemMaxLength = std::max(obj.elementField().maxLength(), std::size_t(1U));
+    return commsBoundedStorageOpts(capacity, elemMaxLength);
+}
+
 std::size_t CommsListField::commsMaxLengthImpl() const
 {
     auto obj = listDslObj();
@@ -567,6 +889,7 @@ std::string CommsListField::commsDefFieldOptsInternal() const
     commsAddElemLengthPrefixOptInternal(opts);
     commsAddTermSuffixOptInternal(opts);
     commsAddLengthForcingOptInternal(opts);
+    commsAddBulkSerialisationOptInternal(opts);
 
     return util::strListToString(opts, ",\n", "");
 }
@@ -589,6 +912,548 @@ std::string CommsListField::commsDefElementInternal() const
     return comms::scopeFor(m_commsExternalElementField->field(), generator()) + "<TOpt>";
 }
 
+std::string CommsListField::commsDefPrefixTypeInternal(const CommsField* memberPrefix, const CommsField* externalPrefix) const
+{
+    if ((externalPrefix == nullptr) && (memberPrefix == nullptr)) {
+        return strings::emptyString();
+    }
+
+    std::string prefixName;
+    if (memberPrefix != nullptr) {
+        prefixName = "typename " + comms::className(name()) + strings::membersSuffixStr();
+        if (comms::isGlobalField(*this)) {
+            prefixName += "<TOpt>";
+        }
+
+        prefixName += "::" + comms::className(memberPrefix->field().name());
+    }
+    else {
+        assert(externalPrefix != nullptr);
+        prefixName = comms::scopeFor(externalPrefix->field(), generator(), true, true);
+        prefixName += "<TOpt> ";
+    }
+
+    return prefixName;
+}
+
+std::string CommsListField::commsDefBulkReadElementsCodeInternal() const
+{
+    static const std::string Templ = 
+        "/// @brief Bulk read of the fixed length elements.\n"
+        "template <typename TIter>\n"
+        "comms::ErrorStatus readElementsInternal(std::size_t count, TIter& iter, std::size_t len)\n"
+        "{\n"
+        "    using ElemValueType = typename Base::ElementType::ValueType;\n"
+        "    using SerType = #^#SER_TYPE#$#;\n"
+        "    static const std::size_t ElemLen = sizeof(SerType);\n"
+        "    static_assert(sizeof(ElemValueType) == ElemLen, \"Unexpected element length\");\n\n"
+        "    if ((len / ElemLen) < count) {\n"
+        "        return comms::ErrorStatus::NotEnoughData;\n"
+        "    }\n\n"
+        "    auto& elems = Base::value();\n"
+        "    if (elems.max_size() < count) {\n"
+        "        return comms::ErrorStatus::InvalidMsgData;\n"
+        "    }\n\n"
+        "    elems.clear();\n"
+        "    elems.resize(count);\n"
+        "    for (auto& elem : elems) {\n"
+        "        SerType serValue = 0U;\n"
+        "        for (std::size_t byteIdx = 0U; byteIdx < ElemLen; ++byteIdx) {\n"
+        "            #^#READ_BYTE#$#\n"
+        "            ++iter;\n"
+        "        }\n\n"
+        "        #^#ASSIGN#$#\n"
+        "    }\n\n"
+        "    return comms::ErrorStatus::Success;\n"
+        "}\n";
+
+    auto* bulkElem = commsBulkElementFieldInternal();
+    assert(bulkElem != nullptr);
+    auto elemLen = bulkElemLengthInternal(*bulkElem);
+    util::ReplacementMap repl = {
+        {"SER_TYPE", "std::uint" + std::to_string(elemLen * 8U) + "_t"},
+        {"READ_BYTE", "serValue = static_cast<SerType>((serValue << 8U) | static_cast<std::uint8_t>(*iter));"},
+        {"ASSIGN", "elem.setValue(static_cast<ElemValueType>(serValue));"},
+    };
+
+    if (bulkElemEndianInternal(*bulkElem) == commsdsl::parse::Endian_Little) {
+        repl["READ_BYTE"] = "serValue = static_cast<SerType>(serValue | (static_cast<SerType>(static_cast<std::uint8_t>(*iter)) << (byteIdx * 8U)));";
+    }
+
+    if (bulkElem->field().dslObj().kind() == commsdsl::parse::Field::Kind::Float) {
+        repl["ASSIGN"] = 
+            "ElemValueType value = ElemValueType();\n"
+            "std::memcpy(&value, &serValue, sizeof(value));\n"
+            "elem.setValue(value);";
+    }
+
+    return util::processTemplate(Templ, repl);
+}
+
+std::string CommsListField::commsDefBulkWriteElementsCodeInternal() const
+{
+    static const std::string Templ = 
+        "/// @brief Bulk write of the fixed length elements.\n"
+        "template <typename TIter>\n"
+        "comms::ErrorStatus writeElementsInternal(TIter& iter, std::size_t len) const\n"
+        "{\n"
+        "    using SerType = #^#SER_TYPE#$#;\n"
+        "    static const std::size_t ElemLen = sizeof(SerType);\n\n"
+        "    auto& elems = Base::value();\n"
+        "    if (len < (elems.size() * ElemLen)) {\n"
+        "        return comms::ErrorStatus::BufferOverflow;\n"
+        "    }\n\n"
+        "    for (auto& elem : elems) {\n"
+        "        #^#SER_VALUE#$#\n"
+        "        for (std::size_t byteIdx = 0U; byteIdx < ElemLen; ++byteIdx) {\n"
+        "            *iter = static_cast<std::uint8_t>(serValue >> (#^#SHIFT#$# * 8U));\n"
+        "            ++iter;\n"
+        "        }\n"
+        "    }\n\n"
+        "    return comms::ErrorStatus::Success;\n"
+        "}\n";
+
+    auto* bulkElem = commsBulkElementFieldInternal();
+    assert(bulkElem != nullptr);
+    auto elemLen = bulkElemLengthInternal(*bulkElem);
+    util::ReplacementMap repl = {
+        {"SER_TYPE", "std::uint" + std::to_string(elemLen * 8U) + "_t"},
+        {"SER_VALUE", "auto serValue = static_cast<SerType>(elem.getValue());"},
+        {"SHIFT", "(ElemLen - byteIdx - 1U)"},
+    };
+
+    if (bulkElemEndianInternal(*bulkElem) == commsdsl::parse::Endian_Little) {
+        repl["SHIFT"] = "byteIdx";
+    }
+
+    if (bulkElem->field().dslObj().kind() == commsdsl::parse::Field::Kind::Float) {
+        repl["SER_VALUE"] = 
+            "auto value = elem.getValue();\n"
+            "SerType serValue = 0U;\n"
+            "std::memcpy(&serValue, &value, sizeof(serValue));";
+    }
+
+    return util::processTemplate(Templ, repl);
+}
+
+std::string CommsListField::commsDefBulkReadVarFuncBodyInternal() const
+{
+    auto fixedCount = listDslObj().fixedCount();
+    if (fixedCount != 0U) {
+        return "return readElementsInternal(" + util::numToString(static_cast<std::uintmax_t>(fixedCount)) + ", iter, len);\n";
+    }
+
+    auto prefixType = commsDefPrefixTypeInternal(m_commsMemberCountPrefixField, m_commsExternalCountPrefixField);
+    if (!prefixType.empty()) {
+        static const std::string Templ = 
+            "using PrefixField =\n"
+            "    #^#PREFIX#$#;\n"
+            "PrefixField prefixField;\n"
+            "auto es = prefixField.read(iter, len);\n"
+            "if (es != comms::ErrorStatus::Success) {\n"
+            "    return es;\n"
+            "}\n\n"
+            "len -= prefixField.length();\n"
+            "return readElementsInternal(static_cast<std::size_t>(prefixField.getValue()), iter, len);\n";
+
+        util::ReplacementMap repl = {
+            {"PREFIX", std::move(prefixType)},
+        };
+        return util::processTemplate(Templ, repl);
+    }
+
+    prefixType = commsDefPrefixTypeInternal(m_commsMemberLengthPrefixField, m_commsExternalLengthPrefixField);
+    if (!prefixType.empty()) {
+        static const std::string Templ = 
+            "using PrefixField =\n"
+            "    #^#PREFIX#$#;\n"
+            "PrefixField prefixField;\n"
+            "auto es = prefixField.read(iter, len);\n"
+            "if (es != comms::ErrorStatus::Success) {\n"
+            "    return es;\n"
+            "}\n\n"
+            "len -= prefixField.length();\n"
+            "auto serLen = static_cast<std::size_t>(prefixField.getValue());\n"
+            "if (len < serLen) {\n"
+            "    return comms::ErrorStatus::NotEnoughData;\n"
+            "}\n\n"
+            "es = readElementsInternal(std::numeric_limits<std::size_t>::max(), iter, serLen);\n"
+            "if (es == comms::ErrorStatus::NotEnoughData) {\n"
+            "    // The last element is truncated by the length prefix\n"
+            "    es = comms::ErrorStatus::ProtocolError;\n"
+            "}\n\n"
+            "return es;\n";
+
+        util::ReplacementMap repl = {
+            {"PREFIX", std::move(prefixType)},
+        };
+        return util::processTemplate(Templ, repl);
+    }
+
+    return "return readElementsInternal(std::numeric_limits<std::size_t>::max(), iter, len);\n";
+}
+
+std::string CommsListField::commsDefBulkWriteVarFuncBodyInternal() const
+{
+    static const std::string Templ = 
+        "auto serLen = elementsLengthInternal();\n"
+        "if (#^#FALLBACK_COND#$#) {\n"
+        "    return Base::write(iter, len);\n"
+        "}\n\n"
+        "#^#PREFIX_WRITE#$#return writeElementsInternal(serLen, iter, len);\n";
+
+    static const std::string PrefixTempl = 
+        "using PrefixField =\n"
+        "    #^#PREFIX#$#;\n"
+        "PrefixField prefixField;\n"
+        "prefixField.setValue(#^#VALUE#$#);\n"
+        "auto es = prefixField.write(iter, len);\n"
+        "if (es != comms::ErrorStatus::Success) {\n"
+        "    return es;\n"
+        "}\n\n"
+        "len -= prefixField.length();\n\n";
+
+    util::ReplacementMap repl = {
+        {"FALLBACK_COND", "serLen == std::numeric_limits<std::size_t>::max()"},
+    };
+
+    auto fixedCount = listDslObj().fixedCount();
+    if (fixedCount != 0U) {
+        repl["FALLBACK_COND"] = 
+            "(Base::value().size() != " + util::numToString(static_cast<std::uintmax_t>(fixedCount)) + ") ||\n"
+            "(" + repl["FALLBACK_COND"] + ")";
+        return util::processTemplate(Templ, repl);
+    }
+
+    util::ReplacementMap prefixRepl;
+    auto prefixType = commsDefPrefixTypeInternal(m_commsMemberCountPrefixField, m_commsExternalCountPrefixField);
+    if (!prefixType.empty()) {
+        prefixRepl["PREFIX"] = std::move(prefixType);
+        prefixRepl["VALUE"] = "Base::value().size()";
+    }
+    else {
+        prefixType = commsDefPrefixTypeInternal(m_commsMemberLengthPrefixField, m_commsExternalLengthPrefixField);
+        if (!prefixType.empty()) {
+            prefixRepl["PREFIX"] = std::move(prefixType);
+            prefixRepl["VALUE"] = "serLen";
+        }
+    }
+
+    if (!prefixRepl.empty()) {
+        repl["PREFIX_WRITE"] = util::processTemplate(PrefixTempl, prefixRepl);
+    }
+
+    return util::processTemplate(Templ, repl);
+}
+
+std::string CommsListField::commsDefBulkReadVarElementsCodeInternal() const
+{
+    static const std::string Templ = 
+        "using ElemValueType = typename Base::ElementType::ValueType;\n"
+        "static const std::size_t MaxVarLength = #^#MAX_LEN#$#;\n\n"
+        "struct VarWordScanTag {};\n"
+        "struct VarByteScanTag {};\n\n"
+        "/// @brief Bulk read of the variable length elements.\n"
+        "/// @details When the @b count is unknown (max value), the elements\n"
+        "///     are read until all the @b len bytes are consumed.\n"
+        "template <typename TIter>\n"
+        "comms::ErrorStatus readElementsInternal(std::size_t count, TIter& iter, std::size_t len)\n"
+        "{\n"
+        "    using IterValueType = typename std::iterator_traits<TIter>::value_type;\n"
+        "    using Tag =\n"
+        "        typename std::conditional<\n"
+        "            std::is_pointer<TIter>::value && (sizeof(IterValueType) == 1U),\n"
+        "            VarWordScanTag,\n"
+        "            VarByteScanTag\n"
+        "        >::type;\n\n"
+        "    static const std::size_t UnknownCount = std::numeric_limits<std::size_t>::max();\n"
+        "    auto& elems = Base::value();\n"
+        "    elems.clear();\n"
+        "    std::size_t idx = 0U;\n"
+        "    if (count == UnknownCount) {\n"
+        "        // The storage grows with the read elements rather than with\n"
+        "        // the available length\n"
+        "        static const std::size_t MinGrowCount = 64U;\n"
+        "        auto maxSize = static_cast<std::size_t>(elems.max_size());\n"
+        "        while (0U < len) {\n"
+        "            if (maxSize <= idx) {\n"
+        "                return comms::ErrorStatus::InvalidMsgData;\n"
+        "            }\n\n"
+        "            // Every element consumes at least one byte\n"
+        "            auto growCount = std::min(std::max(idx, MinGrowCount), len);\n"
+        "            auto limit = idx + std::min(growCount, maxSize - idx);\n"
+        "            elems.resize(limit);\n"
+        "            auto es = readVarElementsInternal(idx, limit, iter, len, Tag());\n"
+        "            if (es != comms::ErrorStatus::Success) {\n"
+        "                return es;\n"
+        "            }\n"
+        "        }\n\n"
+        "        elems.resize(idx);\n"
+        "        return comms::ErrorStatus::Success;\n"
+        "    }\n\n"
+        "    if (len < count) {\n"
+        "        return comms::ErrorStatus::NotEnoughData;\n"
+        "    }\n\n"
+        "    if (elems.max_size() < count) {\n"
+        "        return comms::ErrorStatus::InvalidMsgData;\n"
+        "    }\n\n"
+        "    elems.resize(count);\n"
+        "    auto es = readVarElementsInternal(idx, count, iter, len, Tag());\n"
+        "    if (es != comms::ErrorStatus::Success) {\n"
+        "        return es;\n"
+        "    }\n\n"
+        "    return (idx == count) ? comms::ErrorStatus::Success : comms::ErrorStatus::NotEnoughData;\n"
+        "}\n\n"
+        "/// @brief Read of the variable length elements byte by byte.\n"
+        "template <typename TIter>\n"
+        "comms::ErrorStatus readVarElementsInternal(std::size_t& idx, std::size_t limit, TIter& iter, std::size_t& len, VarByteScanTag)\n"
+        "{\n"
+        "    while ((idx < limit) && (0U < len)) {\n"
+        "        auto es = readVarElementInternal(idx, iter, len);\n"
+        "        if (es != comms::ErrorStatus::Success) {\n"
+        "            return es;\n"
+        "        }\n"
+        "        ++idx;\n"
+        "    }\n\n"
+        "    return comms::ErrorStatus::Success;\n"
+        "}\n\n"
+        "/// @brief Read of the variable length elements scanning continuation bits\n"
+        "///     of 8 bytes at a time.\n"
+        "/// @details Runs of single byte elements are decoded without any per element\n"
+        "///     branching, other elements are decoded byte by byte.\n"
+        "template <typename TIter>\n"
+        "comms::ErrorStatus readVarElementsInternal(std::size_t& idx, std::size_t limit, TIter& iter, std::size_t& len, VarWordScanTag)\n"
+        "{\n"
+        "    static const std::size_t WordLen = sizeof(std::uint64_t);\n"
+        "    static const std::uint64_t ContinueBits = 0x8080808080808080ULL;\n"
+        "    auto& elems = Base::value();\n"
+        "    while ((idx < limit) && (WordLen <= len)) {\n"
+        "        auto word =\n"
+        "            static_cast<std::uint64_t>(static_cast<std::uint8_t>(iter[0])) |\n"
+        "            (static_cast<std::uint64_t>(static_cast<std::uint8_t>(iter[1])) << 8U) |\n"
+        "            (static_cast<std::uint64_t>(static_cast<std::uint8_t>(iter[2])) << 16U) |\n"
+        "            (static_cast<std::uint64_t>(static_cast<std::uint8_t>(iter[3])) << 24U) |\n"
+        "            (static_cast<std::uint64_t>(static_cast<std::uint8_t>(iter[4])) << 32U) |\n"
+        "            (static_cast<std::uint64_t>(static_cast<std::uint8_t>(iter[5])) << 40U) |\n"
+        "            (static_cast<std::uint64_t>(static_cast<std::uint8_t>(iter[6])) << 48U) |\n"
+        "            (static_cast<std::uint64_t>(static_cast<std::uint8_t>(iter[7])) << 56U);\n\n"
+        "        if (((word & ContinueBits) == 0U) && (WordLen <= (limit - idx))) {\n"
+        "            // Eight single byte elements\n"
+        "            for (std::size_t byteIdx = 0U; byteIdx < WordLen; ++byteIdx) {\n"
+        "                auto serValue = (word >> (byteIdx * 8U)) & 0x7fU;\n"
+        "                elems[idx + byteIdx].setValue(static_cast<ElemValueType>(signExtVarInternal(serValue, 1U)));\n"
+        "            }\n\n"
+        "            idx += WordLen;\n"
+        "            iter += WordLen;\n"
+        "            len -= WordLen;\n"
+        "            continue;\n"
+        "        }\n\n"
+        "        // Decode the elements covering the scanned bytes before scanning again\n"
+        "        auto wordEndLen = len - WordLen;\n"
+        "        while ((idx < limit) && (wordEndLen < len)) {\n"
+        "            auto es = readVarElementInternal(idx, iter, len);\n"
+        "            if (es != comms::ErrorStatus::Success) {\n"
+        "                return es;\n"
+        "            }\n"
+        "            ++idx;\n"
+        "        }\n"
+        "    }\n\n"
+        "    return readVarElementsInternal(idx, limit, iter, len, VarByteScanTag());\n"
+        "}\n\n"
+        "/// @brief Read of the single variable length element.\n"
+        "template <typename TIter>\n"
+        "comms::ErrorStatus readVarElementInternal(std::size_t idx, TIter& iter, std::size_t& len)\n"
+        "{\n"
+        "    std::uint64_t serValue = 0U;\n"
+        "    std::size_t byteCount = 0U;\n"
+        "    while (true) {\n"
+        "        if (len == 0U) {\n"
+        "            return comms::ErrorStatus::NotEnoughData;\n"
+        "        }\n\n"
+        "        auto byte = static_cast<std::uint8_t>(*iter);\n"
+        "        ++iter;\n"
+        "        --len;\n"
+        "        #^#ADD_BYTE#$#\n"
+        "        ++byteCount;\n"
+        "        if ((byte & 0x80U) == 0U) {\n"
+        "            break;\n"
+        "        }\n\n"
+        "        if (MaxVarLength <= byteCount) {\n"
+        "            return comms::ErrorStatus::ProtocolError;\n"
+        "        }\n"
+        "    }\n\n"
+        "    Base::value()[idx].setValue(static_cast<ElemValueType>(signExtVarInternal(serValue, byteCount)));\n"
+        "    return comms::ErrorStatus::Success;\n"
+        "}\n\n"
+        "#^#SIGN_EXT#$#\n"
+        ;
+
+    static const std::string SignedExtTempl = 
+        "/// @brief Sign extension of the value decoded from @b byteCount bytes.\n"
+        "static std::uint64_t signExtVarInternal(std::uint64_t serValue, std::size_t byteCount)\n"
+        "{\n"
+        "    auto bitCount = byteCount * 7U;\n"
+        "    if ((sizeof(std::uint64_t) * 8U) <= bitCount) {\n"
+        "        return serValue;\n"
+        "    }\n\n"
+        "    auto signBit = static_cast<std::uint64_t>(1U) << (bitCount - 1U);\n"
+        "    return (serValue ^ signBit) - signBit;\n"
+        "}\n";
+
+    static const std::string UnsignedExtTempl = 
+        "/// @brief No sign extension is required for unsigned elements.\n"
+        "static std::uint64_t signExtVarInternal(std::uint64_t serValue, std::size_t byteCount)\n"
+        "{\n"
+        "    static_cast<void>(byteCount);\n"
+        "    return serValue;\n"
+        "}\n";
+
+    auto* bulkElem = commsBulkElementFieldInternal();
+    assert(bulkElem != nullptr);
+    util::ReplacementMap repl = {
+        {"MAX_LEN", util::numToString(static_cast<std::uintmax_t>(bulkElem->field().dslObj().maxLength()))},
+        {"ADD_BYTE", 
+            "if ((byteCount * 7U) < (sizeof(serValue) * 8U)) {\n"
+            "    serValue |= static_cast<std::uint64_t>(byte & 0x7fU) << (byteCount * 7U);\n"
+            "}\n"},
+        {"SIGN_EXT", UnsignedExtTempl},
+    };
+
+    if (bulkElemEndianInternal(*bulkElem) == commsdsl::parse::Endian_Big) {
+
+        repl["ADD_BYTE"] = "serValue = (serValue << 7U) | static_cast<std::uint64_t>(byte & 0x7fU);";
+    }
+
+    if (isBulkVarSignedElemInternal(*bulkElem)) {
+        repl["SIGN_EXT"] = SignedExtTempl;
+    }
+
+    return util::processTemplate(Templ, repl);
+}
+
+std::string CommsListField::commsDefBulkWriteVarElementsCodeInternal() const
+{
+    static const std::string Templ = 
+        "/// @brief Serialisation length of the variable length elements.\n"
+        "/// @details Returns max value when any element requires more than\n"
+        "///     @b MaxVarLength bytes.\n"
+        "std::size_t elementsLengthInternal() const\n"
+        "{\n"
+        "    std::size_t result = 0U;\n"
+        "    for (auto& elem : Base::value()) {\n"
+        "        auto elemLen = varLengthInternal(static_cast<std::uint64_t>(elem.getValue()));\n"
+        "        if (MaxVarLength < elemLen) {\n"
+        "            return std::numeric_limits<std::size_t>::max();\n"
+        "        }\n\n"
+        "        result += elemLen;\n"
+        "    }\n\n"
+        "    return result;\n"
+        "}\n\n"
+        "/// @brief Bulk write of the variable length elements.\n"
+        "template <typename TIter>\n"
+        "comms::ErrorStatus writeElementsInternal(std::size_t serLen, TIter& iter, std::size_t len) const\n"
+        "{\n"
+        "    if (len < serLen) {\n"
+        "        return comms::ErrorStatus::BufferOverflow;\n"
+        "    }\n\n"
+        "    for (auto& elem : Base::value()) {\n"
+        "        auto serValue = static_cast<std::uint64_t>(elem.getValue());\n"
+        "        auto byteCount = varLengthInternal(serValue);\n"
+        "        for (std::size_t byteIdx = 0U; byteIdx < byteCount; ++byteIdx) {\n"
+        "            auto byte = static_cast<std::uint8_t>((serValue >> (#^#SHIFT#$# * 7U)) & 0x7fU);\n"
+        "            if ((byteIdx + 1U) < byteCount) {\n"
+        "                byte = static_cast<std::uint8_t>(byte | 0x80U);\n"
+        "            }\n\n"
+        "            *iter = byte;\n"
+        "            ++iter;\n"
+        "        }\n"
+        "    }\n\n"
+        "    return comms::ErrorStatus::Success;\n"
+        "}\n\n"
+        "/// @brief Minimal number of bytes required to serialise the value.\n"
+        "static std::size_t varLengthInternal(std::uint64_t serValue)\n"
+        "{\n"
+        "    #^#VAR_LEN#$#\n"
+        "}\n";
+
+    auto* bulkElem = commsBulkElementFieldInternal();
+    assert(bulkElem != nullptr);
+    util::ReplacementMap repl = {
+        {"SHIFT", "byteIdx"},
+        {"VAR_LEN", 
+            "std::size_t result = 1U;\n"
+            "auto rest = serValue >> 7U;\n"
+            "while (rest != 0U) {\n"
+            "    rest >>= 7U;\n"
+            "    ++result;\n"
+            "}\n\n"
+            "return result;"},
+    };
+
+    if (bulkElemEndianInternal(*bulkElem) == commsdsl::parse::Endian_Big) {
+        repl["SHIFT"] = "(byteCount - byteIdx - 1U)";
+    }
+
+    if (isBulkVarSignedElemInternal(*bulkElem)) {
+        repl["VAR_LEN"] = 
+            "// The sign bit of the last 7 bit group needs to be preserved as well\n"
+            "auto magnitude = serValue ^ (static_cast<std::uint64_t>(0U) - (serValue >> 63U));\n"
+            "std::size_t result = 1U;\n"
+            "auto rest = magnitude >> 6U;\n"
+            "while (rest != 0U) {\n"
+            "    rest >>= 7U;\n"
+            "    ++result;\n"
+            "}\n\n"
+            "return result;";
+    }
+
+    return util::processTemplate(Templ, repl);
+}
+
+const CommsField* CommsListField::commsBulkElementFieldInternal() const
+{
+    auto obj = listDslObj();
+    if ((!obj.detachedCountPrefixFieldName().empty()) ||
+        (!obj.detachedLengthPrefixFieldName().empty()) ||
+        (!obj.detachedElemLengthPrefixFieldName().empty()) ||
+        (m_commsExternalElemLengthPrefixField != nullptr) ||
+        (m_commsMemberElemLengthPrefixField != nullptr) ||
+        (m_commsExternalTermSuffixField != nullptr) ||
+        (m_commsMemberTermSuffixField != nullptr)) {
+        return nullptr;
+    }
+
+    const CommsField* elem = m_commsMemberElementField;
+    if (elem == nullptr) {
+        elem = m_commsExternalElementField;
+    }
+
+    if (elem == nullptr) {
+        return nullptr;
+    }
+
+    // The reference itself may have a custom code
+    if (elem->commsHasCustomReadWrite() || elem->commsHasCustomValue()) {
+        return nullptr;
+    }
+
+    elem = getReferenceFieldInternal(elem);
+    auto elemObj = elem->field().dslObj();
+    if (elemObj.isFailOnInvalid() || 
+        elemObj.isPseudo() ||
+        elem->commsHasGeneratedReadCode() ||
+        elem->commsHasCustomReadWrite() ||
+        elem->commsHasCustomValue()) {
+        return nullptr;
+    }
+
+    if ((bulkElemLengthInternal(*elem) == 0U) && (!isBulkVarElemInternal(*elem))) {
+        return nullptr;
+    }
+
+    return elem;
+}
+
 void CommsListField::commsAddFixedLengthOptInternal(StringsList& opts) const
 {
     auto obj = listDslObj();
@@ -606,49 +1471,21 @@ void CommsListField::commsAddFixedLengthOptInternal(StringsList& opts) const
 
 void CommsListField::commsAddCountPrefixOptInternal(StringsList& opts) const
 {
-    if ((m_commsExternalCountPrefixField == nullptr) && (m_commsMemberCountPrefixField == nullptr)) {
+    auto prefixName = commsDefPrefixTypeInternal(m_commsMemberCountPrefixField, m_commsExternalCountPrefixField);
+    if (prefixName.empty()) {
         return;
     }
 
-    std::string prefixName;
-    if (m_commsMemberCountPrefixField != nullptr) {
-        prefixName = "typename " + comms::className(name()) + strings::membersSuffixStr();
-        if (comms::isGlobalField(*this)) {
-            prefixName += "<TOpt>";
-        }
-
-        prefixName += "::" + comms::className(m_commsMemberCountPrefixField->field().name());
-    }
-    else {
-        assert(m_commsExternalCountPrefixField != nullptr);
-        prefixName = comms::scopeFor(m_commsExternalCountPrefixField->field(), generator(), true, true);
-        prefixName += "<TOpt> ";
-    }
-
     opts.push_back("comms::option::def::SequenceSizeFieldPrefix<" + prefixName + '>');
 }
 
 void CommsListField::commsAddLengthPrefixOptInternal(StringsList& opts) const
 {
-    if ((m_commsExternalLengthPrefixField == nullptr) && (m_commsMemberLengthPrefixField == nullptr)) {
+    auto prefixName = commsDefPrefixTypeInternal(m_commsMemberLengthPrefixField, m_commsExternalLengthPrefixField);
+    if (prefixName.empty()) {
         return;
     }
 
-    std::string prefixName;
-    if (m_commsMemberLengthPrefixField != nullptr) {
-        prefixName = "typename " + comms::className(name()) + strings::membersSuffixStr();
-        if (comms::isGlobalField(*this)) {
-            prefixName += "<TOpt>";
-        }
-
-        prefixName += "::" + comms::className(m_commsMemberLengthPrefixField->field().name());
-    }
-    else {
-        assert(m_commsExternalLengthPrefixField != nullptr);
-        prefixName = comms::scopeFor(m_commsExternalLengthPrefixField->field(), generator(), true, true);
-        prefixName += "<TOpt> ";
-    }
-
     opts.push_back("comms::option::def::SequenceSerLengthFieldPrefix<" + prefixName + '>');
 }
 
@@ -721,4 +1558,14 @@ void CommsListField::commsAddLengthForcingOptInternal(StringsList& opts) const
     }
 }
 
+void CommsListField::commsAddBulkSerialisationOptInternal(StringsList& opts) const
+{
+    if (commsBulkElementFieldInternal() == nullptr) {
+        return;
+    }
+
+    util::addToStrList("comms::option::def::HasCustomRead", opts);
+    util::addToStrList("comms::option::def::HasCustomWrite", opts);
+}
+
 } // namespace commsdsl2comms
@@ -30,6 +30,8 @@ class CommsListField final : public commsdsl::gen::ListField, public CommsField
 public:
     CommsListField(CommsGenerator& generator, commsdsl::parse::Field dslObj, commsdsl::gen::Elem* parent);
 
+    const CommsField* commsBulkVarElementField() const;
+
 protected:
     // Base overrides
     virtual bool prepareImpl() override;
@@ -42,18 +44,30 @@ protected:
     virtual IncludesList commsDefIncludesImpl() const override;
     virtual std::string commsDefMembersCodeImpl() const override;
     virtual std::string commsDefBaseClassImpl() const override;
+    virtual std::string commsDefPrivateCodeImpl() const override;
+    virtual std::string commsDefReadFuncBodyImpl() const override;
+    virtual std::string commsDefWriteFuncBodyImpl() const override;
     virtual std::string commsDefBundledReadPrepareFuncBodyImpl(const CommsFieldsList& siblings) const override;
     virtual std::string commsDefBundledRefreshFuncBodyImpl(const CommsFieldsList& siblings) const override;
     virtual bool commsIsLimitedCustomizableImpl() const override;
     virtual bool commsIsVersionDependentImpl() const override;
     virtual std::string commsMembersCustomizationOptionsBodyImpl(FieldOptsFunc fieldOptsFunc) const override;
     virtual StringsList commsExtraBareMetalDefaultOptionsImpl() const override;
+    virtual StringsList commsExtraBoundedBareMetalDefaultOptionsImpl() const override;
     virtual std::size_t commsMaxLengthImpl() const override;
     virtual std::string commsSizeAccessStrImpl(const std::string& accStr, const std::string& prefix) const override;
 
 private:
     std::string commsDefFieldOptsInternal() const;
     std::string commsDefElementInternal() const;
+    std::string commsDefPrefixTypeInternal(const CommsField* memberPrefix, const CommsField* externalPrefix) const;
+    std::string commsDefBulkReadElementsCodeInternal() const;
+    std::string commsDefBulkWriteElementsCodeInternal() const;
+    std::string commsDefBulkReadVarFuncBodyInternal() const;
+    std::string commsDefBulkWriteVarFuncBodyInternal() const;
+    std::string commsDefBulkReadVarElementsCodeInternal() const;
+    std::string commsDefBulkWriteVarElementsCodeInternal() const;
+    const CommsField* commsBulkElementFieldInternal() const;
 
     void commsAddFixedLengthOptInternal(StringsList& opts) const;
     void commsAddCountPrefixOptInternal(StringsList& opts) const;
@@ -61,6 +75,7 @@ private:
     void commsAddElemLengthPrefixOptInternal(StringsList& opts) const;
     void commsAddTermSuffixOptInternal(StringsList& opts) const;
     void commsAddLengthForcingOptInternal(StringsList& opts) const;
+    void commsAddBulkSerialisationOptInternal(StringsList& opts) const;
 
     CommsField* m_commsExternalElementField = nullptr;
     CommsField* m_commsMemberElementField = nullptr;
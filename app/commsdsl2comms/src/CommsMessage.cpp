@@ -24,6 +24,15 @@
 #include "commsdsl/gen/strings.h"
 #include "commsdsl/gen/util.h"
 
+#include "commsdsl/gen/RefField.h"
+#include "commsdsl/parse/BitfieldField.h"
+#include "commsdsl/parse/BundleField.h"
+#include "commsdsl/parse/DataField.h"
+#include "commsdsl/parse/IntField.h"
+#include "commsdsl/parse/ListField.h"
+#include "commsdsl/parse/OptionalField.h"
+#include "commsdsl/parse/RefField.h"
+
 #include <algorithm>
 #include <cassert>
 #include <fstream>
@@ -58,6 +67,104 @@ bool isOverrideCodeRequired(commsdsl::parse::OverrideType value)
         (value == commsdsl::parse::OverrideType_Extend);
 }
 
+commsdsl::parse::Field resolvedRefDslField(commsdsl::parse::Field field)
+{
+    if (field.kind() != commsdsl::parse::Field::Kind::Ref) {
+        return field;
+    }
+
+    return resolvedRefDslField(commsdsl::parse::RefField(field).field());
+}
+
+// Reports whether the read of the field can fail when enough data is available
+bool dslFieldReadMayFail(commsdsl::parse::Field field)
+{
+    if (field.isFailOnInvalid()) {
+        return true;
+    }
+
+    auto anyMemberFunc = 
+        [](const std::vector<commsdsl::parse::Field>& members)
+        {
+            return std::any_of(members.begin(), members.end(), &dslFieldReadMayFail);
+        };
+
+    switch (field.kind()) {
+        case commsdsl::parse::Field::Kind::Ref:
+            return dslFieldReadMayFail(commsdsl::parse::RefField(field).field());
+        case commsdsl::parse::Field::Kind::Bundle:
+            return anyMemberFunc(commsdsl::parse::BundleField(field).members());
+        case commsdsl::parse::Field::Kind::Bitfield:
+            return anyMemberFunc(commsdsl::parse::BitfieldField(field).members());
+        case commsdsl::parse::Field::Kind::Optional:
+            return dslFieldReadMayFail(commsdsl::parse::OptionalField(field).field());
+        case commsdsl::parse::Field::Kind::List: {
+            auto elemField = commsdsl::parse::ListField(field).elementField();
+            return elemField.valid() && dslFieldReadMayFail(elemField);
+        }
+        case commsdsl::parse::Field::Kind::Variant:
+            // Fails when none of the members can be read
+            return true;
+        default:
+            break;
+    }
+
+    return false;
+}
+
+// Serialisation details of the raw data field which payload can be referenced in place
+struct SegmentDataInfo
+{
+    std::size_t m_prefixLength = 0U;
+    std::intmax_t m_prefixSerOffset = 0;
+    bool m_prefixBigEndian = false;
+    std::size_t m_fixedLength = 0U;
+};
+
+bool segmentDataInfo(const CommsField& commsField, SegmentDataInfo& info)
+{
+    auto* field = &commsField.field();
+    while (field->dslObj().kind() == commsdsl::parse::Field::Kind::Ref) {
+        auto* commsRefField = dynamic_cast<const CommsField*>(field);
+        if ((commsRefField == nullptr) || commsRefField->commsHasCustomReadWrite()) {
+            return false;
+        }
+
+        field = static_cast<const commsdsl::gen::RefField*>(field)->referencedField();
+        if (field == nullptr) {
+            return false;
+        }
+    }
+
+    auto* commsDataField = dynamic_cast<const CommsField*>(field);
+    if ((field->dslObj().kind() != commsdsl::parse::Field::Kind::Data) ||
+        (commsDataField == nullptr) ||
+        commsDataField->commsHasCustomReadWrite() ||
+        commsDataField->commsHasCustomLength()) {
+        return false;
+    }
+
+    commsdsl::parse::DataField dataDslObj(field->dslObj());
+    info = SegmentDataInfo();
+    info.m_fixedLength = dataDslObj.fixedLength();
+    if ((!dataDslObj.hasLengthPrefixField()) || (!dataDslObj.detachedPrefixFieldName().empty())) {
+        return true;
+    }
+
+    auto prefixDslObj = resolvedRefDslField(dataDslObj.lengthPrefixField());
+    if ((prefixDslObj.kind() != commsdsl::parse::Field::Kind::Int) ||
+        (prefixDslObj.minLength() != prefixDslObj.maxLength()) ||
+        (sizeof(std::uint64_t) < prefixDslObj.minLength())) {
+        return false;
+    }
+
+    commsdsl::parse::IntField prefixIntDslObj(prefixDslObj);
+    info.m_prefixLength = prefixDslObj.minLength();
+    info.m_prefixSerOffset = prefixIntDslObj.serOffset();
+    info.m_prefixBigEndian = (prefixIntDslObj.endian() == commsdsl::parse::Endian_Big);
+    return true;
+}
+
 void readCustomCodeInternal(const std::string& codePath, std::string& code)
 {
     if (!util::isFileReadable(codePath)) {
@@ -233,6 +340,20 @@ std::string CommsMessage::commsBareMetalDefaultOptions() const
     return commsCustomizationOptionsInternal(&CommsField::commsBareMetalDefaultOptions, nullptr, true);    
 }
 
+std::string CommsMessage::commsBoundedBareMetalDefaultOptions() const
+{
+    return commsCustomizationOptionsInternal(&CommsField::commsBoundedBareMetalDefaultOptions, nullptr, true);
+}
+
+std::string CommsMessage::commsExplicitInstantiationBase(const std::string& msgBase, const std::string& opt) const
+{
+    auto scope = comms::scopeFor(*this, generator());
+    auto className = comms::className(dslObj().name());
+    assert(className.size() < scope.size());
+    scope.resize(scope.size() - className.size());
+    return commsBaseClassInternal(msgBase, opt, scope);
+}
+
 bool CommsMessage::prepareImpl()
 {
     if (!Base::prepareImpl()) {
@@ -463,6 +584,7 @@ bool CommsMessage::commsWriteDefInternal() const
         "#^#PROTECTED#$#\n"
         "#^#PRIVATE#$#\n"
         "};\n\n"
+        "#^#LAZY#$#\n"
         "#^#EXTEND#$#\n"
         "#^#APPEND#$#\n"
         "#^#NS_END#$#\n";
@@ -486,6 +608,7 @@ bool CommsMessage::commsWriteDefInternal() const
         {"PUBLIC", commsDefPublicInternal()},
         {"PROTECTED", commsDefProtectedInternal()},
         {"PRIVATE", commsDefPrivateInternal()},
+        {"LAZY", commsDefLazyInternal()},
         {"EXTEND", m_customCode.m_extend},
         {"APPEND", m_customCode.m_append}
     };
@@ -587,7 +710,35 @@ std::string CommsMessage::commsDefIncludesInternal() const
         includes.reserve(includes.size() + fIncludes.size());
         std::move(fIncludes.begin(), fIncludes.end(), std::back_inserter(includes));
     }
-    comms::prepareIncludeStatement(includes);    
+
+    if (commsFixedPrefixFieldsCountInternal() > 0U) {
+        includes.insert(includes.end(), {
+            "<cstddef>",
+            "<cstdint>",
+        });
+    }
+
+    if (commsIsWriteSegmentsSupportedInternal()) {
+        includes.insert(includes.end(), {
+            "<algorithm>",
+            "<cstddef>",
+            "<cstdint>",
+            "comms/util/access.h",
+        });
+    }
+
+    if (commsIsLazySupportedInternal()) {
+        includes.insert(includes.end(), {
+            "<algorithm>",
+            "<array>",
+            "<bitset>",
+            "<cstddef>",
+            "<cstdint>",
+            "<type_traits>",
+        });
+    }
+
+    comms::prepareIncludeStatement(includes);
     return util::strListToString(includes, "\n", "\n");
 }
 
@@ -663,21 +814,29 @@ std::string CommsMessage::commsDefDeprecatedDocInternal() const
 }
 
 std::string CommsMessage::commsDefBaseClassInternal() const
+{
+    return commsBaseClassInternal("TMsgBase", "TOpt", strings::emptyString());
+}
+
+std::string CommsMessage::commsBaseClassInternal(const std::string& msgBase, const std::string& opt, const std::string& scope) const
 {
     static const std::string Templ = 
         "comms::MessageBase<\n"
-        "    TMsgBase,\n"
+        "    #^#MSG_BASE#$#,\n"
         "    #^#CUSTOMIZATION_OPT#$#\n"
         "    comms::option::def::StaticNumIdImpl<#^#MESSAGE_ID#$#>,\n"
-        "    comms::option::def::FieldsImpl<typename #^#CLASS_NAME#$#Fields<TOpt>::All>,\n"
-        "    comms::option::def::MsgType<#^#CLASS_NAME#$##^#ORIG#$#<TMsgBase, TOpt> >,\n"
+        "    comms::option::def::FieldsImpl<typename #^#SCOPE#$##^#CLASS_NAME#$#Fields<#^#OPT#$#>::All>,\n"
+        "    comms::option::def::MsgType<#^#SCOPE#$##^#CLASS_NAME#$##^#ORIG#$#<#^#MSG_BASE#$#, #^#OPT#$#> >,\n"
         "    comms::option::def::HasName#^#COMMA#$#\n"
         "    #^#EXTRA_OPTIONS#$#\n"
         ">";    
 
     auto& gen = generator();
     util::ReplacementMap repl = {
-        {"CUSTOMIZATION_OPT", commsDefCustomizationOptInternal()},
+        {"MSG_BASE", msgBase},
+        {"OPT", opt},
+        {"SCOPE", scope},
+        {"CUSTOMIZATION_OPT", commsDefCustomizationOptInternal(opt)},
         {"MESSAGE_ID", comms::messageIdStrFor(*this, gen)},
         {"CLASS_NAME", comms::className(dslObj().name())},
         {"EXTRA_OPTIONS", commsDefExtraOptionsInternal()},
@@ -694,12 +853,12 @@ std::string CommsMessage::commsDefBaseClassInternal() const
     return util::processTemplate(Templ, repl);
 }
 
-std::string CommsMessage::commsDefCustomizationOptInternal() const
+std::string CommsMessage::commsDefCustomizationOptInternal(const std::string& opt) const
 {
     std::string result;
     if (commsIsCustomizableInternal()) {
         auto& gen = static_cast<const CommsGenerator&>(generator());
-        result = "typename TOpt::" + comms::scopeFor(*this, generator(), gen.commsHasMainNamespaceInOptions(), true) + ",";
+        result = "typename " + opt + "::" + comms::scopeFor(*this, generator(), gen.commsHasMainNamespaceInOptions(), true) + ",";
     }
     return result;
 }
@@ -737,11 +896,13 @@ std::string CommsMessage::commsDefPublicInternal() const
         "    #^#CONSTRUCT#$#\n"
         "    #^#ACCESS#$#\n"
         "    #^#ALIASES#$#\n"
+        "    #^#PEEK#$#\n"
         "    #^#LENGTH_CHECK#$#\n"
         "    #^#EXTRA#$#\n"
         "    #^#NAME#$#\n"
         "    #^#READ#$#\n"
         "    #^#WRITE#$#\n"
+        "    #^#WRITE_SEGMENTS#$#\n"
         "    #^#LENGTH#$#\n"
         "    #^#VALID#$#\n"
         "    #^#REFRESH#$#\n"
@@ -752,12 +913,14 @@ std::string CommsMessage::commsDefPublicInternal() const
         {"CONSTRUCT", commsDefConstructInternal()},
         {"ACCESS", commsDefFieldsAccessInternal()},
         {"ALIASES", commsDefFieldsAliasesInternal()},
+        {"PEEK", commsDefFieldsPeekInternal()},
         {"LENGTH_CHECK", commsDefLengthCheckInternal()},
         {"EXTRA", m_customCode.m_public},
         {"NAME", commsDefNameFuncInternal()},
         {"READ", commsDefReadFuncInternal()},
         {"WRITE", m_customCode.m_write},
-        {"LENGTH", m_customCode.m_length},
+        {"WRITE_SEGMENTS", commsDefWriteSegmentsFuncInternal()},
+        {"LENGTH", commsDefLengthFuncInternal()},
         {"VALID", commsDefValidFuncInternal()},
         {"REFRESH", commsDefRefreshFuncInternal()},
     };
@@ -945,6 +1108,57 @@ std::string CommsMessage::commsDefFieldsAliasesInternal() const
     return util::strListToString(result, "\n", "");
 }
 
+std::string CommsMessage::commsDefFieldsPeekInternal() const
+{
+    auto count = commsFixedPrefixFieldsCountInternal();
+    if (count == 0U) {
+        return strings::emptyString();
+    }
+
+    util::StringsList funcs;
+    auto msgClassName = comms::className(dslObj().name());
+    std::size_t offset = 0U;
+    for (auto idx = 0U; idx < count; ++idx) {
+        auto* f = m_commsFields[idx];
+        auto& name = f->field().dslObj().name();
+        auto length = f->commsMinLength();
+
+        static const std::string Templ = 
+            "/// @brief Serialisation offset of @ref #^#FIELD_REF#$# field\n"
+            "///     from the beginning of the message payload.\n"
+            "static constexpr std::size_t fieldOffset_#^#ACC_NAME#$#()\n"
+            "{\n"
+            "    return #^#OFFSET#$#;\n"
+            "}\n\n"
+            "/// @brief Read @ref #^#FIELD_REF#$# field directly from the\n"
+            "///     serialised message payload without creating the message object.\n"
+            "/// @details The validity of the field is not checked.\n"
+            "/// @param[in] buf Pointer to the beginning of the message payload, must\n"
+            "///     contain at least #^#END_OFFSET#$# bytes.\n"
+            "static Field_#^#ACC_NAME#$# peek_#^#ACC_NAME#$#(const std::uint8_t* buf)\n"
+            "{\n"
+            "    Field_#^#ACC_NAME#$# field;\n"
+            "    auto iter = buf + fieldOffset_#^#ACC_NAME#$#();\n"
+            "    auto es = field.read(iter, #^#LENGTH#$#);\n"
+            "    static_cast<void>(es);\n"
+            "    return field;\n"
+            "}\n";
+
+        util::ReplacementMap repl = {
+            {"FIELD_REF", msgClassName + strings::fieldsSuffixStr() + "::" + comms::className(name)},
+            {"ACC_NAME", comms::accessName(name)},
+            {"OFFSET", util::numToString(offset)},
+            {"LENGTH", util::numToString(length)},
+            {"END_OFFSET", std::to_string(offset + length)},
+        };
+
+        funcs.push_back(util::processTemplate(Templ, repl));
+        offset += length;
+    }
+
+    return util::strListToString(funcs, "\n", "");
+}
+
 std::string CommsMessage::commsDefLengthCheckInternal() const
 {
     bool hasCustomLength = 
@@ -1180,6 +1394,102 @@ std::string CommsMessage::commsDefReadFuncInternal() const
     return util::processTemplate(Templ, repl);
 }
 
+std::string CommsMessage::commsDefLengthFuncInternal() const
+{
+    std::string origCode;
+    do {
+        if ((!hasOrigCode(dslObj().lengthOverride())) || m_commsFields.empty()) {
+            break;
+        }
+
+        // The lengths are taken from the field types instantiated with TOpt,
+        // the customization may change them.
+        util::StringsList fixedMinLengths;
+        util::StringsList fixedMaxLengths;
+        util::StringsList varLengths;
+        for (auto* f : m_commsFields) {
+            auto accName = comms::accessName(f->field().dslObj().name());
+            bool fixed = 
+                (f->commsMinLength() == f->commsMaxLength()) &&
+                (!f->commsHasCustomLength()) &&
+                (!f->commsIsVersionDependent());
+
+            if (fixed) {
+                fixedMinLengths.push_back("Field_" + accName + "::minLength()");
+                fixedMaxLengths.push_back("Field_" + accName + "::maxLength()");
+                continue;
+            }
+
+            varLengths.push_back("field_" + accName + "().length()");
+        }
+
+        if (varLengths.empty()) {
+            static const std::string Templ = 
+                "/// @brief Generated length functionality.\n"
+                "/// @details All the fields have fixed length.\n"
+                "static constexpr std::size_t doLength#^#ORIG#$#()\n"
+                "{\n"
+                "    static_assert(Base::doMinLength() == Base::doMaxLength(), \"All the fields are expected to have fixed length\");\n"
+                "    return Base::doMinLength();\n"
+                "}\n";
+
+            util::ReplacementMap repl;
+            if (!m_customCode.m_length.empty()) {
+                repl["ORIG"] = strings::origSuffixStr();
+            }
+
+            origCode = util::processTemplate(Templ, repl);
+            break;
+        }
+
+        if (fixedMinLengths.empty()) {
+            // Nothing to precompute
+            break;
+        }
+
+        static const std::string Templ = 
+            "/// @brief Generated length functionality.\n"
+            "/// @details Sums up the lengths of only variable length fields.\n"
+            "std::size_t doLength#^#ORIG#$#() const\n"
+            "{\n"
+            "    static const std::size_t FixedLength =\n"
+            "        #^#MIN_LENGTHS#$#;\n"
+            "    static_assert(FixedLength == (#^#MAX_LENGTHS#$#), \"The fields are expected to have fixed length\");\n\n"
+            "    return\n"
+            "        FixedLength +\n"
+            "        #^#FIELDS#$#;\n"
+            "}\n";
+
+        util::ReplacementMap repl = {
+            {"MIN_LENGTHS", util::strListToString(fixedMinLengths, " +\n", "")},
+            {"MAX_LENGTHS", util::strListToString(fixedMaxLengths, " + ", "")},
+            {"FIELDS", util::strListToString(varLengths, " +\n", "")},
+        };
+
+        if (!m_customCode.m_length.empty()) {
+            repl["ORIG"] = strings::origSuffixStr();
+        }
+
+        origCode = util::processTemplate(Templ, repl);
+    } while (false);
+
+    if (m_customCode.m_length.empty()) {
+        return origCode;
+    }
+
+    static const std::string Templ = 
+       "#^#ORIG#$#\n"
+       "#^#CUSTOM#$#\n"
+    ;
+    
+    util::ReplacementMap repl = {
+        {"ORIG", std::move(origCode)},
+        {"CUSTOM", m_customCode.m_length},
+    };
+
+    return util::processTemplate(Templ, repl);
+}
+
 std::string CommsMessage::commsDefRefreshFuncInternal() const
 {
     std::string origCode;
@@ -1491,6 +1801,588 @@ std::string CommsMessage::commsDefValidFuncInternal() const
     return util::processTemplate(Templ, repl);
 }
 
+std::size_t CommsMessage::commsFixedPrefixFieldsCountInternal() const
+{
+    if (!m_customCode.m_read.empty()) {
+        return 0U;
+    }
+
+    assert(m_bundledReadPrepareCodes.size() == m_commsFields.size());
+    std::size_t count = 0U;
+    for (; count < m_commsFields.size(); ++count) {
+        auto* f = m_commsFields[count];
+        bool fixedLength = 
+            (f->commsMinLength() == f->commsMaxLength()) &&
+            (!f->commsHasCustomLength()) &&
+            (!f->commsIsVersionDependent()) &&
+            m_bundledReadPrepareCodes[count].empty();
+
+        if (!fixedLength) {
+            break;
+        }
+    }
+
+    return count;
+}
+
+bool CommsMessage::commsIsWriteSegmentsSupportedInternal() const
+{
+    if (m_commsFields.empty() || (!m_customCode.m_write.empty())) {
+        return false;
+    }
+
+    bool hasVersionDependent = 
+        std::any_of(
+            m_commsFields.begin(), m_commsFields.end(),
+            [](auto* f)
+            {
+                return f->commsIsVersionDependent();
+            });
+
+    if (hasVersionDependent) {
+        return false;
+    }
+
+    return 
+        std::any_of(
+            m_commsFields.begin(), m_commsFields.end(),
+            [](auto* f)
+            {
+                SegmentDataInfo info;
+                return segmentDataInfo(*f, info);
+            });
+}
+
+std::string CommsMessage::commsDefWriteSegmentsFuncInternal() const
+{
+    if (!commsIsWriteSegmentsSupportedInternal()) {
+        return strings::emptyString();
+    }
+
+    static const std::string Templ = 
+        "/// @brief Serialise message payload as a sequence of memory segments.\n"
+        "/// @details The raw data of #^#DATA_FIELDS#$# is referenced in place\n"
+        "///     instead of being copied, all other bytes are written into the\n"
+        "///     provided scratch buffer. The referenced memory remains valid as long\n"
+        "///     as the message object is neither modified nor destructed, which allows\n"
+        "///     passing the segments to the scatter/gather I/O (@b writev(), @b sendmsg()).\n"
+        "/// @param[in] scratch Buffer for the bytes that are not referenced in place.\n"
+        "/// @param[in] scratchLen Size of the scratch buffer.\n"
+        "/// @param[in] handler Functor invoked for every segment in order with\n"
+        "///     <b>(const std::uint8_t* data, std::size_t len)</b> parameters.\n"
+        "/// @return Status of the operation.\n"
+        "template <typename THandler>\n"
+        "comms::ErrorStatus writeSegments(std::uint8_t* scratch, std::size_t scratchLen, THandler&& handler) const\n"
+        "{\n"
+        "    auto* iter = scratch;\n"
+        "    auto* segBeg = scratch;\n"
+        "    auto* end = scratch + scratchLen;\n"
+        "    auto es = comms::ErrorStatus::Success;\n"
+        "    static_cast<void>(es);\n\n"
+        "    #^#FIELDS#$#\n"
+        "    if (segBeg != iter) {\n"
+        "        handler(static_cast<const std::uint8_t*>(segBeg), static_cast<std::size_t>(iter - segBeg));\n"
+        "    }\n\n"
+        "    return comms::ErrorStatus::Success;\n"
+        "}\n";
+
+    static const std::string FieldTempl = 
+        "es = field_#^#NAME#$#().write(iter, static_cast<std::size_t>(end - iter));\n"
+        "if (es != comms::ErrorStatus::Success) {\n"
+        "    return es;\n"
+        "}\n";
+
+    static const std::string DataTempl = 
+        "// Raw data of \"#^#NAME#$#\" is referenced in place\n"
+        "{\n"
+        "    auto& data = field_#^#NAME#$#().value();\n"
+        "    auto dataLen = static_cast<std::size_t>(data.size());\n"
+        "    #^#FIXED_LEN#$#\n"
+        "    #^#PREFIX#$#\n"
+        "    if (0U < dataLen) {\n"
+        "        if (segBeg != iter) {\n"
+        "            handler(static_cast<const std::uint8_t*>(segBeg), static_cast<std::size_t>(iter - segBeg));\n"
+        "        }\n\n"
+        "        handler(static_cast<const std::uint8_t*>(&(*data.begin())), dataLen);\n"
+        "        segBeg = iter;\n"
+        "    }\n"
+        "    #^#PADDING#$#\n"
+        "}\n";
+
+    static const std::string FixedLenTempl = 
+        "auto padLen = (dataLen < #^#LEN#$#) ? (#^#LEN#$# - dataLen) : 0U;\n"
+        "dataLen = std::min(dataLen, static_cast<std::size_t>(#^#LEN#$#));\n";
+
+    static const std::string PaddingTempl = 
+        "if (static_cast<std::size_t>(end - iter) < padLen) {\n"
+        "    return comms::ErrorStatus::BufferOverflow;\n"
+        "}\n\n"
+        "std::fill_n(iter, padLen, static_cast<std::uint8_t>(0U));\n"
+        "iter += padLen;\n";
+
+    static const std::string PrefixTempl = 
+        "#^#RANGE_CHECK#$#\n"
+        "if (static_cast<std::size_t>(end - iter) < #^#LEN#$#) {\n"
+        "    return comms::ErrorStatus::BufferOverflow;\n"
+        "}\n\n"
+        "comms::util::writeData<#^#LEN#$#>(static_cast<#^#TYPE#$#>(#^#VALUE#$#), iter, comms::traits::endian::#^#ENDIAN#$#());\n";
+
+    util::StringsList fields;
+    util::StringsList dataFields;
+    for (auto* f : m_commsFields) {
+        auto& name = f->field().dslObj().name();
+        util::ReplacementMap repl = {
+            {"NAME", comms::accessName(name)},
+        };
+
+        SegmentDataInfo info;
+        if (!segmentDataInfo(*f, info)) {
+            fields.push_back(util::processTemplate(FieldTempl, repl));
+            continue;
+        }
+
+        dataFields.push_back("@ref " + comms::className(dslObj().name()) + strings::fieldsSuffixStr() + "::" + comms::className(name));
+        if (info.m_fixedLength != 0U) {
+            util::ReplacementMap fixedRepl = {
+                {"LEN", util::numToString(info.m_fixedLength)},
+            };
+
+            repl["FIXED_LEN"] = util::processTemplate(FixedLenTempl, fixedRepl);
+            repl["PADDING"] = PaddingTempl;
+        }
+
+        if (info.m_prefixLength != 0U) {
+            std::string type = "std::uint64_t";
+            if (info.m_prefixLength <= sizeof(std::uint8_t)) {
+                type = "std::uint8_t";
+            }
+            else if (info.m_prefixLength <= sizeof(std::uint16_t)) {
+                type = "std::uint16_t";
+            }
+            else if (info.m_prefixLength <= sizeof(std::uint32_t)) {
+                type = "std::uint32_t";
+            }
+
+            std::string value = "dataLen";
+            util::StringsList conds;
+            if (info.m_prefixSerOffset != 0) {
+                value = "prefixValue";
+                conds.push_back("prefixValue < 0");
+            }
+
+            if (info.m_prefixLength < sizeof(std::uintmax_t)) {
+                auto maxValue = (static_cast<std::uintmax_t>(1U) << (info.m_prefixLength * 8U)) - 1U;
+                conds.push_back(util::numToString(maxValue) + " < static_cast<std::uintmax_t>(" + value + ")");
+            }
+
+            std::string rangeCheck;
+            if (info.m_prefixSerOffset != 0) {
+                rangeCheck = 
+                    "auto prefixValue = static_cast<std::intmax_t>(dataLen) + (" + 
+                    util::numToString(info.m_prefixSerOffset) + ");\n";
+            }
+
+            if (!conds.empty()) {
+                rangeCheck += 
+                    "if (" + ((conds.size() == 1U) ? conds.front() : ("(" + util::strListToString(conds, ") || (", "") + ")")) + ") {\n"
+                    "    // The length doesn't fit into the prefix\n"
+                    "    return comms::ErrorStatus::BufferOverflow;\n"
+                    "}\n";
+            }
+
+            util::ReplacementMap prefixRepl = {
+                {"LEN", util::numToString(info.m_prefixLength)},
+                {"TYPE", std::move(type)},
+                {"VALUE", std::move(value)},
+                {"ENDIAN", info.m_prefixBigEndian ? "Big" : "Little"},
+                {"RANGE_CHECK", std::move(rangeCheck)},
+            };
+
+            repl["PREFIX"] = util::processTemplate(PrefixTempl, prefixRepl);
+        }
+
+        fields.push_back(util::processTemplate(DataTempl, repl));
+    }
+
+    util::ReplacementMap repl = {
+        {"FIELDS", util::strListToString(fields, "\n", "\n")},
+        {"DATA_FIELDS", util::strListToString(dataFields, ", ", "")},
+    };
+
+    return util::processTemplate(Templ, repl);
+}
+
+bool CommsMessage::commsIsLazySupportedInternal() const
+{
+    if (m_commsFields.empty()) {
+        return false;
+    }
+
+    auto obj = dslObj();
+    if (obj.isFailOnInvalid() || obj.readCond().valid()) {
+        // All the fields must be decoded during read
+        return false;
+    }
+
+    bool hasCustomCode = 
+        (!m_customCode.m_read.empty()) ||
+        (!m_customCode.m_write.empty()) ||
+        (!m_customCode.m_refresh.empty()) ||
+        (!m_customCode.m_length.empty()) ||
+        (!m_customCode.m_valid.empty()) ||
+        (!m_internalConstruct.empty()) ||
+        (!m_customConstruct.empty());
+
+    if (hasCustomCode) {
+        return false;
+    }
+
+    auto hasCodeFunc = 
+        [](const std::string& code)
+        {
+            return !code.empty();
+        };
+
+    if (std::any_of(m_bundledReadPrepareCodes.begin(), m_bundledReadPrepareCodes.end(), hasCodeFunc) ||
+        std::any_of(m_bundledRefreshCodes.begin(), m_bundledRefreshCodes.end(), hasCodeFunc)) {
+        // Fields depend on one another
+        return false;
+    }
+
+    return 
+        std::none_of(
+            m_commsFields.begin(), m_commsFields.end(),
+            [](auto* f)
+            {
+                if (f->commsIsVersionDependent() || f->commsHasCustomLength()) {
+                    return true;
+                }
+
+                if (f->commsMinLength() != f->commsMaxLength()) {
+                    // Decoded during the read, errors are reported
+                    return false;
+                }
+
+                // The decode on first access must not reject the data accepted by the read
+                return f->commsHasCustomReadWrite() || dslFieldReadMayFail(f->field().dslObj());
+            });
+}
+
+std::string CommsMessage::commsDefLazyInternal() const
+{
+    if (!commsIsLazySupportedInternal()) {
+        return strings::emptyString();
+    }
+
+    static const std::string Templ = 
+        "/// @brief Lazily decoded flavour of @ref #^#CLASS_NAME#$# message.\n"
+        "/// @details Contains the same fields as @ref #^#CLASS_NAME#$#, but its read\n"
+        "///     operation only records the boundaries of the fields within the input\n"
+        "///     buffer. The fixed length fields are decoded on their first access via\n"
+        "///     the relevant @b field_*() member function, while the variable length ones\n"
+        "///     are decoded during the read to determine their boundaries. Until any of the\n"
+        "///     fields is accessed via the non-const member function the write operation\n"
+        "///     copies the original bytes.\n"
+        "///     @n The read iterator must be a <b>const std::uint8_t*</b> pointer to the\n"
+        "///     input buffer, which needs to stay valid for as long as the message object\n"
+        "///     is used.\n"
+        "///     @n Direct access to the fields via @b fields() member function bypasses\n"
+        "///     the lazy decoding, use @ref decodeAll() prior to it.\n"
+        "///     @n The class is not part of any input messages bundle, hence it is never\n"
+        "///     created by the message factories or the frames. Instantiate it explicitly\n"
+        "///     and read it via its @b read() member function after the frame has\n"
+        "///     reported the message ID, or pass it by reference to the @b read()\n"
+        "///     member function of the frame (instead of the smart pointer to the message).\n"
+        "///     The boundaries of the fixed length fields are determined by the field\n"
+        "///     types defined with the provided @b TOpt, all such fields must remain\n"
+        "///     of fixed length.\n"
+        "/// @tparam TMsgBase Base (interface) class.\n"
+        "/// @tparam TOpt Extra options\n"
+        "/// @headerfile #^#MESSAGE_HEADERFILE#$#\n"
+        "template <typename TMsgBase, typename TOpt = #^#OPTIONS#$#>\n"
+        "class #^#CLASS_NAME#$#Lazy : public\n"
+        "    #^#BASE#$#\n"
+        "{\n"
+        "    // Redefinition of the base class type\n"
+        "    using Base =\n"
+        "        #^#BASE#$#;\n"
+        "\n"
+        "public:\n"
+        "    #^#ACCESS#$#\n"
+        "    #^#NAME#$#\n"
+        "    #^#DECODE_ALL#$#\n"
+        "    #^#READ#$#\n"
+        "    /// @brief Write the original bytes unless the message was modified.\n"
+        "    template <typename TIter>\n"
+        "    comms::ErrorStatus doWrite(TIter& iter, std::size_t len) const\n"
+        "    {\n"
+        "        if (m_modified || (m_data == nullptr)) {\n"
+        "            const_cast<#^#CLASS_NAME#$#Lazy&>(*this).decodeAll();\n"
+        "            return Base::doWrite(iter, len);\n"
+        "        }\n\n"
+        "        auto rawLen = m_offsets[FieldIdx_numOfValues];\n"
+        "        if (len < rawLen) {\n"
+        "            return comms::ErrorStatus::BufferOverflow;\n"
+        "        }\n\n"
+        "        iter = std::copy_n(m_data, rawLen, iter);\n"
+        "        return comms::ErrorStatus::Success;\n"
+        "    }\n\n"
+        "    /// @brief Get serialisation length.\n"
+        "    std::size_t doLength() const\n"
+        "    {\n"
+        "        if (m_modified || (m_data == nullptr)) {\n"
+        "            const_cast<#^#CLASS_NAME#$#Lazy&>(*this).decodeAll();\n"
+        "            return Base::doLength();\n"
+        "        }\n\n"
+        "        return m_offsets[FieldIdx_numOfValues];\n"
+        "    }\n\n"
+        "    /// @brief Check validity of all the fields.\n"
+        "    bool doValid() const\n"
+        "    {\n"
+        "        if (const_cast<#^#CLASS_NAME#$#Lazy&>(*this).decodeAll() != comms::ErrorStatus::Success) {\n"
+        "            return false;\n"
+        "        }\n\n"
+        "        return Base::doValid();\n"
+        "    }\n\n"
+        "    /// @brief Refresh all the fields.\n"
+        "    bool doRefresh()\n"
+        "    {\n"
+        "        decodeAll();\n"
+        "        bool updated = Base::doRefresh();\n"
+        "        m_modified = m_modified || updated;\n"
+        "        return updated;\n"
+        "    }\n\n"
+        "private:\n"
+        "    template <std::size_t TIdx>\n"
+        "    comms::ErrorStatus decodeFieldInternal()\n"
+        "    {\n"
+        "        if ((m_data == nullptr) || m_decoded.test(TIdx)) {\n"
+        "            return comms::ErrorStatus::Success;\n"
+        "        }\n\n"
+        "        m_decoded.set(TIdx);\n"
+        "        auto fieldIter = m_data + m_offsets[TIdx];\n"
+        "        auto es = std::get<TIdx>(Base::fields()).read(fieldIter, m_offsets[TIdx + 1U] - m_offsets[TIdx]);\n"
+        "        COMMS_ASSERT(es == comms::ErrorStatus::Success); // Only fields which read cannot fail are decoded lazily\n"
+        "        return es;\n"
+        "    }\n\n"
+        "    const std::uint8_t* m_data = nullptr;\n"
+        "    std::array<std::size_t, static_cast<std::size_t>(FieldIdx_numOfValues) + 1U> m_offsets = {};\n"
+        "    std::bitset<FieldIdx_numOfValues> m_decoded;\n"
+        "    bool m_modified = false;\n"
+        "};\n"
+        ;
+
+    auto& gen = generator();
+    util::ReplacementMap repl = {
+        {"CLASS_NAME", comms::className(dslObj().name())},
+        {"MESSAGE_HEADERFILE", comms::relHeaderPathFor(*this, gen)},
+        {"OPTIONS", comms::scopeForOptions(strings::defaultOptionsClassStr(), gen)},
+        {"BASE", commsDefLazyBaseClassInternal()},
+        {"ACCESS", commsDefLazyFieldsAccessInternal()},
+        {"NAME", commsDefNameFuncInternal()},
+        {"DECODE_ALL", commsDefLazyDecodeAllFuncInternal()},
+        {"READ", commsDefLazyReadFuncInternal()},
+    };
+
+    return util::processTemplate(Templ, repl);
+}
+
+std::string CommsMessage::commsDefLazyBaseClassInternal() const
+{
+    static const std::string Templ = 
+        "comms::MessageBase<\n"
+        "    TMsgBase,\n"
+        "    #^#CUSTOMIZATION_OPT#$#\n"
+        "    comms::option::def::StaticNumIdImpl<#^#MESSAGE_ID#$#>,\n"
+        "    comms::option::def::FieldsImpl<typename #^#CLASS_NAME#$#Fields<TOpt>::All>,\n"
+        "    comms::option::def::MsgType<#^#CLASS_NAME#$#Lazy<TMsgBase, TOpt> >,\n"
+        "    comms::option::def::HasName,\n"
+        "    comms::option::def::HasCustomRefresh\n"
+        ">";    
+
+    util::ReplacementMap repl = {
+        {"CUSTOMIZATION_OPT", commsDefCustomizationOptInternal("TOpt")},
+        {"MESSAGE_ID", comms::messageIdStrFor(*this, generator())},
+        {"CLASS_NAME", comms::className(dslObj().name())},
+    };
+
+    return util::processTemplate(Templ, repl);
+}
+
+std::string CommsMessage::commsDefLazyFieldsAccessInternal() const
+{
+    static const std::string Templ = 
+        "/// @brief Allow access to internal fields.\n"
+        "enum FieldIdx\n"
+        "{\n"
+        "    #^#IDX#$#\n"
+        "    FieldIdx_numOfValues ///< number of available fields\n"
+        "};\n\n"
+        "#^#TYPES#$#\n\n"
+        "#^#FUNCS#$#\n"
+        ;
+
+    util::StringsList indices;
+    util::StringsList types;
+    util::StringsList funcs;
+
+    auto msgClassName = comms::className(dslObj().name());
+    for (auto* f : m_commsFields) {
+        auto& name = f->field().dslObj().name();
+        auto accName = comms::accessName(name);
+        auto fieldRef = msgClassName + strings::fieldsSuffixStr() + "::" + comms::className(name);
+        indices.push_back("FieldIdx_" + accName + ", ///< index of @ref " + fieldRef + " field");
+        types.push_back(
+            "/// @brief Type of @ref " + fieldRef + " field.\n"
+            "using Field_" + accName + " = typename std::tuple_element<FieldIdx_" + accName + ", typename Base::AllFields>::type;");
+
+        static const std::string FuncTempl = 
+            "/// @brief Access to @ref #^#FIELD_REF#$# field, decoding it on first access.\n"
+            "/// @details Marks the message as modified, the write operation will\n"
+            "///     serialise the fields instead of copying the original bytes.\n"
+            "Field_#^#ACC_NAME#$#& field_#^#ACC_NAME#$#()\n"
+            "{\n"
+            "    decodeFieldInternal<FieldIdx_#^#ACC_NAME#$#>();\n"
+            "    m_modified = true;\n"
+            "    return std::get<FieldIdx_#^#ACC_NAME#$#>(Base::fields());\n"
+            "}\n\n"
+            "/// @brief Const access to @ref #^#FIELD_REF#$# field, decoding it on first access.\n"
+            "const Field_#^#ACC_NAME#$#& field_#^#ACC_NAME#$#() const\n"
+            "{\n"
+            "    const_cast<#^#CLASS_NAME#$#Lazy&>(*this).template decodeFieldInternal<FieldIdx_#^#ACC_NAME#$#>();\n"
+            "    return std::get<FieldIdx_#^#ACC_NAME#$#>(Base::fields());\n"
+            "}\n";
+
+        util::ReplacementMap repl = {
+            {"FIELD_REF", fieldRef},
+            {"ACC_NAME", accName},
+            {"CLASS_NAME", msgClassName},
+        };
+
+        funcs.push_back(util::processTemplate(FuncTempl, repl));
+    }
+
+    util::ReplacementMap repl = {
+        {"IDX", util::strListToString(indices, "\n", "")},
+        {"TYPES", util::strListToString(types, "\n\n", "")},
+        {"FUNCS", util::strListToString(funcs, "\n", "")},
+    };
+
+    return util::processTemplate(Templ, repl);
+}
+
+std::string CommsMessage::commsDefLazyReadFuncInternal() const
+{
+    static const std::string Templ = 
+        "/// @brief Record boundaries of the fields.\n"
+        "/// @details Decodes only the variable length fields.\n"
+        "template <typename TIter>\n"
+        "comms::ErrorStatus doRead(TIter& iter, std::size_t len)\n"
+        "{\n"
+        "    static_assert(std::is_same<typename std::decay<TIter>::type, const std::uint8_t*>::value,\n"
+        "        \"Lazy read requires pointer to the input buffer as an iterator\");\n\n"
+        "    m_data = nullptr;\n"
+        "    m_decoded.reset();\n"
+        "    m_modified = false;\n"
+        "    std::size_t offset = 0U;\n"
+        "    #^#FIELDS#$#\n"
+        "    m_offsets[FieldIdx_numOfValues] = offset;\n"
+        "    m_data = iter;\n"
+        "    iter += offset;\n"
+        "    return comms::ErrorStatus::Success;\n"
+        "}\n"
+        ;
+
+    static const std::string LenCheckStr = 
+        "if (len < offset) {\n"
+        "    return comms::ErrorStatus::NotEnoughData;\n"
+        "}\n";
+
+    util::StringsList fields;
+    bool lenCheckRequired = false;
+    for (auto* f : m_commsFields) {
+        auto accName = comms::accessName(f->field().dslObj().name());
+        auto minLength = f->commsMinLength();
+        std::string code = "m_offsets[FieldIdx_" + accName + "] = offset;\n";
+        if (minLength == f->commsMaxLength()) {
+            // The length is taken from the field type, it depends on the provided options
+            code += 
+                "static_assert(Field_" + accName + "::minLength() == Field_" + accName + "::maxLength(),\n"
+                "    \"The lazily decoded field must have fixed length\");\n"
+                "offset += Field_" + accName + "::minLength();\n";
+            fields.push_back(std::move(code));
+            lenCheckRequired = lenCheckRequired || (minLength != 0U);
+            continue;
+        }
+
+        if (lenCheckRequired) {
+            fields.push_back(LenCheckStr);
+            lenCheckRequired = false;
+        }
+
+        static const std::string FieldTempl = 
+            "#^#CODE#$#"
+            "{\n"
+            "    auto fieldIter = iter + offset;\n"
+            "    auto es = std::get<FieldIdx_#^#ACC_NAME#$#>(Base::fields()).read(fieldIter, len - offset);\n"
+            "    if (es != comms::ErrorStatus::Success) {\n"
+            "        return es;\n"
+            "    }\n\n"
+            "    m_decoded.set(FieldIdx_#^#ACC_NAME#$#);\n"
+            "    offset = static_cast<std::size_t>(fieldIter - iter);\n"
+            "}\n";
+
+        util::ReplacementMap repl = {
+            {"CODE", std::move(code)},
+            {"ACC_NAME", accName},
+        };
+
+        fields.push_back(util::processTemplate(FieldTempl, repl));
+    }
+
+    if (lenCheckRequired) {
+        fields.push_back(LenCheckStr);
+    }
+
+    util::ReplacementMap repl = {
+        {"FIELDS", util::strListToString(fields, "\n", "")},
+    };
+
+    return util::processTemplate(Templ, repl);
+}
+
+std::string CommsMessage::commsDefLazyDecodeAllFuncInternal() const
+{
+    static const std::string Templ = 
+        "/// @brief Decode all the fields that haven't been accessed yet.\n"
+        "/// @details Doesn't mark the message as modified.\n"
+        "/// @return Status of the first failed decode operation.\n"
+        "comms::ErrorStatus decodeAll()\n"
+        "{\n"
+        "    comms::ErrorStatus statuses[] = {\n"
+        "        #^#DECODES#$#\n"
+        "    };\n\n"
+        "    for (auto es : statuses) {\n"
+        "        if (es != comms::ErrorStatus::Success) {\n"
+        "            return es;\n"
+        "        }\n"
+        "    }\n\n"
+        "    return comms::ErrorStatus::Success;\n"
+        "}\n"
+        ;
+
+    util::StringsList decodes;
+    for (auto* f : m_commsFields) {
+        decodes.push_back("decodeFieldInternal<FieldIdx_" + comms::accessName(f->field().dslObj().name()) + ">()");
+    }
+
+    util::ReplacementMap repl = {
+        {"DECODES", util::strListToString(decodes, ",\n", "")},
+    };
+
+    return util::processTemplate(Templ, repl);
+}
+
 CommsMessage::StringsList CommsMessage::commsClientExtraCustomizationOptionsInternal() const
 {
     auto sender = dslObj().sender();
@@ -48,6 +48,8 @@ public:
     std::string commsServerDefaultOptions() const;
     std::string commsDataViewDefaultOptions() const;
     std::string commsBareMetalDefaultOptions() const;
+    std::string commsBoundedBareMetalDefaultOptions() const;
+    std::string commsExplicitInstantiationBase(const std::string& msgBase, const std::string& opt) const;
 
 protected:
     virtual bool prepareImpl() override;
@@ -93,16 +95,19 @@ private:
     std::string commsDefDocDetailsInternal() const;
     std::string commsDefDeprecatedDocInternal() const;
     std::string commsDefBaseClassInternal() const;
-    std::string commsDefCustomizationOptInternal() const;
+    std::string commsBaseClassInternal(const std::string& msgBase, const std::string& opt, const std::string& scope) const;
+    std::string commsDefCustomizationOptInternal(const std::string& opt) const;
     std::string commsDefExtraOptionsInternal() const;
     std::string commsDefPublicInternal() const;
     std::string commsDefProtectedInternal() const;
     std::string commsDefPrivateInternal() const;
     std::string commsDefFieldsAccessInternal() const;
     std::string commsDefFieldsAliasesInternal() const;
+    std::string commsDefFieldsPeekInternal() const;
     std::string commsDefLengthCheckInternal() const;
     std::string commsDefNameFuncInternal() const;
     std::string commsDefReadFuncInternal() const;
+    std::string commsDefLengthFuncInternal() const;
     std::string commsDefRefreshFuncInternal() const;
     std::string commsDefPrivateConstructInternal() const;
     bool commsIsCustomizableInternal() const;
@@ -114,6 +119,15 @@ private:
     std::string commsDefReadConditionsCodeInternal() const;
     std::string commsDefOrigValidCodeInternal() const;
     std::string commsDefValidFuncInternal() const;
+    std::size_t commsFixedPrefixFieldsCountInternal() const;
+    bool commsIsLazySupportedInternal() const;
+    std::string commsDefLazyInternal() const;
+    std::string commsDefLazyBaseClassInternal() const;
+    std::string commsDefLazyFieldsAccessInternal() const;
+    std::string commsDefLazyReadFuncInternal() const;
+    std::string commsDefLazyDecodeAllFuncInternal() const;
+    bool commsIsWriteSegmentsSupportedInternal() const;
+    std::string commsDefWriteSegmentsFuncInternal() const;
 
     StringsList commsClientExtraCustomizationOptionsInternal() const;
     StringsList commsServerExtraCustomizationOptionsInternal() const;
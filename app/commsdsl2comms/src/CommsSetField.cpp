@@ -65,7 +65,10 @@ bool CommsSetField::writeImpl() const
 CommsSetField::IncludesList CommsSetField::commsCommonIncludesImpl() const
 {
     IncludesList result = {
-        "<type_traits>"
+        "<cstdint>",
+        "<cstring>",
+        "<type_traits>",
+        "<utility>"
     };
 
     return result;
@@ -76,11 +79,13 @@ std::string CommsSetField::commsCommonCodeBodyImpl() const
     static const std::string Templ = {
         "#^#NAME_FUNC#$#\n"
         "#^#BIT_NAME_FUNC#$#\n"        
+        "#^#BIT_IDX_FROM_NAME_FUNC#$#\n"
     };
 
     util::ReplacementMap repl = {
         {"NAME_FUNC", commsCommonNameFuncCode()},
         {"BIT_NAME_FUNC", commsCommonBitNameFuncCodeInternal()},
+        {"BIT_IDX_FROM_NAME_FUNC", commsCommonBitIdxFromNameFuncCodeInternal()},
     };
 
     return util::processTemplate(Templ, repl);
@@ -118,11 +123,13 @@ std::string CommsSetField::commsDefPublicCodeImpl() const
 {
     static const std::string Templ = 
         "#^#BITS_ACCESS#$#\n"
-        "#^#BIT_NAME#$#";
+        "#^#BIT_NAME#$#\n"
+        "#^#BIT_IDX_FROM_NAME#$#";
 
     util::ReplacementMap repl = {
         {"BITS_ACCESS", commsDefBitsAccessCodeInternal()},
         {"BIT_NAME", commsDefBitNameFuncCodeInternal()},
+        {"BIT_IDX_FROM_NAME", commsDefBitIdxFromNameFuncCodeInternal()},
     };
 
     return util::processTemplate(Templ, repl);
@@ -200,19 +207,19 @@ std::string CommsSetField::commsDefValidFuncBodyImpl() const
         }
 
             static const std::string VersionBothCondTempl =
-                "if (((Base::getVersion() < #^#FROM_VERSION#$#) || (#^#UNTIL_VERSION#$# <= Base::getVersion())) && \n"
+                "if (((#^#VERSION#$# < #^#FROM_VERSION#$#) || (#^#UNTIL_VERSION#$# <= #^#VERSION#$#)) && \n"
                 "    ((Base::getValue() & #^#BITS_MASK#$#) != #^#VALUE_MASK#$#)) {\n"
                 "    return false;\n"
                 "}\n";
 
             static const std::string VersionFromCondTempl =
-                "if ((Base::getVersion() < #^#FROM_VERSION#$#) &&\n"
+                "if ((#^#VERSION#$# < #^#FROM_VERSION#$#) &&\n"
                 "    ((Base::getValue() & #^#BITS_MASK#$#) != #^#VALUE_MASK#$#)) {\n"
                 "    return false;\n"
                 "}\n";
 
             static const std::string VersionUntilCondTempl =
-                "if ((#^#UNTIL_VERSION#$# <= Base::getVersion()) &&\n"
+                "if ((#^#UNTIL_VERSION#$# <= #^#VERSION#$#) &&\n"
                 "    ((Base::getValue() & #^#BITS_MASK#$#) != #^#VALUE_MASK#$#)) {\n"
                 "    return false;\n"
                 "}\n";
@@ -232,6 +239,7 @@ std::string CommsSetField::commsDefValidFuncBodyImpl() const
             {"VALUE_MASK", util::numToString(info.second.m_reservedValue, true)},
             {"FROM_VERSION", util::numToString(std::get<0>(info.first))},
             {"UNTIL_VERSION", util::numToString(std::get<1>(info.first))},
+            {"VERSION", commsDefVersionAccessStr()},
         };
         conditions.push_back(util::processTemplate(*condTempl, repl));
     }
@@ -307,14 +315,15 @@ std::string CommsSetField::commsDefValidFuncBodyImpl() const
             }
 
             static const std::string Templ =
-                "if ((#^#FROM_VERSION#$# <= Base::getVersion()) &&\n"
-                "    (Base::getVersion() < #^#UNTIL_VERSION#$#)) {\n"
+                "if ((#^#FROM_VERSION#$# <= #^#VERSION#$#) &&\n"
+                "    (#^#VERSION#$# < #^#UNTIL_VERSION#$#)) {\n"
                 "    return false;\n"
                 "}";
 
             util::ReplacementMap repl = {
                 {"FROM_VERSION", util::numToString(r.first)},
                 {"UNTIL_VERSION", util::numToString(r.second)},
+                {"VERSION", commsDefVersionAccessStr()},
             };
 
             extraConds.push_back(util::processTemplate(Templ, repl));
@@ -528,6 +537,39 @@ std::string CommsSetField::commsCommonBitNameFuncCodeInternal() const
     return util::processTemplate(Templ, repl);
 }
 
+std::string CommsSetField::commsCommonBitIdxFromNameFuncCodeInternal() const
+{
+    auto obj = setDslObj();
+    auto& bits = obj.bits();
+    auto& gen = generator();
+
+    NameLookupList names;
+    names.reserve(bits.size() * 2U);
+    for (auto& b : bits) {
+        if ((MaxBits <= b.second.m_idx) ||
+            (!gen.doesElementExist(b.second.m_sinceVersion, b.second.m_deprecatedSince, false))) {
+            continue;
+        }
+
+        commsAddNameLookupElem(names, b.first, util::numToString(static_cast<std::uintmax_t>(b.second.m_idx)));
+    }
+
+    for (auto& b : bits) {
+        if ((MaxBits <= b.second.m_idx) ||
+            (!gen.doesElementExist(b.second.m_sinceVersion, b.second.m_deprecatedSince, false))) {
+            continue;
+        }
+
+        commsAddNameLookupElem(names, b.second.m_displayName, util::numToString(static_cast<std::uintmax_t>(b.second.m_idx)));
+    }
+
+    return 
+        commsNameLookupFuncCode(
+            names, "bitIdxFromName", "std::size_t",
+            "index of the bit of\n///     @ref " + comms::scopeFor(*this, gen) + " field",
+            "bit", "bit index");
+}
+
 std::string CommsSetField::commsDefFieldOptsInternal() const
 {
     util::StringsList opts;
@@ -702,6 +744,23 @@ std::string CommsSetField::commsDefBitNameFuncCodeInternal() const
     return util::processTemplate(Templ, repl);
 }
 
+std::string CommsSetField::commsDefBitIdxFromNameFuncCodeInternal() const
+{
+    static const std::string Templ =
+        "/// @brief Retrieve index of the bit by its name.\n"
+        "/// @see @ref #^#COMMON#$#::bitIdxFromName().\n"
+        "static std::pair<BitIdx, bool> bitIdxFromName(const char* name, std::size_t len)\n"
+        "{\n"
+        "    auto result = #^#COMMON#$#::bitIdxFromName(name, len);\n"
+        "    return std::make_pair(static_cast<BitIdx>(result.first), result.second);\n"
+        "}\n";
+
+    util::ReplacementMap repl = {
+        {"COMMON", comms::commonScopeFor(*this, generator())}
+    };
+    return util::processTemplate(Templ, repl);
+}
+
 void CommsSetField::commsAddLengthOptInternal(commsdsl::gen::util::StringsList& opts) const
 {
     auto bitLength = dslObj().bitLength();
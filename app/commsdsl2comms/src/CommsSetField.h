@@ -50,9 +50,11 @@ protected:
 
 private:
     std::string commsCommonBitNameFuncCodeInternal() const;
+    std::string commsCommonBitIdxFromNameFuncCodeInternal() const;
     std::string commsDefFieldOptsInternal() const;
     std::string commsDefBitsAccessCodeInternal() const;
     std::string commsDefBitNameFuncCodeInternal() const;
+    std::string commsDefBitIdxFromNameFuncCodeInternal() const;
 
     void commsAddLengthOptInternal(commsdsl::gen::util::StringsList& opts) const;
     void commsAddDefaultValueOptInternal(commsdsl::gen::util::StringsList& opts) const;
@@ -329,6 +329,21 @@ CommsStringField::StringsList CommsStringField::commsExtraBareMetalDefaultOption
         };    
 }
 
+CommsStringField::StringsList CommsStringField::commsExtraBoundedBareMetalDefaultOptionsImpl() const
+{
+    auto obj = stringDslObj();
+    if (obj.fixedLength() != 0U) {
+        return StringsList();
+    }
+
+    std::uintmax_t capacity = 0U;
+    if (obj.hasLengthPrefixField()) {
+        capacity = commsBoundedStorageMaxPrefixValue(obj.lengthPrefixField());
+    }
+
+    return commsBoundedStorageOpts(capacity);
+}
+
 std::string CommsStringField::commsSizeAccessStrImpl(const std::string& accStr, const std::string& prefix) const
 {
     static_cast<void>(accStr);
@@ -16,6 +16,7 @@
 #include "CommsVariantField.h"
 
 #include "CommsBundleField.h"
+#include "CommsEnumField.h"
 #include "CommsGenerator.h"
 #include "CommsIntField.h"
 #include "CommsRefField.h"
@@ -27,8 +28,9 @@
 #include <algorithm>
 #include <cassert>
 #include <iterator>
+#include <limits>
+#include <map>
 #include <numeric>
-#include <set>
 
 namespace util = commsdsl::gen::util;
 namespace comms = commsdsl::gen::comms;
@@ -42,93 +44,313 @@ namespace
 
 constexpr std::size_t MaxMembersSupportedByComms = 120;    
 
-bool intIsValidPropKeyInternal(const CommsIntField& intField)
+const CommsField* getReferenceFieldInternal(const CommsField* field)
 {
-    auto obj = intField.field().dslObj();
-    if (!obj.isFailOnInvalid()) {
-        return false;
+    while (field->field().dslObj().kind() == commsdsl::parse::Field::Kind::Ref) {
+        auto& refField = static_cast<const CommsRefField&>(*field);
+        field = dynamic_cast<decltype(field)>(refField.referencedField());
+        assert(field != nullptr);
     }
 
-    if (obj.isPseudo()) {
-        return false;
+    return field;
+}
+
+struct PropKeyRange
+{
+    std::intmax_t m_min = 0;
+    std::intmax_t m_max = 0;
+};
+
+using PropKeyRangesList = std::vector<PropKeyRange>;
+
+struct PropKeyInfo
+{
+    const CommsField* m_member = nullptr;
+    const CommsField* m_field = nullptr;
+    std::string m_type;
+    std::string m_valueType;
+    PropKeyRangesList m_ranges;
+    unsigned m_hexWidth = 0U;
+    bool m_unsigned = false;
+    bool m_enum = false;
+    bool m_singleDefault = false;
+};
+
+constexpr std::uintmax_t MaxPropKeyCaseLabelsPerRange = 8U;
+
+bool propKeyLessInternal(std::intmax_t first, std::intmax_t second, bool isUnsigned)
+{
+    if (isUnsigned) {
+        return static_cast<std::uintmax_t>(first) < static_cast<std::uintmax_t>(second);
     }
 
-    auto intDslObj = commsdsl::parse::IntField(obj);
-    auto& validRanges = intDslObj.validRanges();
-    if (validRanges.size() != 1U) {
-        return false;
+    return first < second;
+}
+
+void propKeyNormaliseRangesInternal(PropKeyRangesList& ranges, bool isUnsigned)
+{
+    std::sort(
+        ranges.begin(), ranges.end(),
+        [isUnsigned](auto& first, auto& second)
+        {
+            return propKeyLessInternal(first.m_min, second.m_min, isUnsigned);
+        });
+
+    PropKeyRangesList result;
+    result.reserve(ranges.size());
+    for (auto& r : ranges) {
+        if (result.empty()) {
+            result.push_back(r);
+            continue;
+        }
+
+        auto& last = result.back();
+        auto nextAfterLast = static_cast<std::intmax_t>(static_cast<std::uintmax_t>(last.m_max) + 1U);
+        bool adjacent =
+            propKeyLessInternal(last.m_max, nextAfterLast, isUnsigned) &&
+            (r.m_min == nextAfterLast);
+
+        if ((!adjacent) && propKeyLessInternal(last.m_max, r.m_min, isUnsigned)) {
+            result.push_back(r);
+            continue;
+        }
+
+        if (propKeyLessInternal(last.m_max, r.m_max, isUnsigned)) {
+            last.m_max = r.m_max;
+        }
     }
 
-    auto& r = validRanges.front();
-    if (r.m_min != r.m_max) {
-        return false;
+    ranges = std::move(result);
+}
+
+bool propKeyRangesOverlapInternal(const PropKeyRangesList& first, const PropKeyRangesList& second, bool isUnsigned)
+{
+    for (auto& f : first) {
+        for (auto& s : second) {
+            if ((!propKeyLessInternal(f.m_max, s.m_min, isUnsigned)) &&
+                (!propKeyLessInternal(s.m_max, f.m_min, isUnsigned))) {
+                return true;
+            }
+        }
     }
 
-    if (r.m_min != intDslObj.defaultValue()) {
-        return false;
+    return false;
+}
+
+PropKeyRange propKeyTypeLimitsInternal(const std::string& valueType)
+{
+    static const std::map<std::string, PropKeyRange> Map = {
+        {"std::int8_t", {std::numeric_limits<std::int8_t>::min(), std::numeric_limits<std::int8_t>::max()}},
+        {"std::uint8_t", {0, std::numeric_limits<std::uint8_t>::max()}},
+        {"std::int16_t", {std::numeric_limits<std::int16_t>::min(), std::numeric_limits<std::int16_t>::max()}},
+        {"std::uint16_t", {0, std::numeric_limits<std::uint16_t>::max()}},
+        {"std::int32_t", {std::numeric_limits<std::int32_t>::min(), std::numeric_limits<std::int32_t>::max()}},
+        {"std::uint32_t", {0, std::numeric_limits<std::uint32_t>::max()}},
+        {"std::int64_t", {std::numeric_limits<std::int64_t>::min(), std::numeric_limits<std::int64_t>::max()}},
+        {"std::uint64_t", {0, static_cast<std::intmax_t>(std::numeric_limits<std::uint64_t>::max())}},
+    };
+
+    auto iter = Map.find(valueType);
+    if (iter == Map.end()) {
+        static constexpr bool Should_not_happen = false;
+        static_cast<void>(Should_not_happen);
+        assert(Should_not_happen);
+        return PropKeyRange{std::numeric_limits<std::intmax_t>::min(), std::numeric_limits<std::intmax_t>::max()};
     }
 
-    return true; 
-}    
+    return iter->second;
+}
 
-const CommsField* bundleGetValidPropKeyInternal(const CommsBundleField& bundle)
+CommsField::StringsList propKeyCustomOptsInternal(const CommsField* field)
 {
-    auto& members = bundle.commsMembers();
-    if (members.empty()) {
-        return nullptr;
+    CommsField::StringsList opts;
+    while (true) {
+        field->commsAddCustomizationOption(opts);
+        if (field->field().dslObj().kind() != commsdsl::parse::Field::Kind::Ref) {
+            break;
+        }
+
+        auto& refField = static_cast<const CommsRefField&>(*field);
+        field = dynamic_cast<decltype(field)>(refField.referencedField());
+        assert(field != nullptr);
     }
 
-    auto& first = members.front();
-    if (first->field().dslObj().kind() != commsdsl::parse::Field::Kind::Int) {
-        return nullptr;
+    return opts;
+}
+
+// Returns false when the value validity depends on the version and cannot be
+// decided by the generated switch, "exists" reports whether the value is
+// relevant to the generated code.
+bool propKeyValueExistsInternal(
+    const CommsField& field, 
+    bool validCheckVersion, 
+    unsigned sinceVersion, 
+    unsigned deprecatedSince,
+    bool& exists)
+{
+    auto& gen = field.field().generator();
+    exists = gen.doesElementExist(sinceVersion, deprecatedSince, !validCheckVersion);
+    if (!exists) {
+        return true;
     }
 
-    auto& keyField = static_cast<const CommsIntField&>(*first);
-    if (!intIsValidPropKeyInternal(keyField)) {
-        return nullptr;
+    return (!validCheckVersion) || (!gen.isElementOptional(sinceVersion, deprecatedSince, false));
+}
+
+bool intGetPropKeyInfoInternal(const CommsIntField& intField, const CommsField::StringsList& customOpts, PropKeyInfo& info)
+{
+    auto obj = intField.field().dslObj();
+    auto intDslObj = commsdsl::parse::IntField(obj);
+    bool validCheckVersion = 
+        intField.field().generator().schemaOf(intField.field()).versionDependentCode() &&
+        intDslObj.validCheckVersion();
+
+    for (auto& r : intDslObj.validRanges()) {
+        bool exists = false;
+        if (!propKeyValueExistsInternal(intField, validCheckVersion, r.m_sinceVersion, r.m_deprecatedSince, exists)) {
+            return false;
+        }
+
+        if (!exists) {
+            continue;
+        }
+
+        info.m_ranges.push_back(PropKeyRange{r.m_min, r.m_max});
     }
 
-    // Valid only if there is no non-default read
-    if (keyField.commsHasGeneratedReadCode()) {
-        return nullptr;
+    info.m_type = intField.commsVariantPropKeyType(customOpts);
+    info.m_valueType = comms::cppIntTypeFor(intDslObj.type(), intDslObj.maxLength());
+    info.m_hexWidth = static_cast<unsigned>(intDslObj.maxLength() * 2U);
+    info.m_unsigned = intField.isUnsignedType();
+    propKeyNormaliseRangesInternal(info.m_ranges, info.m_unsigned);
+    info.m_singleDefault = 
+        (info.m_ranges.size() == 1U) &&
+        (info.m_ranges.front().m_min == info.m_ranges.front().m_max) &&
+        (info.m_ranges.front().m_min == intDslObj.defaultValue());
+    return true;
+}
+
+bool enumGetPropKeyInfoInternal(const CommsEnumField& enumField, const CommsField::StringsList& customOpts, PropKeyInfo& info)
+{
+    auto obj = enumField.field().dslObj();
+    auto enumDslObj = commsdsl::parse::EnumField(obj);
+    bool validCheckVersion = 
+        enumField.field().generator().schemaOf(enumField.field()).versionDependentCode() &&
+        enumDslObj.validCheckVersion();
+
+    for (auto& v : enumDslObj.values()) {
+        bool exists = false;
+        if (!propKeyValueExistsInternal(enumField, validCheckVersion, v.second.m_sinceVersion, v.second.m_deprecatedSince, exists)) {
+            return false;
+        }
+
+        if (!exists) {
+            continue;
+        }
+
+        info.m_ranges.push_back(PropKeyRange{v.second.m_value, v.second.m_value});
     }
 
-    return first;
+    info.m_type = enumField.commsVariantPropKeyType(customOpts);
+    info.m_valueType = comms::cppIntTypeFor(enumDslObj.type(), enumDslObj.maxLength());
+    info.m_hexWidth = static_cast<unsigned>(enumDslObj.maxLength() * 2U);
+    info.m_unsigned = enumField.isUnsignedUnderlyingType();
+    info.m_enum = true;
+    propKeyNormaliseRangesInternal(info.m_ranges, info.m_unsigned);
+    return true;
 }
 
-std::string propKeyTypeInternal(const CommsField& field)
+bool bundleGetPropKeyInfoInternal(const CommsBundleField& bundle, PropKeyInfo& info)
 {
-    assert(field.field().dslObj().kind() == commsdsl::parse::Field::Kind::Int);
+    auto& members = bundle.commsMembers();
+    if (members.empty()) {
+        return false;
+    }
+
+    auto* first = members.front();
+    auto* keyField = getReferenceFieldInternal(first);
+
+    // Valid only if there is no non-default read
+    if (first->commsHasGeneratedReadCode() || keyField->commsHasGeneratedReadCode()) {
+        return false;
+    }
 
-    auto& keyField = static_cast<const CommsIntField&>(field);
-    return keyField.commsVariantPropKeyType();
+    auto obj = keyField->field().dslObj();
+    if ((!obj.isFailOnInvalid()) || (obj.isPseudo())) {
+        return false;
+    }
+
+    info.m_member = first;
+    info.m_field = keyField;
+
+    bool result = false;
+    auto kind = obj.kind();
+    auto customOpts = propKeyCustomOptsInternal(first);
+    if (kind == commsdsl::parse::Field::Kind::Int) {
+        result = intGetPropKeyInfoInternal(static_cast<const CommsIntField&>(*keyField), customOpts, info);
+    }
+    else if (kind == commsdsl::parse::Field::Kind::Enum) {
+        result = enumGetPropKeyInfoInternal(static_cast<const CommsEnumField&>(*keyField), customOpts, info);
+    }
+
+    if ((!result) || (info.m_ranges.empty())) {
+        return false;
+    }
+
+    auto limits = propKeyTypeLimitsInternal(info.m_valueType);
+    auto& front = info.m_ranges.front();
+    if ((info.m_ranges.size() == 1U) && (front.m_min == limits.m_min) && (front.m_max == limits.m_max)) {
+        // Any value is valid
+        return false;
+    }
+
+    return true;
 }
 
-std::string propKeyValueStrInternal(const CommsField& field)
+bool memberGetPropKeyInfoInternal(const CommsField& member, PropKeyInfo& info)
 {
-    assert(field.field().dslObj().kind() == commsdsl::parse::Field::Kind::Int);
+    auto* memPtr = getReferenceFieldInternal(&member);
+    if (memPtr->field().dslObj().kind() != commsdsl::parse::Field::Kind::Bundle) {
+        return false;
+    }
 
-    auto& keyField = static_cast<const CommsIntField&>(field);
-    return keyField.commsVariantPropKeyValueStr();
+    return bundleGetPropKeyInfoInternal(static_cast<const CommsBundleField&>(*memPtr), info);
 }
 
-bool propKeysEquivalent(const CommsField& first, const CommsField& second)
+std::string propKeyValueStrInternal(std::intmax_t value, const PropKeyInfo& info)
 {
-    assert(first.field().dslObj().kind() == commsdsl::parse::Field::Kind::Int);
-    assert(second.field().dslObj().kind() == commsdsl::parse::Field::Kind::Int);
+    if (!info.m_unsigned) {
+        return util::numToString(value);
+    }
 
-    return static_cast<const CommsIntField&>(first).commsVariantIsPropKeyEquivalent(static_cast<const CommsIntField&>(second));
+    auto val = static_cast<std::uintmax_t>(value);
+    auto decValue = util::numToString(val);
+    auto hexValue = util::numToString(val, info.m_hexWidth);
+
+    static const std::string Templ = 
+        "#^#DEC#$# /* #^#HEX#$# */";
+
+    util::ReplacementMap repl = {
+        {"DEC", std::move(decValue)},
+        {"HEX", std::move(hexValue)},
+    };
+    return util::processTemplate(Templ, repl);
 }
 
-const CommsField* getReferenceFieldInternal(const CommsField* field)
+std::string propKeyRangeCondInternal(const PropKeyRange& range, const PropKeyInfo& info)
 {
-    while (field->field().dslObj().kind() == commsdsl::parse::Field::Kind::Ref) {
-        auto& refField = static_cast<const CommsRefField&>(*field);
-        field = dynamic_cast<decltype(field)>(refField.referencedField());
-        assert(field != nullptr);
+    auto limits = propKeyTypeLimitsInternal(info.m_valueType);
+    util::StringsList conds;
+    if (range.m_min != limits.m_min) {
+        conds.push_back("(" + propKeyValueStrInternal(range.m_min, info) + " <= commonKeyField.getValue())");
     }
 
-    return field;
+    if (range.m_max != limits.m_max) {
+        conds.push_back("(commonKeyField.getValue() <= " + propKeyValueStrInternal(range.m_max, info) + ")");
+    }
+
+    assert(!conds.empty());
+    return util::strListToString(conds, " && ", "");
 }
 
 } // namespace 
@@ -201,6 +423,11 @@ CommsVariantField::IncludesList CommsVariantField::commsDefIncludesImpl() const
         result.reserve(result.size() + incList.size());
         std::move(incList.begin(), incList.end(), std::back_inserter(result));
     } 
+
+    if (commsOptimizedReadHasEnumKeyInternal()) {
+        result.push_back("<type_traits>");
+    }
+
     return result;
 }
 
@@ -319,104 +546,32 @@ std::string CommsVariantField::commsDefPrivateCodeImpl() const
 
 std::string CommsVariantField::commsDefReadFuncBodyImpl() const
 {
-    if (m_optimizedReadKey.empty()) {
+    if (m_optimizedReadGroups.empty()) {
         return strings::emptyString();
     }
 
-    std::string keyFieldType;
-    StringsList cases;
-    bool hasDefault = false;
-    for (auto* memPtr : m_commsMembers) {
-        auto* m = getReferenceFieldInternal(memPtr);
-        assert(m->field().dslObj().kind() == commsdsl::parse::Field::Kind::Bundle);
-        auto& bundle = static_cast<const CommsBundleField&>(*m);
-        auto& bundleMembers = bundle.commsMembers();
-        assert(!bundleMembers.empty());
-        auto* first = bundleMembers.front();
-        assert(first->field().dslObj().kind() == commsdsl::parse::Field::Kind::Int);
-        auto& keyField = static_cast<const CommsIntField&>(*first);
-        auto bundleAccName = comms::accessName(memPtr->field().dslObj().name());
-        auto keyAccName = comms::accessName(keyField.field().dslObj().name());
-
-        if ((memPtr != m_commsMembers.back()) ||
-            (keyField.commsVariantIsValidPropKey())) {
-            auto valStr = keyField.commsVariantPropKeyValueStr();
-
-            static const std::string Templ =
-                "case #^#VAL#$#:\n"
-                "    {\n"
-                "        auto& field_#^#BUNDLE_NAME#$# = initField_#^#BUNDLE_NAME#$#();\n"
-                "        COMMS_ASSERT(field_#^#BUNDLE_NAME#$#.field_#^#KEY_NAME#$#().getValue() == commonKeyField.getValue());\n"
-                "        #^#VERSION_ASSIGN#$#\n"
-                "        return field_#^#BUNDLE_NAME#$#.template readFrom<1>(iter, len);\n"
-                "    }";
-
-            util::ReplacementMap repl = {
-                {"VAL", std::move(valStr)},
-                {"BUNDLE_NAME", bundleAccName},
-                {"KEY_NAME", keyAccName},
-            };
+    bool catchAllRead = (m_optimizedReadCatchAll != nullptr) && (!m_optimizedReadCatchAllSharesKey);
+    bool multiGroup = (1U < m_optimizedReadGroups.size()) || catchAllRead;
 
-            if (m->commsIsVersionDependent()) {
-                auto assignStr = "field_" + bundleAccName + ".setVersion(Base::getVersion());";
-                repl["VERSION_ASSIGN"] = std::move(assignStr);
-            }
-            cases.push_back(util::processTemplate(Templ, repl));
-            continue;
-        }
-
-        // Last "catch all" element
-        assert(memPtr == m_commsMembers.back());
-
-        static const std::string Templ =
-            "default:\n"
-            "    initField_#^#BUNDLE_NAME#$#().field_#^#KEY_NAME#$#().setValue(commonKeyField.getValue());\n"
-            "    #^#VERSION_ASSIGN#$#\n"
-            "    return accessField_#^#BUNDLE_NAME#$#().template readFrom<1>(iter, len);";
-
-        util::ReplacementMap repl = {
-            {"BUNDLE_NAME", bundleAccName},
-            {"KEY_NAME", keyAccName},
-        };
-
-        if (m->commsIsVersionDependent()) {
-            auto assignStr = "field_" + bundleAccName + ".setVersion(Base::getVersion());";
-            repl["VERSION_ASSIGN"] = std::move(assignStr);
-        }
-
-        cases.push_back(util::processTemplate(Templ, repl));
-        hasDefault = true;
-    }
-
-    if (!hasDefault) {
-        static const std::string DefaultBreakStr =
-            "default:\n"
-            "    break;";
-        cases.push_back(DefaultBreakStr);
+    util::StringsList groups;
+    for (auto& g : m_optimizedReadGroups) {
+        groups.push_back(commsDefOptimizedReadGroupCodeInternal(g));
     }
 
     static const std::string Templ =
         "reset();\n"
         "#^#VERSION_DEP#$#\n"
-        "using CommonKeyField=\n"
-        "    #^#KEY_FIELD_TYPE#$#;\n"
-        "CommonKeyField commonKeyField;\n\n"
         "auto origIter = iter;\n"
-        "auto es = commonKeyField.read(iter, len);\n"
-        "if (es != comms::ErrorStatus::Success) {\n"
-        "    return es;\n"
-        "}\n\n"
-        "auto consumedLen = static_cast<std::size_t>(std::distance(origIter, iter));\n"
-        "COMMS_ASSERT(consumedLen <= len);\n"
-        "len -= consumedLen;\n\n"
-        "switch (commonKeyField.getValue()) {\n"
-        "    #^#CASES#$#\n"
-        "};\n\n"
-        "return comms::ErrorStatus::InvalidMsgData;\n";
+        "#^#ORIG_LEN#$#\n"
+        "#^#ES#$#\n\n"
+        "#^#GROUPS#$#\n"
+        "#^#CATCH_ALL#$#\n"
+        "#^#RETURN#$#\n";
 
     util::ReplacementMap repl = {
-        {"KEY_FIELD_TYPE", m_optimizedReadKey},
-        {"CASES", util::strListToString(cases, "\n", "")},
+        {"GROUPS", util::strListToString(groups, "\n", "")},
+        {"ES", "auto es = comms::ErrorStatus::InvalidMsgData;"},
+        {"RETURN", "return es;"},
     };
 
     if (commsIsVersionDependent()) {
@@ -425,6 +580,19 @@ std::string CommsVariantField::commsDefReadFuncBodyImpl() const
         repl["VERSION_DEP"] = CheckStr;
     }
 
+    if (multiGroup) {
+        repl["ORIG_LEN"] = "auto origLen = len;";
+    }
+
+    if (catchAllRead) {
+        repl["CATCH_ALL"] = commsDefOptimizedReadCatchAllCodeInternal();
+        repl["RETURN"].clear();
+    }
+
+    if ((!multiGroup) && (m_optimizedReadCatchAll != nullptr)) {
+        repl["RETURN"].clear();
+    }
+
     return util::processTemplate(Templ, repl);    
 }
 
@@ -610,7 +778,7 @@ bool CommsVariantField::commsPrepareInternal()
         }
     }
 
-    m_optimizedReadKey = commsOptimizedReadKeyInternal();
+    commsPrepareOptimizedReadInternal();
     return true;
 }
 
@@ -1052,58 +1220,310 @@ std::string CommsVariantField::commsDefSelectFieldCodeInternal() const
 
 void CommsVariantField::commsAddCustomReadOptInternal(StringsList& opts) const
 {
-    if (!m_optimizedReadKey.empty()) {
+    if (!m_optimizedReadGroups.empty()) {
         util::addToStrList("comms::option::def::HasCustomRead", opts);
     }
 }
 
-std::string CommsVariantField::commsOptimizedReadKeyInternal() const
+void CommsVariantField::commsPrepareOptimizedReadInternal()
 {
-    std::string result;
     if (m_commsMembers.size() <= 1U) {
-        return result;
+        return;
     }
 
-    const CommsField* propKey = nullptr;
-    std::set<std::string> keyValues;
+    OptimizedReadGroupsList groups;
+    PropKeyRangesList groupRanges;
+    const CommsField* catchAll = nullptr;
 
     for (auto* m : m_commsMembers) {
-        const auto* memPtr = getReferenceFieldInternal(m);
-        if (memPtr->field().dslObj().kind() != commsdsl::parse::Field::Kind::Bundle) {
-            return result;
+        PropKeyInfo info;
+        if (!memberGetPropKeyInfoInternal(*m, info)) {
+            if (m != m_commsMembers.back()) {
+                return;
+            }
+
+            // last "catch all" element
+            catchAll = m;
+            continue;
         }
 
-        auto& bundle = static_cast<const CommsBundleField&>(*memPtr);
-        auto* propKeyTmp = bundleGetValidPropKeyInternal(bundle);
-        bool validPropKey = (propKeyTmp != nullptr);
-        if ((!validPropKey) && (m != m_commsMembers.back())) {
-            return result;
+        // Members are grouped by the key type while preserving their order,
+        // the values of the keys within the group must be unique.
+        bool newGroup = 
+            groups.empty() ||
+            (groups.back().m_keyType != info.m_type) ||
+            propKeyRangesOverlapInternal(groupRanges, info.m_ranges, info.m_unsigned);
+
+        if (newGroup) {
+            groups.push_back(OptimizedReadGroup{info.m_type, CommsFieldsList()});
+            groupRanges.clear();
         }
 
-        if (!validPropKey) {
-            // last "catch all" element
-            continue;
+        groups.back().m_members.push_back(m);
+        groupRanges.insert(groupRanges.end(), info.m_ranges.begin(), info.m_ranges.end());
+    }
+
+    if (groups.empty()) {
+        return;
+    }
+
+    m_optimizedReadGroups = std::move(groups);
+    m_optimizedReadCatchAll = catchAll;
+    if (catchAll == nullptr) {
+        return;
+    }
+
+    auto* catchAllPtr = getReferenceFieldInternal(catchAll);
+    if (catchAllPtr->field().dslObj().kind() != commsdsl::parse::Field::Kind::Bundle) {
+        return;
+    }
+
+    auto& catchAllMembers = static_cast<const CommsBundleField&>(*catchAllPtr).commsMembers();
+    if (catchAllMembers.empty()) {
+        return;
+    }
+
+    auto* catchAllKey = getReferenceFieldInternal(catchAllMembers.front());
+    if ((catchAllKey->field().dslObj().kind() != commsdsl::parse::Field::Kind::Int) ||
+        (catchAllMembers.front()->commsHasGeneratedReadCode()) ||
+        (catchAllKey->commsHasGeneratedReadCode())) {
+        return;
+    }
+
+    m_optimizedReadCatchAllSharesKey = 
+        (static_cast<const CommsIntField*>(catchAllKey)->commsVariantPropKeyType(propKeyCustomOptsInternal(catchAllMembers.front())) == m_optimizedReadGroups.back().m_keyType);
+}
+
+std::string CommsVariantField::commsDefOptimizedReadGroupCodeInternal(const OptimizedReadGroup& group) const
+{
+    util::StringsList cases;
+    util::StringsList rangeChecks;
+    for (auto* memPtr : group.m_members) {
+        PropKeyInfo info;
+        bool validKey = memberGetPropKeyInfoInternal(*memPtr, info);
+        static_cast<void>(validKey);
+        assert(validKey);
+        auto* m = getReferenceFieldInternal(memPtr);
+        auto bundleAccName = comms::accessName(memPtr->field().dslObj().name());
+        auto keyAccName = comms::accessName(info.m_member->field().dslObj().name());
+
+        util::StringsList body;
+        body.push_back("auto& field_" + bundleAccName + " = initField_" + bundleAccName + "();");
+        if (info.m_singleDefault) {
+            body.push_back(
+                "COMMS_ASSERT(field_" + bundleAccName + ".field_" + keyAccName + "().getValue() == commonKeyField.getValue());");
         }
+        else if (info.m_enum) {
+            static const std::string Templ = 
+                "using KeyField = typename std::decay<decltype(field_#^#BUNDLE_NAME#$#.field_#^#KEY_NAME#$#())>::type;\n"
+                "field_#^#BUNDLE_NAME#$#.field_#^#KEY_NAME#$#().setValue(static_cast<typename KeyField::ValueType>(commonKeyField.getValue()));";
 
-        assert(propKeyTmp != nullptr);
-        auto insertResult = keyValues.insert(propKeyValueStrInternal(*propKeyTmp));
-        if (!insertResult.second) {
-            // The same key value has been inserted
-            return result;
+            util::ReplacementMap repl = {
+                {"BUNDLE_NAME", bundleAccName},
+                {"KEY_NAME", keyAccName},
+            };
+            body.push_back(util::processTemplate(Templ, repl));
+        }
+        else {
+            body.push_back("field_" + bundleAccName + ".field_" + keyAccName + "().setValue(commonKeyField.getValue());");
         }
 
-        if (propKey == nullptr) {
-            propKey = propKeyTmp;
-            continue;
+        if (m->commsIsVersionDependent()) {
+            body.push_back("field_" + bundleAccName + ".setVersion(Base::getVersion());");
         }
 
-        if (!propKeysEquivalent(*propKey, *propKeyTmp)) {
-            return result;
+        static const std::string ReadTempl = 
+            "auto memIter = iter;\n"
+            "auto memEs = field_#^#BUNDLE_NAME#$#.template readFrom<1>(memIter, len);\n"
+            "if (memEs == comms::ErrorStatus::Success) {\n"
+            "    iter = memIter;\n"
+            "    return memEs;\n"
+            "}\n\n"
+            "if (es != comms::ErrorStatus::NotEnoughData) {\n"
+            "    es = memEs;\n"
+            "}";
+
+        util::ReplacementMap readRepl = {
+            {"BUNDLE_NAME", bundleAccName},
+        };
+        body.push_back(util::processTemplate(ReadTempl, readRepl));
+        auto bodyStr = util::strListToString(body, "\n", "");
+
+        util::StringsList labels;
+        util::StringsList conds;
+        for (auto& r : info.m_ranges) {
+            auto span = static_cast<std::uintmax_t>(r.m_max) - static_cast<std::uintmax_t>(r.m_min);
+            if (MaxPropKeyCaseLabelsPerRange <= span) {
+                conds.push_back(propKeyRangeCondInternal(r, info));
+                continue;
+            }
+
+            for (auto idx = 0U; idx <= span; ++idx) {
+                auto val = static_cast<std::intmax_t>(static_cast<std::uintmax_t>(r.m_min) + idx);
+                labels.push_back("case " + propKeyValueStrInternal(val, info) + ":");
+            }
+        }
+
+        if (!labels.empty()) {
+            static const std::string Templ =
+                "#^#LABELS#$#\n"
+                "    {\n"
+                "        #^#BODY#$#\n"
+                "    }\n"
+                "    break;";
+
+            util::ReplacementMap repl = {
+                {"LABELS", util::strListToString(labels, "\n", "")},
+                {"BODY", bodyStr},
+            };
+            cases.push_back(util::processTemplate(Templ, repl));
+        }
+
+        if (1U < conds.size()) {
+            for (auto& c : conds) {
+                c = '(' + c + ')';
+            }
+        }
+
+        if (!conds.empty()) {
+            static const std::string Templ =
+                "if (#^#COND#$#) {\n"
+                "    #^#BODY#$#\n"
+                "}\n";
+
+            util::ReplacementMap repl = {
+                {"COND", util::strListToString(conds, " ||\n    ", "")},
+                {"BODY", bodyStr},
+            };
+            rangeChecks.push_back(util::processTemplate(Templ, repl));
         }
     }
 
-    result = propKeyTypeInternal(*propKey);
-    return result;
+    std::string catchAllStr;
+    if ((m_optimizedReadCatchAll != nullptr) && 
+        (m_optimizedReadCatchAllSharesKey) &&
+        (&group == &m_optimizedReadGroups.back())) {
+        auto* m = getReferenceFieldInternal(m_optimizedReadCatchAll);
+        assert(m->field().dslObj().kind() == commsdsl::parse::Field::Kind::Bundle);
+        auto& bundleMembers = static_cast<const CommsBundleField*>(m)->commsMembers();
+        assert(!bundleMembers.empty());
+
+        static const std::string Templ =
+            "auto& field_#^#BUNDLE_NAME#$# = initField_#^#BUNDLE_NAME#$#();\n"
+            "field_#^#BUNDLE_NAME#$#.field_#^#KEY_NAME#$#().setValue(commonKeyField.getValue());\n"
+            "#^#VERSION_ASSIGN#$#\n"
+            "return field_#^#BUNDLE_NAME#$#.template readFrom<1>(iter, len);";
+
+        auto bundleAccName = comms::accessName(m_optimizedReadCatchAll->field().dslObj().name());
+        util::ReplacementMap repl = {
+            {"BUNDLE_NAME", bundleAccName},
+            {"KEY_NAME", comms::accessName(bundleMembers.front()->field().dslObj().name())},
+        };
+
+        if (m->commsIsVersionDependent()) {
+            repl["VERSION_ASSIGN"] = "field_" + bundleAccName + ".setVersion(Base::getVersion());";
+        }
+
+        catchAllStr = util::processTemplate(Templ, repl);
+    }
+
+    static const std::string DefaultBreakStr =
+        "default:\n"
+        "    break;";
+    cases.push_back(DefaultBreakStr);
+
+    util::ReplacementMap repl = {
+        {"KEY_FIELD_TYPE", group.m_keyType},
+        {"CASES", util::strListToString(cases, "\n", "")},
+        {"RANGES", util::strListToString(rangeChecks, "\n", "")},
+        {"CATCH_ALL", std::move(catchAllStr)},
+    };
+
+    bool multiGroup = 
+        (1U < m_optimizedReadGroups.size()) || 
+        ((m_optimizedReadCatchAll != nullptr) && (!m_optimizedReadCatchAllSharesKey));
+
+    if (!multiGroup) {
+        static const std::string Templ =
+            "using CommonKeyField=\n"
+            "    #^#KEY_FIELD_TYPE#$#;\n"
+            "CommonKeyField commonKeyField;\n\n"
+            "auto keyEs = commonKeyField.read(iter, len);\n"
+            "if (keyEs != comms::ErrorStatus::Success) {\n"
+            "    return keyEs;\n"
+            "}\n\n"
+            "auto consumedLen = static_cast<std::size_t>(std::distance(origIter, iter));\n"
+            "COMMS_ASSERT(consumedLen <= len);\n"
+            "len -= consumedLen;\n\n"
+            "switch (commonKeyField.getValue()) {\n"
+            "    #^#CASES#$#\n"
+            "};\n\n"
+            "#^#RANGES#$#\n"
+            "#^#CATCH_ALL#$#\n";
+
+        return util::processTemplate(Templ, repl);
+    }
+
+    static const std::string Templ =
+        "do {\n"
+        "    using CommonKeyField=\n"
+        "        #^#KEY_FIELD_TYPE#$#;\n"
+        "    CommonKeyField commonKeyField;\n\n"
+        "    iter = origIter;\n"
+        "    len = origLen;\n"
+        "    auto keyEs = commonKeyField.read(iter, len);\n"
+        "    if (keyEs != comms::ErrorStatus::Success) {\n"
+        "        if (es != comms::ErrorStatus::NotEnoughData) {\n"
+        "            es = keyEs;\n"
+        "        }\n"
+        "        break;\n"
+        "    }\n\n"
+        "    auto consumedLen = static_cast<std::size_t>(std::distance(origIter, iter));\n"
+        "    COMMS_ASSERT(consumedLen <= len);\n"
+        "    len -= consumedLen;\n\n"
+        "    switch (commonKeyField.getValue()) {\n"
+        "        #^#CASES#$#\n"
+        "    };\n\n"
+        "    #^#RANGES#$#\n"
+        "    #^#CATCH_ALL#$#\n"
+        "} while (false);\n";
+
+    return util::processTemplate(Templ, repl);
+}
+
+std::string CommsVariantField::commsDefOptimizedReadCatchAllCodeInternal() const
+{
+    assert(m_optimizedReadCatchAll != nullptr);
+    static const std::string Templ =
+        "iter = origIter;\n"
+        "auto& field_#^#NAME#$# = initField_#^#NAME#$#();\n"
+        "#^#VERSION_ASSIGN#$#\n"
+        "return field_#^#NAME#$#.read(iter, origLen);";
+
+    auto accName = comms::accessName(m_optimizedReadCatchAll->field().dslObj().name());
+    util::ReplacementMap repl = {
+        {"NAME", accName},
+    };
+
+    if (getReferenceFieldInternal(m_optimizedReadCatchAll)->commsIsVersionDependent()) {
+        repl["VERSION_ASSIGN"] = "field_" + accName + ".setVersion(Base::getVersion());";
+    }
+
+    return util::processTemplate(Templ, repl);
+}
+
+bool CommsVariantField::commsOptimizedReadHasEnumKeyInternal() const
+{
+    for (auto& g : m_optimizedReadGroups) {
+        for (auto* m : g.m_members) {
+            PropKeyInfo info;
+            if (memberGetPropKeyInfoInternal(*m, info) && info.m_enum) {
+                return true;
+            }
+        }
+    }
+
+    return false;
 }
 
 } // namespace commsdsl2comms
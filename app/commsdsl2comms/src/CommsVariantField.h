@@ -20,6 +20,8 @@
 #include "commsdsl/gen/VariantField.h"
 #include "commsdsl/gen/util.h"
 
+#include <vector>
+
 namespace commsdsl2comms
 {
 
@@ -60,6 +62,14 @@ protected:
     virtual bool commsMustDefineDefaultConstructorImpl() const override;
 
 private:
+    struct OptimizedReadGroup
+    {
+        std::string m_keyType;
+        CommsFieldsList m_members;
+    };
+
+    using OptimizedReadGroupsList = std::vector<OptimizedReadGroup>;
+
     bool commsPrepareInternal();
     std::string commsDefFieldOptsInternal() const;
     std::string commsDefCopyCodeInternal() const;
@@ -72,10 +82,15 @@ private:
     std::string commsDefSelectFieldCodeInternal() const;
 
     void commsAddCustomReadOptInternal(StringsList& opts) const;
-    std::string commsOptimizedReadKeyInternal() const;
+    void commsPrepareOptimizedReadInternal();
+    std::string commsDefOptimizedReadGroupCodeInternal(const OptimizedReadGroup& group) const;
+    std::string commsDefOptimizedReadCatchAllCodeInternal() const;
+    bool commsOptimizedReadHasEnumKeyInternal() const;
 
     CommsFieldsList m_commsMembers;
-    std::string m_optimizedReadKey;
+    OptimizedReadGroupsList m_optimizedReadGroups;
+    const CommsField* m_optimizedReadCatchAll = nullptr;
+    bool m_optimizedReadCatchAllSharesKey = false;
 };
 
 } // namespace commsdsl2comms
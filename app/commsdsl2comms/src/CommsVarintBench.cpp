@@ -0,0 +1,383 @@
+//
+// Copyright 2019 - 2023 (C). Alex Robenko. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "CommsVarintBench.h"
+
+#include "CommsGenerator.h"
+#include "CommsListField.h"
+
+#include "commsdsl/gen/BundleField.h"
+#include "commsdsl/gen/comms.h"
+#include "commsdsl/gen/strings.h"
+#include "commsdsl/gen/util.h"
+
+#include <cassert>
+#include <fstream>
+
+namespace comms = commsdsl::gen::comms;
+namespace strings = commsdsl::gen::strings;
+namespace util = commsdsl::gen::util;
+
+namespace commsdsl2comms
+{
+
+namespace
+{
+
+const std::string VarintBenchStr("VarintBench");
+
+void collectListFieldsInternal(const commsdsl::gen::Field& field, std::vector<const CommsListField*>& result)
+{
+    auto kind = field.dslObj().kind();
+    if (kind == commsdsl::parse::Field::Kind::List) {
+        auto* listField = dynamic_cast<const CommsListField*>(&field);
+        assert(listField != nullptr);
+        result.push_back(listField);
+        return;
+    }
+
+    if (kind != commsdsl::parse::Field::Kind::Bundle) {
+        return;
+    }
+
+    auto& bundleField = static_cast<const commsdsl::gen::BundleField&>(field);
+    for (auto& m : bundleField.members()) {
+        collectListFieldsInternal(*m, result);
+    }
+}
+
+} // namespace
+
+bool CommsVarintBench::write(CommsGenerator& generator)
+{
+    CommsVarintBench obj(generator);
+    return obj.commsWriteInternal();
+}
+
+bool CommsVarintBench::commsWriteInternal() const
+{
+    static const std::string Templ =
+        "#^#GENERATED#$#\n"
+        "/// @file\n"
+        "/// @brief Measures throughput of the bulk read / write of the lists of\n"
+        "///     variable length integral values.\n"
+        "/// @details Usage: varint_bench_#^#PROT_NAMESPACE#$# [iterations]\n\n"
+        "#include <algorithm>\n"
+        "#include <chrono>\n"
+        "#include <cstddef>\n"
+        "#include <cstdint>\n"
+        "#include <cstdlib>\n"
+        "#include <iostream>\n"
+        "#include <limits>\n"
+        "#include <random>\n"
+        "#include <vector>\n\n"
+        "#^#INCLUDES#$#\n\n"
+        "namespace\n"
+        "{\n\n"
+        "enum class Distribution\n"
+        "{\n"
+        "    Small, ///< Single byte values\n"
+        "    Deltas, ///< Geometrically distributed deltas, mostly one or two bytes\n"
+        "    Wide, ///< Uniformly distributed number of significant bits\n"
+        "    NumOfValues\n"
+        "};\n\n"
+        "const char* distributionName(Distribution value)\n"
+        "{\n"
+        "    static const char* Map[] = {\n"
+        "        \"small\",\n"
+        "        \"deltas\",\n"
+        "        \"wide\"\n"
+        "    };\n\n"
+        "    static_assert(sizeof(Map) / sizeof(Map[0]) == static_cast<std::size_t>(Distribution::NumOfValues), \"Invalid map\");\n"
+        "    return Map[static_cast<std::size_t>(value)];\n"
+        "}\n\n"
+        "class ListBench\n"
+        "{\n"
+        "public:\n"
+        "    explicit ListBench(std::size_t iterations) :\n"
+        "        m_iterations(iterations)\n"
+        "    {\n"
+        "    }\n\n"
+        "    /// @param[in] maxLength Max serialisation length of the element\n"
+        "    /// @param[in] fixedCount Fixed number of elements, 0 when not fixed\n"
+        "    template <typename TField>\n"
+        "    void run(std::size_t maxLength, std::size_t fixedCount)\n"
+        "    {\n"
+        "        for (auto idx = 0U; idx < static_cast<unsigned>(Distribution::NumOfValues); ++idx) {\n"
+        "            runDistribution<TField>(static_cast<Distribution>(idx), maxLength, fixedCount);\n"
+        "        }\n"
+        "    }\n\n"
+        "private:\n"
+        "    using Clock = std::chrono::high_resolution_clock;\n"
+        "    static const std::size_t DefaultCount = 4096U;\n\n"
+        "    template <typename TField>\n"
+        "    void runDistribution(Distribution dist, std::size_t maxLength, std::size_t fixedCount)\n"
+        "    {\n"
+        "        auto count = fixedCount;\n"
+        "        if (count == 0U) {\n"
+        "            count = DefaultCount;\n"
+        "        }\n\n"
+        "        TField field;\n"
+        "        TField readField;\n"
+        "        std::vector<std::uint8_t> buf;\n"
+        "        std::size_t bytes = 0U;\n"
+        "        while (true) {\n"
+        "            // Shrink the list until it fits the limits of its prefix\n"
+        "            fill(field, dist, count, maxLength);\n"
+        "            buf.resize(field.length());\n"
+        "            std::uint8_t* writeIter = buf.data();\n"
+        "            auto es = field.write(writeIter, buf.size());\n"
+        "            bytes = static_cast<std::size_t>(writeIter - buf.data());\n"
+        "            const std::uint8_t* readIter = buf.data();\n"
+        "            if ((es == comms::ErrorStatus::Success) &&\n"
+        "                (readField.read(readIter, bytes) == comms::ErrorStatus::Success) &&\n"
+        "                (readField.value().size() == count)) {\n"
+        "                break;\n"
+        "            }\n\n"
+        "            if ((fixedCount != 0U) || (count <= 1U)) {\n"
+        "                std::cerr << \"ERROR: Failed to prepare \" << field.name() << std::endl;\n"
+        "                std::exit(-1);\n"
+        "            }\n\n"
+        "            count /= 2U;\n"
+        "        }\n\n"
+        "        auto start = Clock::now();\n"
+        "        for (std::size_t idx = 0U; idx < m_iterations; ++idx) {\n"
+        "            std::uint8_t* writeIter = buf.data();\n"
+        "            if (field.write(writeIter, buf.size()) != comms::ErrorStatus::Success) {\n"
+        "                std::cerr << \"ERROR: Failed to write \" << field.name() << std::endl;\n"
+        "                std::exit(-1);\n"
+        "            }\n"
+        "        }\n"
+        "        auto writeNs = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start);\n\n"
+        "        start = Clock::now();\n"
+        "        for (std::size_t idx = 0U; idx < m_iterations; ++idx) {\n"
+        "            const std::uint8_t* readIter = buf.data();\n"
+        "            if (readField.read(readIter, bytes) != comms::ErrorStatus::Success) {\n"
+        "                std::cerr << \"ERROR: Failed to read \" << field.name() << std::endl;\n"
+        "                std::exit(-1);\n"
+        "            }\n"
+        "        }\n"
+        "        auto readNs = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start);\n\n"
+        "        for (std::size_t idx = 0U; idx < count; ++idx) {\n"
+        "            if (readField.value()[idx].getValue() != field.value()[idx].getValue()) {\n"
+        "                std::cerr << \"ERROR: Value mismatch of \" << field.name() << std::endl;\n"
+        "                std::exit(-1);\n"
+        "            }\n"
+        "        }\n\n"
+        "        if (0U < m_count) {\n"
+        "            std::cout << \",\";\n"
+        "        }\n\n"
+        "        auto iterations = static_cast<double>(m_iterations);\n"
+        "        auto readNsPerOp = static_cast<double>(readNs.count()) / iterations;\n"
+        "        auto writeNsPerOp = static_cast<double>(writeNs.count()) / iterations;\n"
+        "        std::cout << \"\\n    {\"\n"
+        "            \"\\\"name\\\":\\\"\" << field.name() << \"\\\",\"\n"
+        "            \"\\\"distribution\\\":\\\"\" << distributionName(dist) << \"\\\",\"\n"
+        "            \"\\\"elements\\\":\" << count << \",\"\n"
+        "            \"\\\"bytes_per_op\\\":\" << bytes << \",\"\n"
+        "            \"\\\"read_ns_per_elem\\\":\" << (readNsPerOp / static_cast<double>(count)) << \",\"\n"
+        "            \"\\\"write_ns_per_elem\\\":\" << (writeNsPerOp / static_cast<double>(count)) << \",\"\n"
+        "            \"\\\"read_mb_per_sec\\\":\" << mbPerSec(bytes, readNsPerOp) << \",\"\n"
+        "            \"\\\"write_mb_per_sec\\\":\" << mbPerSec(bytes, writeNsPerOp) << \"}\";\n"
+        "        ++m_count;\n"
+        "    }\n\n"
+        "    template <typename TField>\n"
+        "    void fill(TField& field, Distribution dist, std::size_t count, std::size_t maxLength)\n"
+        "    {\n"
+        "        using ElemValueType = typename TField::ElementType::ValueType;\n"
+        "        static const bool Signed = std::numeric_limits<ElemValueType>::is_signed;\n"
+        "        auto bits = std::min(maxLength * 7U, static_cast<std::size_t>(std::numeric_limits<ElemValueType>::digits + (Signed ? 1 : 0)));\n"
+        "        if (Signed) {\n"
+        "            --bits;\n"
+        "        }\n\n"
+        "        std::mt19937_64 gen(static_cast<std::uint64_t>(count));\n"
+        "        std::geometric_distribution<std::uint64_t> deltas(1.0 / 500.0);\n"
+        "        auto& elems = field.value();\n"
+        "        elems.clear();\n"
+        "        elems.resize(count);\n"
+        "        for (auto& elem : elems) {\n"
+        "            std::uint64_t magnitude = 0U;\n"
+        "            if (dist == Distribution::Small) {\n"
+        "                magnitude = gen() & 0x3fU;\n"
+        "            }\n"
+        "            else if (dist == Distribution::Deltas) {\n"
+        "                magnitude = deltas(gen);\n"
+        "            }\n"
+        "            else {\n"
+        "                auto valueBits = static_cast<std::size_t>(gen() % (bits + 1U));\n"
+        "                if (valueBits != 0U) {\n"
+        "                    magnitude = gen() >> (64U - valueBits);\n"
+        "                }\n"
+        "            }\n\n"
+        "            if (bits < 64U) {\n"
+        "                magnitude &= ((static_cast<std::uint64_t>(1U) << bits) - 1U);\n"
+        "            }\n\n"
+        "            auto value = magnitude;\n"
+        "            if (Signed && ((gen() & 0x1U) != 0U)) {\n"
+        "                value = ~magnitude;\n"
+        "            }\n\n"
+        "            elem.setValue(static_cast<ElemValueType>(value));\n"
+        "        }\n"
+        "    }\n\n"
+        "    static double mbPerSec(std::size_t bytes, double nsPerOp)\n"
+        "    {\n"
+        "        if (nsPerOp <= 0.0) {\n"
+        "            return 0.0;\n"
+        "        }\n\n"
+        "        return (static_cast<double>(bytes) * 1000.0) / nsPerOp;\n"
+        "    }\n\n"
+        "    std::size_t m_iterations = 0U;\n"
+        "    std::size_t m_count = 0U;\n"
+        "};\n\n"
+        "} // namespace\n\n"
+        "int main(int argc, const char* argv[])\n"
+        "{\n"
+        "    std::size_t iterations = 1000U;\n"
+        "    if (1 < argc) {\n"
+        "        iterations = static_cast<std::size_t>(std::strtoull(argv[1], nullptr, 10));\n"
+        "    }\n\n"
+        "    if (iterations == 0U) {\n"
+        "        std::cerr << \"Invalid number of iterations\" << std::endl;\n"
+        "        return -1;\n"
+        "    }\n\n"
+        "    std::cout << \"{\\n  \\\"iterations\\\":\" << iterations << \",\\n\"\n"
+        "        \"  \\\"lists\\\":[\";\n\n"
+        "    ListBench bench(iterations);\n"
+        "    #^#RUNS#$#\n"
+        "    std::cout << \"\\n  ]\\n}\" << std::endl;\n"
+        "    return 0;\n"
+        "}\n"
+        ;
+
+    auto& gen = m_generator;
+    util::StringsList includes = {
+        "comms/ErrorStatus.h",
+    };
+
+    util::StringsList runs;
+    auto addRunFunc =
+        [&gen, &runs](const CommsListField& listField, const std::string& type)
+        {
+            auto* elem = listField.commsBulkVarElementField();
+            if (elem == nullptr) {
+                return;
+            }
+
+            runs.push_back(
+                "bench.run<" + type + " >(" +
+                util::numToString(elem->field().dslObj().maxLength()) + ", " +
+                util::numToString(static_cast<std::uintmax_t>(commsdsl::parse::ListField(listField.field().dslObj()).fixedCount())) + ");");
+        };
+
+    // The members are defined inside the class template (message fields or
+    // global field members) which needs default template arguments.
+    auto addMemberRunsFunc =
+        [&gen, &addRunFunc](const commsdsl::gen::Field& field, const std::string& parentScope)
+        {
+            std::vector<const CommsListField*> lists;
+            collectListFieldsInternal(field, lists);
+            for (auto* l : lists) {
+                auto scope = comms::scopeFor(l->field(), gen);
+                assert(parentScope.size() < scope.size());
+                addRunFunc(*l, parentScope + "<>" + scope.substr(parentScope.size()));
+            }
+        };
+
+    auto fields = gen.currentSchema().getAllFields();
+    for (auto* f : fields) {
+        if (!f->isReferenced()) {
+            continue;
+        }
+
+        auto kind = f->dslObj().kind();
+        if (kind == commsdsl::parse::Field::Kind::Bundle) {
+            auto& bundleField = static_cast<const commsdsl::gen::BundleField&>(*f);
+            auto runsCount = runs.size();
+            for (auto& m : bundleField.members()) {
+                addMemberRunsFunc(*m, comms::scopeFor(*f, gen) + strings::membersSuffixStr());
+            }
+
+            if (runsCount < runs.size()) {
+                includes.push_back(comms::relHeaderPathFor(*f, gen));
+            }
+            continue;
+        }
+
+        if (kind != commsdsl::parse::Field::Kind::List) {
+            continue;
+        }
+
+        auto* listField = dynamic_cast<const CommsListField*>(f);
+        assert(listField != nullptr);
+        auto runsCount = runs.size();
+        addRunFunc(*listField, comms::scopeFor(*f, gen) + "<>");
+        if (runsCount < runs.size()) {
+            includes.push_back(comms::relHeaderPathFor(*f, gen));
+        }
+    }
+
+    auto messages = gen.currentSchema().getAllMessages();
+    for (auto* m : messages) {
+        auto runsCount = runs.size();
+        for (auto& f : m->fields()) {
+            addMemberRunsFunc(*f, comms::scopeFor(*m, gen) + strings::fieldsSuffixStr());
+        }
+
+        if (runsCount < runs.size()) {
+            includes.push_back(comms::relHeaderPathFor(*m, gen));
+        }
+    }
+
+    if (runs.empty()) {
+        return true;
+    }
+
+    comms::prepareIncludeStatement(includes);
+    util::ReplacementMap repl = {
+        {"GENERATED", CommsGenerator::commsFileGeneratedComment()},
+        {"PROT_NAMESPACE", gen.currentSchema().mainNamespace()},
+        {"INCLUDES", util::strListToString(includes, "\n", "")},
+        {"RUNS", util::strListToString(runs, "\n", "")},
+    };
+
+    auto filePath =
+        util::pathAddElem(
+            util::pathAddElem(gen.getOutputDir(), strings::srcDirStr()),
+            VarintBenchStr + strings::cppSourceSuffixStr());
+
+    gen.logger().info("Generating " + filePath);
+    auto dirPath = util::pathUp(filePath);
+    assert(!dirPath.empty());
+    if (!gen.createDirectory(dirPath)) {
+        return false;
+    }
+
+    std::ofstream stream(filePath);
+    if (!stream) {
+        gen.logger().error("Failed to open \"" + filePath + "\" for writing.");
+        return false;
+    }
+
+    stream << util::processTemplate(Templ, repl, true);
+    stream.flush();
+    if (!stream.good()) {
+        gen.logger().error("Failed to write \"" + filePath + "\".");
+        return false;
+    }
+
+    return true;
+}
+
+} // namespace commsdsl2comms
@@ -73,6 +73,9 @@ bool CommsVersion::writeInternal() const
         "/// @file\n"
         "/// @brief Contains protocol version definition.\n\n"
         "#pragma once\n\n"
+        "#include <tuple>\n"
+        "#include <type_traits>\n\n"
+        "#include \"comms/options.h\"\n"
         "#include \"comms/version.h\"\n\n"
         "/// @brief Version of the protocol specification.\n"
         "#define #^#NS#$#_SPEC_VERSION (#^#VERSION#$#)\n\n"
@@ -85,6 +88,55 @@ bool CommsVersion::writeInternal() const
         "    return #^#NS#$#_SPEC_VERSION;\n"
         "}\n\n"
         "#^#PROT_VER_FUNC#$#\n"
+        "namespace details\n"
+        "{\n\n"
+        "template <typename TOpt, typename = void>\n"
+        "struct FixedVersionOf\n"
+        "{\n"
+        "    static constexpr bool Fixed = false;\n"
+        "    static constexpr unsigned Value = 0U;\n"
+        "};\n\n"
+        "template <typename TOpt>\n"
+        "struct FixedVersionOf<TOpt, typename std::conditional<true, void, typename TOpt::FixedVersion>::type>\n"
+        "{\n"
+        "    static constexpr bool Fixed = true;\n"
+        "    static constexpr unsigned Value = TOpt::FixedVersion::value;\n"
+        "};\n\n"
+        "} // namespace details\n\n"
+        "/// @brief Protocol version used by the version dependent checks of the fields.\n"
+        "/// @details Returns the version frozen at compile time by the @b FixedVersion\n"
+        "///     member type of the protocol options (see @b FixedVersionDefaultOptionsT),\n"
+        "///     or the runtime @b version of the field otherwise.\n"
+        "/// @tparam TOpt Protocol options the field is defined with.\n"
+        "template <typename TOpt, typename TVersion>\n"
+        "constexpr TVersion fieldVersion(TVersion version)\n"
+        "{\n"
+        "    return\n"
+        "        details::FixedVersionOf<TOpt>::Fixed ?\n"
+        "            static_cast<TVersion>(details::FixedVersionOf<TOpt>::Value) :\n"
+        "            version;\n"
+        "}\n\n"
+        "/// @brief Options of the version dependent optional field.\n"
+        "/// @details When the protocol options freeze the version (see @b FixedVersionDefaultOptionsT),\n"
+        "///     the field exists or is missing according to the fixed version, and neither\n"
+        "///     read nor refresh of the field depend on the runtime version. Otherwise\n"
+        "///     the provided default mode and versions range options are used.\n"
+        "/// @tparam TOpt Protocol options the field is defined with.\n"
+        "/// @tparam TFrom First version the field exists in.\n"
+        "/// @tparam TUntil Last version the field exists in.\n"
+        "/// @tparam TModeOpt Default mode option used when the version is not fixed.\n"
+        "/// @tparam TVersionsOpt Versions range option used when the version is not fixed.\n"
+        "template <typename TOpt, unsigned TFrom, unsigned TUntil, typename TModeOpt, typename TVersionsOpt>\n"
+        "using VersionOptionalFieldOptions =\n"
+        "    typename std::conditional<\n"
+        "        details::FixedVersionOf<TOpt>::Fixed,\n"
+        "        typename std::conditional<\n"
+        "            (TFrom <= details::FixedVersionOf<TOpt>::Value) && (details::FixedVersionOf<TOpt>::Value <= TUntil),\n"
+        "            comms::option::def::ExistsByDefault,\n"
+        "            comms::option::def::MissingByDefault\n"
+        "        >::type,\n"
+        "        std::tuple<TModeOpt, TVersionsOpt>\n"
+        "    >::type;\n\n"
         "} // namespace #^#PROT_NAMESPACE#$#\n\n"
         "// Generated compile time check for minimal supported version of the COMMS library\n"
         "static_assert(COMMS_MAKE_VERSION(#^#COMMS_MIN#$#) <= comms::version(),\n"
@@ -0,0 +1,17 @@
+#pragma once
+
+#include <cstdint>
+
+#include "test1/Message.h"
+
+// Common interface used by the explicit instantiation library of the protocol
+using ExplicitInterface =
+    test1::Message<
+        comms::option::app::IdInfoInterface,
+        comms::option::app::ReadIterator<const std::uint8_t*>,
+        comms::option::app::WriteIterator<std::uint8_t*>,
+        comms::option::app::LengthInfoInterface,
+        comms::option::app::ValidCheckInterface,
+        comms::option::app::NameInterface,
+        comms::option::app::RefreshInterface
+    >;
@@ -69,6 +69,12 @@ const std::string& EmscriptenDataBuf::emscriptenJsArrayToDataBufFuncName()
     return Str;
 }
 
+const std::string& EmscriptenDataBuf::emscriptenAssignJsArrayFuncName()
+{
+    static const std::string Str("dataBufAssignJsArray");
+    return Str;
+}
+
 void EmscriptenDataBuf::emscriptenAddSourceFiles(const EmscriptenGenerator& generator, StringsList& sources)
 {
     sources.push_back(generator.emscriptenRelSourceForRoot(ClassName));
@@ -92,12 +98,17 @@ bool EmscriptenDataBuf::emscriptenWriteHeaderInternal() const
 
     const std::string Templ = 
         "#^#GENERATED#$#\n\n"
+        "#include <cstddef>\n"
         "#include <cstdint>\n"
         "#include <vector>\n\n"
         "#include <emscripten/val.h>\n\n"
         "using #^#CLASS_NAME#$# = std::vector<std::uint8_t>;\n\n"
         "emscripten::val #^#MEM_VIEW#$#(const #^#CLASS_NAME#$#* buf);\n"
         "#^#CLASS_NAME#$# #^#JS_ARRAY#$#(const emscripten::val& buf);\n"
+        "void #^#ASSIGN_JS_ARRAY#$#(#^#CLASS_NAME#$#* buf, const emscripten::val& jsArray);\n"
+        "std::uintptr_t dataBufHeapAlloc(std::size_t len);\n"
+        "void dataBufHeapFree(std::uintptr_t addr);\n"
+        "emscripten::val dataBufHeapMemoryView(std::uintptr_t addr, std::size_t len);\n"
         ;
 
     util::ReplacementMap repl = {
@@ -105,6 +116,7 @@ bool EmscriptenDataBuf::emscriptenWriteHeaderInternal() const
         {"CLASS_NAME", emscriptenClassName(m_generator)},
         {"MEM_VIEW", emscriptenMemViewFuncName()},
         {"JS_ARRAY", emscriptenJsArrayToDataBufFuncName()},
+        {"ASSIGN_JS_ARRAY", emscriptenAssignJsArrayFuncName()},
     };
 
     auto str = commsdsl::gen::util::processTemplate(Templ, repl, true);
@@ -147,10 +159,33 @@ bool EmscriptenDataBuf::emscriptenWriteSrcInternal() const
         "{\n"
         "    return emscripten::convertJSArrayToNumberVector<std::uint8_t>(val);\n"
         "}\n\n"
+        "void #^#ASSIGN_JS_ARRAY#$#(#^#CLASS_NAME#$#* buf, const emscripten::val& jsArray)\n"
+        "{\n"
+        "    // Reuses the already allocated capacity and copies the values in bulk\n"
+        "    // using TypedArray.set() instead of element by element conversion.\n"
+        "    buf->resize(jsArray[\"length\"].as<std::size_t>());\n"
+        "    #^#MEM_VIEW#$#(buf).call<void>(\"set\", jsArray);\n"
+        "}\n\n"
+        "std::uintptr_t dataBufHeapAlloc(std::size_t len)\n"
+        "{\n"
+        "    return reinterpret_cast<std::uintptr_t>(new std::uint8_t[len]);\n"
+        "}\n\n"
+        "void dataBufHeapFree(std::uintptr_t addr)\n"
+        "{\n"
+        "    delete [] reinterpret_cast<std::uint8_t*>(addr);\n"
+        "}\n\n"
+        "emscripten::val dataBufHeapMemoryView(std::uintptr_t addr, std::size_t len)\n"
+        "{\n"
+        "    return emscripten::val(emscripten::typed_memory_view(len, reinterpret_cast<const std::uint8_t*>(addr)));\n"
+        "}\n\n"
         "EMSCRIPTEN_BINDINGS(#^#CLASS_NAME#$#) {\n"
         "    emscripten::register_vector<std::uint8_t>(\"#^#CLASS_NAME#$#\");\n"
         "    emscripten::function(\"#^#MEM_VIEW#$#\", &#^#MEM_VIEW#$#, emscripten::allow_raw_pointers());\n"
         "    emscripten::function(\"#^#JS_ARRAY#$#\", &#^#JS_ARRAY#$#);\n"
+        "    emscripten::function(\"#^#ASSIGN_JS_ARRAY#$#\", &#^#ASSIGN_JS_ARRAY#$#, emscripten::allow_raw_pointers());\n"
+        "    emscripten::function(\"dataBufHeapAlloc\", &dataBufHeapAlloc);\n"
+        "    emscripten::function(\"dataBufHeapFree\", &dataBufHeapFree);\n"
+        "    emscripten::function(\"dataBufHeapMemoryView\", &dataBufHeapMemoryView);\n"
         "}\n"
         ;
 
@@ -160,6 +195,7 @@ bool EmscriptenDataBuf::emscriptenWriteSrcInternal() const
         {"CLASS_NAME", emscriptenClassName(m_generator)},
         {"MEM_VIEW", emscriptenMemViewFuncName()},
         {"JS_ARRAY", emscriptenJsArrayToDataBufFuncName()},
+        {"ASSIGN_JS_ARRAY", emscriptenAssignJsArrayFuncName()},
     };
 
     auto str = commsdsl::gen::util::processTemplate(Templ, repl, true);
@@ -33,6 +33,7 @@ public:
     static std::string emscriptenRelHeader(const EmscriptenGenerator& generator);
     static const std::string& emscriptenMemViewFuncName();
     static const std::string& emscriptenJsArrayToDataBufFuncName();
+    static const std::string& emscriptenAssignJsArrayFuncName();
     static void emscriptenAddSourceFiles(const EmscriptenGenerator& generator, StringsList& sources);
 
 private:
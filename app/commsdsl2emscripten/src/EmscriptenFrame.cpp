@@ -120,6 +120,7 @@ bool EmscriptenFrame::emscriptenWriteHeaderInternal() const
         "#^#INCLUDES#$#\n\n"
         "#^#LAYERS#$#\n"
         "#^#ALL_FIELDS#$#\n"
+        "#^#BATCH#$#\n"
         "#^#DEF#$#\n"
     ;
 
@@ -128,6 +129,7 @@ bool EmscriptenFrame::emscriptenWriteHeaderInternal() const
         {"INCLUDES", emscriptenHeaderIncludesInternal()},
         {"LAYERS", emscriptenHeaderLayersInternal()},
         {"ALL_FIELDS", emscriptenHeaderAllFieldsInternal()},
+        {"BATCH", emscriptenHeaderBatchInternal()},
         {"DEF", emscriptenHeaderClassInternal()},
     };
     
@@ -160,7 +162,8 @@ bool EmscriptenFrame::emscriptenWriteSourceInternal() const
         "#include \"#^#HEADER#$#\"\n\n"
         "#include <iterator>\n\n"
         "#include <emscripten/bind.h>\n\n"
-        "#include \"comms/process.h\"\n\n"
+        "#include \"comms/dispatch.h\"\n"
+        "#include \"comms/protocol/ProtocolLayerBase.h\"\n\n"
         "#^#LAYERS#$#\n"
         "#^#CODE#$#\n"
         "#^#BIND#$#\n"
@@ -191,6 +194,8 @@ std::string EmscriptenFrame::emscriptenHeaderIncludesInternal() const
         EmscriptenMsgHandler::emscriptenRelHeader(gen),
         EmscriptenAllMessages::emscriptenRelHeader(gen),
         iFace->emscriptenRelHeader(),
+        "<memory>",
+        "<vector>",
     };
 
     EmscriptenProtocolOptions::emscriptenAddInclude(gen, includes);
@@ -264,22 +269,132 @@ std::string EmscriptenFrame::emscriptenHeaderAllFieldsNameInternal() const
     return gen.emscriptenClassName(*this) + "_AllFields";
 }
 
+std::string EmscriptenFrame::emscriptenHeaderBatchInternal() const
+{
+    static const std::string Templ = 
+        "// Result of the batched input processing, out of range indices yield default values\n"
+        "class #^#CLASS_NAME#$#\n"
+        "{\n"
+        "public:\n"
+        "    std::size_t size() const\n"
+        "    {\n"
+        "        return m_entries.size();\n"
+        "    }\n\n"
+        "    #^#MSG_ID#$# id(std::size_t idx) const\n"
+        "    {\n"
+        "        return (idx < m_entries.size()) ? m_entries[idx].m_id : static_cast<#^#MSG_ID#$#>(0);\n"
+        "    }\n\n"
+        "    std::size_t offset(std::size_t idx) const\n"
+        "    {\n"
+        "        return (idx < m_entries.size()) ? m_entries[idx].m_offset : 0U;\n"
+        "    }\n\n"
+        "    std::size_t length(std::size_t idx) const\n"
+        "    {\n"
+        "        return (idx < m_entries.size()) ? m_entries[idx].m_length : 0U;\n"
+        "    }\n\n"
+        "    // Available only when the messages were requested to be kept, shared with the batch\n"
+        "    std::shared_ptr<#^#INTERFACE#$#> message(std::size_t idx) const\n"
+        "    {\n"
+        "        return (idx < m_entries.size()) ? m_entries[idx].m_msg : nullptr;\n"
+        "    }\n\n"
+        "    void clear()\n"
+        "    {\n"
+        "        m_entries.clear();\n"
+        "    }\n\n"
+        "    void add(#^#MSG_ID#$# msgId, std::size_t msgOffset, std::size_t msgLength, std::shared_ptr<#^#INTERFACE#$#> msg)\n"
+        "    {\n"
+        "        m_entries.push_back(Entry{msgId, msgOffset, msgLength, std::move(msg)});\n"
+        "    }\n\n"
+        "private:\n"
+        "    struct Entry\n"
+        "    {\n"
+        "        #^#MSG_ID#$# m_id;\n"
+        "        std::size_t m_offset;\n"
+        "        std::size_t m_length;\n"
+        "        std::shared_ptr<#^#INTERFACE#$#> m_msg;\n"
+        "    };\n\n"
+        "    std::vector<Entry> m_entries;\n"
+        "};\n";
+
+    auto& gen = EmscriptenGenerator::cast(generator());
+    auto* iFace = gen.emscriptenMainInterface();
+    assert(iFace != nullptr);
+
+    util::ReplacementMap repl = {
+        {"CLASS_NAME", emscriptenHeaderBatchNameInternal()},
+        {"INTERFACE", gen.emscriptenClassName(*iFace)},
+        {"MSG_ID", comms::scopeForRoot(strings::msgIdEnumNameStr(), gen)},
+    };
+
+    return util::processTemplate(Templ, repl);
+}
+
+std::string EmscriptenFrame::emscriptenHeaderBatchNameInternal() const
+{
+    auto& gen = EmscriptenGenerator::cast(generator());
+    return gen.emscriptenClassName(*this) + "_Batch";
+}
+
 std::string EmscriptenFrame::emscriptenHeaderClassInternal() const
 {
     static const std::string Templ = 
     "class #^#CLASS_NAME#$#\n"
     "{\n"
     "public:\n"
+    "    #^#CLASS_NAME#$#() = default;\n\n"
+    "    // The cached message object is not copied\n"
+    "    #^#CLASS_NAME#$#(const #^#CLASS_NAME#$#& other) : m_frame(other.m_frame) {}\n\n"
+    "    #^#CLASS_NAME#$#& operator=(const #^#CLASS_NAME#$#& other)\n"
+    "    {\n"
+    "        m_frame = other.m_frame;\n"
+    "        m_msg.reset();\n"
+    "        return *this;\n"
+    "    }\n\n"
     "    #^#ACC#$#\n"
     "    std::size_t processInputData(const #^#DATA_BUF#$#& buf, #^#MSG_HANDER#$#& handler);\n"
     "    std::size_t processInputJsArray(const emscripten::val& buf, #^#MSG_HANDER#$#& handler);\n"
     "    std::size_t processInputDataSingleMsg(const #^#DATA_BUF#$#& buf, #^#MSG_HANDER#$#& handler, #^#ALL_FIELDS#$#* allFields = nullptr);\n"
     "    std::size_t processInputJsArraySingleMsg(const emscripten::val& buf, #^#MSG_HANDER#$#& handler, #^#ALL_FIELDS#$#* allFields = nullptr);\n"
+    "    std::size_t processInputHeap(std::uintptr_t addr, std::size_t len, #^#MSG_HANDER#$#& handler);\n"
+    "    std::size_t processInputHeapSingleMsg(std::uintptr_t addr, std::size_t len, #^#MSG_HANDER#$#& handler, #^#ALL_FIELDS#$#* allFields = nullptr);\n"
+    "    std::size_t processInputDataBatch(const #^#DATA_BUF#$#& buf, #^#BATCH#$#& batch, bool keepMessages);\n"
+    "    std::size_t processInputJsArrayBatch(const emscripten::val& buf, #^#BATCH#$#& batch, bool keepMessages);\n"
+    "    std::size_t processInputHeapBatch(std::uintptr_t addr, std::size_t len, #^#BATCH#$#& batch, bool keepMessages);\n"
     "    comms::ErrorStatus writeMessage(const #^#INTERFACE#$#& msg, #^#DATA_BUF#$#& buf);\n"
+    "    emscripten::val writeMessageMemoryView(const #^#INTERFACE#$#& msg);\n"
     "\n"
     "private:\n"
     "    using Frame = #^#COMMS_CLASS#$#<#^#INTERFACE#$#, #^#ALL_MESSAGES#$##^#OPTS#$#>;\n"
+    "    using ReadIterator = const std::uint8_t*;\n\n"
+    "    // Copies the cached message object into the separately allocated one.\n"
+    "    class CloneHandler\n"
+    "    {\n"
+    "    public:\n"
+    "        template <typename TMsg>\n"
+    "        void handle(TMsg& msg)\n"
+    "        {\n"
+    "            m_msg = std::make_shared<TMsg>(msg);\n"
+    "        }\n\n"
+    "        void handle(#^#INTERFACE#$#&)\n"
+    "        {\n"
+    "        }\n\n"
+    "        std::shared_ptr<#^#INTERFACE#$#> result()\n"
+    "        {\n"
+    "            return std::move(m_msg);\n"
+    "        }\n\n"
+    "    private:\n"
+    "        std::shared_ptr<#^#INTERFACE#$#> m_msg;\n"
+    "    };\n\n"
+    "    std::size_t processInputInternal(const std::uint8_t* buf, std::size_t len, #^#MSG_HANDER#$#& handler);\n"
+    "    std::size_t processInputSingleMsgInternal(const std::uint8_t* buf, std::size_t len, #^#MSG_HANDER#$#& handler, #^#ALL_FIELDS#$#* allFields);\n"
+    "    std::size_t processInputBatchInternal(const std::uint8_t* buf, std::size_t len, #^#BATCH#$#& batch, bool keepMessages);\n"
+    "    comms::ErrorStatus readMsgInternal(ReadIterator& iter, std::size_t len, Frame::AllFields* frameFields);\n\n"
     "    Frame m_frame;\n"
+    "    Frame::MsgPtr m_msg;\n"
+    "    #^#DATA_BUF#$# m_jsArrayBuf; // Reused by processInputJsArray*() to avoid memory allocation\n"
+    "    #^#DATA_BUF#$# m_outBuf; // Viewed by the result of writeMessageMemoryView()\n"
+    "    #^#MSG_ID#$# m_msgId = static_cast<#^#MSG_ID#$#>(0);\n"
+    "    std::size_t m_msgIdx = 0U;\n"
     "};\n";    
 
     auto& gen = EmscriptenGenerator::cast(generator());
@@ -292,9 +407,11 @@ std::string EmscriptenFrame::emscriptenHeaderClassInternal() const
         {"DATA_BUF", EmscriptenDataBuf::emscriptenClassName(gen)},
         {"MSG_HANDER", EmscriptenMsgHandler::emscriptenClassName(gen)},
         {"ALL_FIELDS", emscriptenHeaderAllFieldsNameInternal()},
+        {"BATCH", emscriptenHeaderBatchNameInternal()},
         {"INTERFACE", gen.emscriptenClassName(*iFace)},
         {"ALL_MESSAGES", EmscriptenAllMessages::emscriptenClassName(gen)},
         {"COMMS_CLASS", comms::scopeFor(*this, gen)},
+        {"MSG_ID", comms::scopeForRoot(strings::msgIdEnumNameStr(), gen)},
     };
 
     if (EmscriptenProtocolOptions::emscriptenIsDefined(gen)) {
@@ -366,41 +483,117 @@ std::string EmscriptenFrame::emscriptenSourceAllFieldsInternal() const
     return util::processTemplate(Templ, repl);
 }
 
+std::string EmscriptenFrame::emscriptenSourceBatchInternal() const
+{
+    static const std::string Templ = 
+        "emscripten::class_<#^#CLASS_NAME#$#>(\"#^#CLASS_NAME#$#\")\n"
+        "    .constructor<>()\n"
+        "    .function(\"size\", &#^#CLASS_NAME#$#::size)\n"
+        "    .function(\"id\", &#^#CLASS_NAME#$#::id)\n"
+        "    .function(\"offset\", &#^#CLASS_NAME#$#::offset)\n"
+        "    .function(\"length\", &#^#CLASS_NAME#$#::length)\n"
+        "    .function(\"message\", &#^#CLASS_NAME#$#::message)\n"
+        "    .function(\"clear\", &#^#CLASS_NAME#$#::clear)\n"
+        "    ;\n";
+
+    util::ReplacementMap repl = {
+        {"CLASS_NAME", emscriptenHeaderBatchNameInternal()},
+    };
+
+    return util::processTemplate(Templ, repl);
+}
+
 std::string EmscriptenFrame::emscriptenSourceCodeInternal() const
 {
     static const std::string Templ = 
         "std::size_t #^#CLASS_NAME#$#::processInputData(const #^#DATA_BUF#$#& buf, #^#HANDLER#$#& handler)\n"
         "{\n"
-        "    if (buf.empty()) { return 0U; }\n"
-        "    return static_cast<std::size_t>(comms::processAllWithDispatch(buf.begin(), buf.size(), m_frame, handler));\n"
+        "    return processInputInternal(buf.data(), buf.size(), handler);\n"
         "}\n\n"
         "std::size_t #^#CLASS_NAME#$#::processInputJsArray(const emscripten::val& buf, #^#HANDLER#$#& handler)\n"
         "{\n"
-        "    return processInputData(#^#JS_ARRAY#$#(buf), handler);\n"
+        "    #^#ASSIGN_JS_ARRAY#$#(&m_jsArrayBuf, buf);\n"
+        "    return processInputData(m_jsArrayBuf, handler);\n"
         "}\n\n"        
         "std::size_t #^#CLASS_NAME#$#::processInputDataSingleMsg(const #^#DATA_BUF#$#& buf, #^#HANDLER#$#& handler, #^#ALL_FIELDS#$#* allFields)\n"
         "{\n"
-        "    if (buf.empty()) { return 0U; }\n"
+        "    return processInputSingleMsgInternal(buf.data(), buf.size(), handler, allFields);\n"
+        "}\n\n"    
+        "std::size_t #^#CLASS_NAME#$#::processInputJsArraySingleMsg(const emscripten::val& buf, #^#HANDLER#$#& handler, #^#ALL_FIELDS#$#* allFields)\n"
+        "{\n"
+        "    #^#ASSIGN_JS_ARRAY#$#(&m_jsArrayBuf, buf);\n"
+        "    return processInputDataSingleMsg(m_jsArrayBuf, handler, allFields);\n"
+        "}\n\n"        
+        "std::size_t #^#CLASS_NAME#$#::processInputHeap(std::uintptr_t addr, std::size_t len, #^#HANDLER#$#& handler)\n"
+        "{\n"
+        "    return processInputInternal(reinterpret_cast<const std::uint8_t*>(addr), len, handler);\n"
+        "}\n\n"
+        "std::size_t #^#CLASS_NAME#$#::processInputHeapSingleMsg(std::uintptr_t addr, std::size_t len, #^#HANDLER#$#& handler, #^#ALL_FIELDS#$#* allFields)\n"
+        "{\n"
+        "    return processInputSingleMsgInternal(reinterpret_cast<const std::uint8_t*>(addr), len, handler, allFields);\n"
+        "}\n\n"
+        "std::size_t #^#CLASS_NAME#$#::processInputDataBatch(const #^#DATA_BUF#$#& buf, #^#BATCH#$#& batch, bool keepMessages)\n"
+        "{\n"
+        "    return processInputBatchInternal(buf.data(), buf.size(), batch, keepMessages);\n"
+        "}\n\n"
+        "std::size_t #^#CLASS_NAME#$#::processInputJsArrayBatch(const emscripten::val& buf, #^#BATCH#$#& batch, bool keepMessages)\n"
+        "{\n"
+        "    #^#ASSIGN_JS_ARRAY#$#(&m_jsArrayBuf, buf);\n"
+        "    return processInputDataBatch(m_jsArrayBuf, batch, keepMessages);\n"
+        "}\n\n"
+        "std::size_t #^#CLASS_NAME#$#::processInputHeapBatch(std::uintptr_t addr, std::size_t len, #^#BATCH#$#& batch, bool keepMessages)\n"
+        "{\n"
+        "    return processInputBatchInternal(reinterpret_cast<const std::uint8_t*>(addr), len, batch, keepMessages);\n"
+        "}\n\n"
+        "comms::ErrorStatus #^#CLASS_NAME#$#::writeMessage(const #^#INTERFACE#$#& msg, #^#DATA_BUF#$#& buf)\n"
+        "{\n"
+        "    buf.reserve(buf.size() + m_frame.length(msg));\n"
+        "    auto writeIter = std::back_inserter(buf);\n"
+        "    return m_frame.write(msg, writeIter, buf.max_size() - buf.size());\n"
+        "}\n\n"
+        "emscripten::val #^#CLASS_NAME#$#::writeMessageMemoryView(const #^#INTERFACE#$#& msg)\n"
+        "{\n"
+        "    m_outBuf.clear();\n"
+        "    auto es = writeMessage(msg, m_outBuf);\n"
+        "    if (es != comms::ErrorStatus::Success) {\n"
+        "        return emscripten::val::null();\n"
+        "    }\n\n"
+        "    return #^#MEM_VIEW#$#(&m_outBuf);\n"
+        "}\n\n"
+        "std::size_t #^#CLASS_NAME#$#::processInputInternal(const std::uint8_t* buf, std::size_t len, #^#HANDLER#$#& handler)\n"
+        "{\n"
+        "    std::size_t consumed = 0U;\n"
+        "    while (consumed < len) {\n"
+        "        auto iter = buf + consumed;\n"
+        "        auto es = readMsgInternal(iter, len - consumed, nullptr);\n"
+        "        if (es == comms::ErrorStatus::NotEnoughData) {\n"
+        "            break;\n"
+        "        }\n\n"
+        "        if (es == comms::ErrorStatus::ProtocolError) {\n"
+        "            consumed += Frame::resyncOffset(buf + consumed, len - consumed);\n"
+        "            continue;\n"
+        "        }\n\n"
+        "        consumed = static_cast<std::size_t>(std::distance(buf, iter));\n"
+        "        if (es == comms::ErrorStatus::Success) {\n"
+        "            m_msg->dispatch(handler);\n"
+        "        }\n"
+        "    }\n"
+        "    return consumed;\n"
+        "}\n\n"
+        "std::size_t #^#CLASS_NAME#$#::processInputSingleMsgInternal(const std::uint8_t* buf, std::size_t len, #^#HANDLER#$#& handler, #^#ALL_FIELDS#$#* allFields)\n"
+        "{\n"
+        "    if (len == 0U) { return 0U; }\n"
         "    std::size_t consumed = 0U;\n"
-        "    Frame::MsgPtr msg;\n"
         "    Frame::AllFields frameFields;\n"
-        "    while (consumed < buf.size()) {\n"
-        "        auto begIter = buf.begin() + consumed;\n"
+        "    while (consumed < len) {\n"
+        "        auto begIter = buf + consumed;\n"
         "        auto iter = begIter;\n\n"
-        "        auto es = comms::ErrorStatus::Success;\n"
-        "        auto len = buf.size() - consumed;\n"
-        "        std::size_t idx = 0U;\n"
-        "        if (allFields == nullptr) {\n"
-        "            es = m_frame.read(msg, iter, len, comms::protocol::msgIndex(idx));\n"
-        "        }\n"
-        "        else {\n"
-        "            es = m_frame.readFieldsCached(frameFields, msg, iter, len, comms::protocol::msgIndex(idx));\n"
-        "        }\n\n"
+        "        auto es = readMsgInternal(iter, len - consumed, (allFields != nullptr) ? &frameFields : nullptr);\n"
         "        if (es == comms::ErrorStatus::NotEnoughData) {\n"
         "            return consumed;\n"
         "        }\n\n"
         "        if (es == comms::ErrorStatus::ProtocolError) {\n"
-        "            ++consumed;\n"
+        "            consumed += Frame::resyncOffset(buf + consumed, len - consumed);\n"
         "            continue;\n"
         "        }\n\n"
         "        if (allFields != nullptr) {\n"
@@ -414,21 +607,58 @@ std::string EmscriptenFrame::emscriptenSourceCodeInternal() const
         "        }\n\n"
         "        consumed += static_cast<decltype(consumed)>(std::distance(begIter, iter));\n\n"
         "        if (es == comms::ErrorStatus::Success) {\n"
-        "            msg->dispatch(handler);\n"
+        "            m_msg->dispatch(handler);\n"
         "        }\n"
         "        break;\n"
         "    }\n"
         "    return consumed;\n"
-        "}\n\n"    
-        "std::size_t #^#CLASS_NAME#$#::processInputJsArraySingleMsg(const emscripten::val& buf, #^#HANDLER#$#& handler, #^#ALL_FIELDS#$#* allFields)\n"
+        "}\n\n"
+        "std::size_t #^#CLASS_NAME#$#::processInputBatchInternal(const std::uint8_t* buf, std::size_t len, #^#BATCH#$#& batch, bool keepMessages)\n"
         "{\n"
-        "    return processInputDataSingleMsg(#^#JS_ARRAY#$#(buf), handler, allFields);\n"
-        "}\n\n"        
-        "comms::ErrorStatus #^#CLASS_NAME#$#::writeMessage(const #^#INTERFACE#$#& msg, #^#DATA_BUF#$#& buf)\n"
+        "    std::size_t consumed = 0U;\n"
+        "    while (consumed < len) {\n"
+        "        auto iter = buf + consumed;\n"
+        "        auto es = readMsgInternal(iter, len - consumed, nullptr);\n"
+        "        if (es == comms::ErrorStatus::NotEnoughData) {\n"
+        "            break;\n"
+        "        }\n\n"
+        "        if (es == comms::ErrorStatus::ProtocolError) {\n"
+        "            consumed += Frame::resyncOffset(buf + consumed, len - consumed);\n"
+        "            continue;\n"
+        "        }\n\n"
+        "        auto offset = consumed;\n"
+        "        consumed = static_cast<std::size_t>(std::distance(buf, iter));\n"
+        "        if (es != comms::ErrorStatus::Success) {\n"
+        "            continue;\n"
+        "        }\n\n"
+        "        std::shared_ptr<#^#INTERFACE#$#> msg;\n"
+        "        if (keepMessages) {\n"
+        "            // The cached message object is reused by the following reads, keep its copy\n"
+        "            CloneHandler cloneHandler;\n"
+        "            comms::dispatchMsg<#^#ALL_MESSAGES#$#>(m_msgId, m_msgIdx, *m_msg, cloneHandler);\n"
+        "            msg = cloneHandler.result();\n"
+        "        }\n"
+        "        batch.add(m_msgId, offset, consumed - offset, std::move(msg));\n"
+        "    }\n"
+        "    return consumed;\n"
+        "}\n\n"
+        "comms::ErrorStatus #^#CLASS_NAME#$#::readMsgInternal(ReadIterator& iter, std::size_t len, Frame::AllFields* frameFields)\n"
         "{\n"
-        "    buf.reserve(buf.size() + m_frame.length(msg));\n"
-        "    auto writeIter = std::back_inserter(buf);\n"
-        "    return m_frame.write(msg, writeIter, buf.max_size() - buf.size());\n"
+        "    // The message factory of the frame reuses a single message object per message type,\n"
+        "    // the message object is selected by the ID read by the ID layer.\n"
+        "    m_msg.reset();\n"
+        "    m_msgIdx = 0U;\n"
+        "    auto es = comms::ErrorStatus::Success;\n"
+        "    if (frameFields == nullptr) {\n"
+        "        es = m_frame.read(m_msg, iter, len, comms::protocol::msgId(m_msgId), comms::protocol::msgIndex(m_msgIdx));\n"
+        "    }\n"
+        "    else {\n"
+        "        es = m_frame.readFieldsCached(*frameFields, m_msg, iter, len, comms::protocol::msgId(m_msgId), comms::protocol::msgIndex(m_msgIdx));\n"
+        "    }\n\n"
+        "    if (es != comms::ErrorStatus::Success) {\n"
+        "        m_msg.reset();\n"
+        "    }\n"
+        "    return es;\n"
         "}\n";
 
     util::StringsList allFieldsAcc;
@@ -450,10 +680,14 @@ std::string EmscriptenFrame::emscriptenSourceCodeInternal() const
         {"DATA_BUF", EmscriptenDataBuf::emscriptenClassName(gen)},
         {"HANDLER", EmscriptenMsgHandler::emscriptenClassName(gen)},
         {"ALL_FIELDS", emscriptenHeaderAllFieldsNameInternal()},
+        {"BATCH", emscriptenHeaderBatchNameInternal()},
+        {"MSG_ID", comms::scopeForRoot(strings::msgIdEnumNameStr(), gen)},
         {"ALL_FIELDS_VALUES", util::strListToString(allFieldsAcc, ",\n", "")},
         {"FRAME_FIELDS_VALUES", util::strListToString(frameFieldsAcc, ",\n", "")},
         {"INTERFACE", gen.emscriptenClassName(*iFace)},
-        {"JS_ARRAY", EmscriptenDataBuf::emscriptenJsArrayToDataBufFuncName()}
+        {"ASSIGN_JS_ARRAY", EmscriptenDataBuf::emscriptenAssignJsArrayFuncName()},
+        {"MEM_VIEW", EmscriptenDataBuf::emscriptenMemViewFuncName()},
+        {"ALL_MESSAGES", EmscriptenAllMessages::emscriptenClassName(gen)},
     };
     return util::processTemplate(Templ, repl);
 }
@@ -463,6 +697,7 @@ std::string EmscriptenFrame::emscriptenSourceBindInternal() const
     static const std::string Templ =
         "EMSCRIPTEN_BINDINGS(#^#CLASS_NAME#$#) {\n"
         "    #^#ALL_FIELDS#$#\n"
+        "    #^#BATCH#$#\n"
         "    emscripten::class_<#^#CLASS_NAME#$#>(\"#^#CLASS_NAME#$#\")\n"
         "        .constructor<>()\n"
         "        .constructor<const #^#CLASS_NAME#$#&>()\n"
@@ -471,13 +706,20 @@ std::string EmscriptenFrame::emscriptenSourceBindInternal() const
         "        .function(\"processInputJsArray\", &#^#CLASS_NAME#$#::processInputJsArray)\n"
         "        .function(\"processInputDataSingleMsg\", &#^#CLASS_NAME#$#::processInputDataSingleMsg, emscripten::allow_raw_pointers())\n"
         "        .function(\"processInputJsArraySingleMsg\", &#^#CLASS_NAME#$#::processInputJsArraySingleMsg, emscripten::allow_raw_pointers())\n"
+        "        .function(\"processInputHeap\", &#^#CLASS_NAME#$#::processInputHeap)\n"
+        "        .function(\"processInputHeapSingleMsg\", &#^#CLASS_NAME#$#::processInputHeapSingleMsg, emscripten::allow_raw_pointers())\n"
+        "        .function(\"processInputDataBatch\", &#^#CLASS_NAME#$#::processInputDataBatch)\n"
+        "        .function(\"processInputJsArrayBatch\", &#^#CLASS_NAME#$#::processInputJsArrayBatch)\n"
+        "        .function(\"processInputHeapBatch\", &#^#CLASS_NAME#$#::processInputHeapBatch)\n"
         "        .function(\"writeMessage\", &#^#CLASS_NAME#$#::writeMessage)\n"
+        "        .function(\"writeMessageMemoryView\", &#^#CLASS_NAME#$#::writeMessageMemoryView)\n"
         "        ;\n"
         "}\n";
 
     auto& gen = EmscriptenGenerator::cast(generator());
     util::ReplacementMap repl = {
         {"ALL_FIELDS", emscriptenSourceAllFieldsInternal()},
+        {"BATCH", emscriptenSourceBatchInternal()},
         {"CLASS_NAME", gen.emscriptenClassName(*this)},
         {"LAYERS_ACC", emscriptenSourceLayersAccBindInternal()}
     };
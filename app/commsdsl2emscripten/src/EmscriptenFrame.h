@@ -56,10 +56,13 @@ private:
     std::string emscriptenHeaderLayersInternal() const;
     std::string emscriptenHeaderAllFieldsInternal() const;
     std::string emscriptenHeaderAllFieldsNameInternal() const;
+    std::string emscriptenHeaderBatchInternal() const;
+    std::string emscriptenHeaderBatchNameInternal() const;
     std::string emscriptenHeaderClassInternal() const;
     std::string emscriptenHeaderLayersAccessInternal() const;
     std::string emscriptenSourceLayersInternal() const;
     std::string emscriptenSourceAllFieldsInternal() const;
+    std::string emscriptenSourceBatchInternal() const;
     std::string emscriptenSourceCodeInternal() const;
     std::string emscriptenSourceBindInternal() const;
     std::string emscriptenSourceLayersAccBindInternal() const;
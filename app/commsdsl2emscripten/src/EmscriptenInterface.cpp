@@ -163,6 +163,7 @@ std::string EmscriptenInterface::emscriptenHeaderIncludesInternal() const
     auto& gen = EmscriptenGenerator::cast(generator());
     util::StringsList includes = {
         "<iterator>",
+        "<memory>",
         "<emscripten/val.h>",
         comms::relHeaderPathFor(*this, gen),
         EmscriptenDataBuf::emscriptenRelHeader(gen),
@@ -217,13 +218,18 @@ std::string EmscriptenInterface::emscriptenHeaderClassInternal() const
         "    #^#FIELDS#$#\n"
         "    comms::ErrorStatus readDataBuf(const #^#DATA_BUF#$#& buf)\n"
         "    {\n"
-        "        auto iter = buf.begin();\n"
+        "        const std::uint8_t* iter = buf.data();\n"
         "        return Base::read(iter, buf.size());\n"
         "    }\n\n"   
         "    comms::ErrorStatus readJsArray(const emscripten::val& jsArray)\n"
         "    {\n"
-        "        auto dataBuf = #^#JS_ARRAY_FUNC#$#(jsArray);\n"
-        "        return readDataBuf(dataBuf);\n"
+        "        #^#ASSIGN_JS_ARRAY_FUNC#$#(&m_readBuf, jsArray);\n"
+        "        return readDataBuf(m_readBuf);\n"
+        "    }\n\n" 
+        "    comms::ErrorStatus readHeap(std::uintptr_t addr, std::size_t len)\n"
+        "    {\n"
+        "        auto* iter = reinterpret_cast<const std::uint8_t*>(addr);\n"
+        "        return Base::read(iter, len);\n"
         "    }\n\n" 
         "    comms::ErrorStatus writeDataBuf(#^#DATA_BUF#$#& buf) const\n"
         "    {\n"
@@ -253,14 +259,17 @@ std::string EmscriptenInterface::emscriptenHeaderClassInternal() const
         "    void dispatch(#^#MSG_HANDLER#$#& handler)\n"
         "    {\n"
         "        Base::dispatch(handler);\n"
-        "    }\n"        
+        "    }\n\n"
+        "private:\n"
+        "    // Reused to avoid memory allocation on every read\n"
+        "    #^#DATA_BUF#$# m_readBuf;\n"
         "};\n";        
         
         util::ReplacementMap repl = {
             {"CLASS_NAME", gen.emscriptenClassName(*this)},
             {"BASE", emscriptenHeaderBaseInternal()},
             {"DATA_BUF", EmscriptenDataBuf::emscriptenClassName(gen)},
-            {"JS_ARRAY_FUNC", EmscriptenDataBuf::emscriptenJsArrayToDataBufFuncName()},
+            {"ASSIGN_JS_ARRAY_FUNC", EmscriptenDataBuf::emscriptenAssignJsArrayFuncName()},
             {"MSG_ID", comms::scopeForRoot(strings::msgIdEnumNameStr(), gen)},
             {"FIELDS", util::strListToString(fields, "\n", "")},
             {"MSG_HANDLER", EmscriptenMsgHandler::emscriptenClassName(gen)},
@@ -272,7 +281,7 @@ std::string EmscriptenInterface::emscriptenHeaderBaseInternal() const
 {
     const std::string Templ = 
         "#^#COMMS_CLASS#$#<\n"
-        "    comms::option::app::ReadIterator<#^#DATA_BUF#$#::const_iterator>,\n"
+        "    comms::option::app::ReadIterator<const std::uint8_t*>,\n"
         "    comms::option::app::WriteIterator<std::back_insert_iterator<#^#DATA_BUF#$#> >,\n"
         "    comms::option::app::IdInfoInterface,\n"        
         "    comms::option::app::ValidCheckInterface,\n"
@@ -321,9 +330,11 @@ std::string EmscriptenInterface::emscriptenSourceCodeInternal() const
     static const std::string Templ = 
         "EMSCRIPTEN_BINDINGS(#^#CLASS_NAME#$#) {\n"
         "    emscripten::class_<#^#CLASS_NAME#$#>(\"#^#CLASS_NAME#$#\")\n"
+        "        .smart_ptr<std::shared_ptr<#^#CLASS_NAME#$#> >(\"#^#CLASS_NAME#$#_SharedPtr\")\n"
         "        #^#FIELDS#$#\n"
         "        .function(\"readDataBuf\", &#^#CLASS_NAME#$#::readDataBuf)\n"
         "        .function(\"readJsArray\", &#^#CLASS_NAME#$#::readJsArray)\n"
+        "        .function(\"readHeap\", &#^#CLASS_NAME#$#::readHeap)\n"
         "        .function(\"getId\", &#^#CLASS_NAME#$#::getId)\n"
         "        .function(\"refresh\", &#^#CLASS_NAME#$#::refresh)\n"
         "        .function(\"length\", &#^#CLASS_NAME#$#::length)\n"
@@ -99,9 +99,173 @@ function test3(instance) {
     }
 }
 
+function test4(instance) {
+    console.log("!!! test4");
+    var msg1 = new instance.message_Msg1();
+    var frame = new instance.frame_Frame();
+    var handler = allocHandler(instance);
+    var buf = new instance.DataBuf();
+    var heapAddr = instance.dataBufHeapAlloc(32);
+
+    try {
+        msg1.field_f1().setValue(0x112233);
+        msg1.field_f2().setValue(5);
+
+        var outView = frame.writeMessageMemoryView(msg1);
+        assert(outView.length == 5);
+
+        var heapView = instance.dataBufHeapMemoryView(heapAddr, 32);
+        heapView.set(outView);
+        assert(frame.processInputHeap(heapAddr, outView.length, handler) == outView.length);
+        assert(instance.eq_message_Msg1(msg1, handler.msg1));
+
+        instance.dataBufAssignJsArray(buf, new Uint8Array([1, 1, 2, 3, 4]));
+        assert(buf.size() == 5);
+        frame.processInputData(buf, handler);
+        assert(handler.msg1.field_f1().getValue() == 0x030201);
+        assert(handler.msg1.field_f2().getValue() == 0x04);
+    }
+    finally {
+        instance.dataBufHeapFree(heapAddr);
+        buf.delete();
+        handler.clean();
+        handler.delete();
+        frame.delete();
+        msg1.delete();
+    }
+}
+
+function test5(instance) {
+    console.log("!!! test5");
+    var frame = new instance.frame_Frame();
+    var batch = new instance.frame_Frame_Batch();
+    var handler = allocHandler(instance);
+
+    try {
+        var input = new Uint8Array([1, 1, 2, 3, 4, 2, 1, 5, 6, 7]);
+        assert(frame.processInputJsArrayBatch(input, batch, false) == 6);
+        assert(batch.size() == 2);
+        assert(batch.id(0) == instance.MsgId.Msg1);
+        assert(batch.offset(0) == 0);
+        assert(batch.length(0) == 5);
+        assert(batch.id(1) == instance.MsgId.Msg2);
+        assert(batch.offset(1) == 5);
+        assert(batch.length(1) == 1);
+        assert(batch.message(0) == null);
+
+        batch.clear();
+        assert(frame.processInputJsArrayBatch(input, batch, true) == 6);
+        assert(batch.size() == 2);
+        var msg = batch.message(0);
+        assert(batch.message(2) == null);
+
+        // The message object is shared with the batch and outlives its clearing
+        batch.clear();
+        msg.dispatch(handler);
+        msg.delete();
+        assert(handler.msg1.field_f1().getValue() == 0x030201);
+        assert(handler.msg1.field_f2().getValue() == 0x04);
+    }
+    finally {
+        handler.clean();
+        handler.delete();
+        batch.delete();
+        frame.delete();
+    }
+}
+
+function allocRecordingHandler(instance)
+{
+    var DerivedHandler = instance.MsgHandler.extend("MsgHandler", {
+        __construct: function() {
+            this.__parent.__construct.call(this);
+            this.msgs = [];
+        },
+        handle_message_Msg1: function(msg) {
+            this.msgs.push({ptr: msg.$$.ptr, f1: msg.field_f1().getValue(), f2: msg.field_f2().getValue()});
+        },
+        handle_message_Msg2: function(msg) {
+            this.msgs.push({ptr: msg.$$.ptr});
+        },
+        handle_Message: function(msg) {
+            assert(false); /* should not happen */
+        }
+    });
+
+    return new DerivedHandler;
+}
+
+function test6(instance) {
+    console.log("!!! test6");
+    var frame = new instance.frame_Frame();
+    var handler = allocRecordingHandler(instance);
+
+    try {
+        // Consecutive frames of the same message type reuse the message object
+        var input = new Uint8Array([1, 1, 2, 3, 4, 1, 5, 6, 7, 8]);
+        assert(frame.processInputJsArray(input, handler) == input.length);
+        assert(handler.msgs.length == 2);
+        assert(handler.msgs[0].ptr == handler.msgs[1].ptr);
+        assert(handler.msgs[0].f1 == 0x030201);
+        assert(handler.msgs[0].f2 == 0x04);
+        assert(handler.msgs[1].f1 == 0x070605);
+        assert(handler.msgs[1].f2 == 0x08);
+    }
+    finally {
+        handler.delete();
+        frame.delete();
+    }
+}
+
+function test7(instance) {
+    console.log("!!! test7");
+    var frame = new instance.frame_Frame();
+    var handler = allocRecordingHandler(instance);
+
+    try {
+        // Interleaved message types get their own cached objects
+        var input = new Uint8Array([1, 1, 2, 3, 4, 2, 1, 5, 6, 7, 8]);
+        assert(frame.processInputJsArray(input, handler) == input.length);
+        assert(handler.msgs.length == 3);
+        assert(handler.msgs[0].ptr == handler.msgs[2].ptr);
+        assert(handler.msgs[0].ptr != handler.msgs[1].ptr);
+        assert(handler.msgs[0].f1 == 0x030201);
+        assert(handler.msgs[1].f1 === undefined);
+        assert(handler.msgs[2].f1 == 0x070605);
+    }
+    finally {
+        handler.delete();
+        frame.delete();
+    }
+}
+
+function test8(instance) {
+    console.log("!!! test8");
+    var frame = new instance.frame_Frame();
+    var handler = allocRecordingHandler(instance);
+
+    try {
+        // Invalid message ID doesn't prevent reading of the following message
+        var input = new Uint8Array([5, 1, 1, 2, 3, 4]);
+        assert(frame.processInputJsArray(input, handler) == input.length);
+        assert(handler.msgs.length == 1);
+        assert(handler.msgs[0].f1 == 0x030201);
+        assert(handler.msgs[0].f2 == 0x04);
+    }
+    finally {
+        handler.delete();
+        frame.delete();
+    }
+}
+
 factory().then((instance) => {
     test1(instance);
     test2(instance);
     test3(instance);
+    test4(instance);
+    test5(instance);
+    test6(instance);
+    test7(instance);
+    test8(instance);
 });
 
@@ -67,7 +67,7 @@ bool Swig::swigWriteInternal()
         }
 
         const std::string Templ = 
-            "%module(directors=\"1\") #^#NS#$#\n\n"
+            "%module(directors=\"1\", threads=\"1\") #^#NS#$#\n\n"
             "#^#LANG_DEFS#$#\n"
             "#^#PREPEND#$#\n"
             "#^#CODE#$#\n"
@@ -163,6 +163,7 @@ std::string Swig::swigDefInternal()
     util::StringsList stdIncludes = {
         includeWrap("std_array.i"),
         includeWrap("std_pair.i"),
+        includeWrap("std_shared_ptr.i"),
         includeWrap("std_string.i"),
         includeWrap("std_vector.i")
     };
@@ -205,6 +206,8 @@ std::string Swig::swigLangDefsInternal() const
         "%{\n"
         "#define SWIG_FILE_WITH_INIT\n"
         "%}\n"
+        "// The GIL is released only by the explicitly selected decode / encode functions\n"
+        "%nothread;\n"
         "#endif // #ifdef SWIGPYTHON\n";
 
     std::string javaDefs = 
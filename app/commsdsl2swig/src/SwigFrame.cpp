@@ -21,6 +21,7 @@
 #include "SwigInterface.h"
 #include "SwigLayer.h"
 #include "SwigMsgHandler.h"
+#include "SwigMsgId.h"
 #include "SwigProtocolOptions.h"
 
 #include "commsdsl/gen/comms.h"
@@ -52,6 +53,8 @@ void SwigFrame::swigAddCodeIncludes(StringsList& list) const
     }
 
     list.push_back(comms::relHeaderPathFor(*this, generator()));
+    list.push_back("<memory>");
+    list.push_back("<vector>");
 }
 
 void SwigFrame::swigAddCode(StringsList& list) const
@@ -65,6 +68,7 @@ void SwigFrame::swigAddCode(StringsList& list) const
     }
 
     list.push_back(swigAllFieldsInternal());
+    list.push_back(swigBatchCodeInternal());
     list.push_back(swigFrameCodeInternal());
 }
 
@@ -78,6 +82,20 @@ void SwigFrame::swigAddDef(StringsList& list) const
         l->swigAddDef(list);
     }
 
+    static const std::string Templ = 
+        "#ifdef SWIGPYTHON\n"
+        "%thread #^#CLASS_NAME#$#::processInputData;\n"
+        "%thread #^#CLASS_NAME#$#::processInputDataSingleMsg;\n"
+        "%thread #^#CLASS_NAME#$#::processInputDataBatch;\n"
+        "%thread #^#CLASS_NAME#$#::writeMessage;\n"
+        "%thread #^#CLASS_NAME#$#::appendMessage;\n"
+        "#endif // #ifdef SWIGPYTHON";
+
+    util::ReplacementMap repl = {
+        {"CLASS_NAME", SwigGenerator::cast(generator()).swigClassName(*this)},
+    };
+
+    list.push_back(util::processTemplate(Templ, repl));
     list.push_back(SwigGenerator::swigDefInclude(comms::relHeaderPathFor(*this, generator())));
 }
 
@@ -141,6 +159,7 @@ bool SwigFrame::writeImpl() const
         "#pragma once\n\n"
         "#^#LAYERS#$#\n"
         "#^#ALL_FIELDS#$#\n"
+        "#^#BATCH#$#\n"
         "#^#DEF#$#\n"
     ;
 
@@ -148,6 +167,7 @@ bool SwigFrame::writeImpl() const
         {"GENERATED", SwigGenerator::fileGeneratedComment()},
         {"LAYERS", swigLayerDeclsInternal()},
         {"ALL_FIELDS", swigAllFieldsInternal()},
+        {"BATCH", swigBatchDeclInternal()},
         {"DEF", swigClassDeclInternal()},
     };
     
@@ -178,6 +198,7 @@ std::string SwigFrame::swigClassDeclInternal() const
         "    #^#LAYERS#$#\n\n"
         "    #^#SIZE_T#$# processInputData(const #^#DATA_BUF#$#& buf, #^#HANDLER#$#& handler);\n"
         "    #^#SIZE_T#$# processInputDataSingleMsg(const #^#DATA_BUF#$#& buf, #^#HANDLER#$#& handler, #^#CLASS_NAME#$#_AllFields* allFields = nullptr);\n"
+        "    #^#SIZE_T#$# processInputDataBatch(const #^#DATA_BUF#$#& buf, #^#CLASS_NAME#$#_Batch& batch, bool keepMessages = false);\n"
         "    #^#DATA_BUF#$# writeMessage(const #^#INTERFACE#$#& msg);\n"
         "    #^#ERR_STATUS#$# appendMessage(const #^#INTERFACE#$#& msg, #^#DATA_BUF#$#& buf);\n"
         "    #^#CUSTOM#$#\n"
@@ -243,34 +264,50 @@ std::string SwigFrame::swigFrameCodeInternal() const
         "{\n"
         "public:\n"
         "    #^#LAYERS#$#\n\n"
+        "    #^#CLASS_NAME#$#() = default;\n\n"
+        "    // The cached message object is not copied\n"
+        "    #^#CLASS_NAME#$#(const #^#CLASS_NAME#$#& other) : m_frame(other.m_frame) {}\n\n"
+        "    #^#CLASS_NAME#$#& operator=(const #^#CLASS_NAME#$#& other)\n"
+        "    {\n"
+        "        m_frame = other.m_frame;\n"
+        "        m_msg.reset();\n"
+        "        return *this;\n"
+        "    }\n\n"
         "    #^#SIZE_T#$# processInputData(const #^#DATA_BUF#$#& buf, #^#HANDLER#$#& handler)\n"
         "    {\n"
-        "        if (buf.empty()) { return 0U; }\n"
-        "        return static_cast<#^#SIZE_T#$#>(comms::processAllWithDispatch(buf.begin(), buf.size(), m_frame, handler));\n"
+        "        #^#SIZE_T#$# consumed = 0U;\n"
+        "        while (consumed < buf.size()) {\n"
+        "            auto iter = buf.begin() + consumed;\n"
+        "            auto es = readMsgInternal(iter, buf.size() - consumed, nullptr);\n"
+        "            if (es == comms::ErrorStatus::NotEnoughData) {\n"
+        "                break;\n"
+        "            }\n\n"
+        "            if (es == comms::ErrorStatus::ProtocolError) {\n"
+        "                consumed += Frame::resyncOffset(&buf[consumed], buf.size() - consumed);\n"
+        "                continue;\n"
+        "            }\n\n"
+        "            consumed = static_cast<decltype(consumed)>(std::distance(buf.begin(), iter));\n"
+        "            if (es == comms::ErrorStatus::Success) {\n"
+        "                m_msg->dispatch(handler);\n"
+        "            }\n"
+        "        }\n"
+        "        return consumed;\n"
         "    }\n\n"
         "    #^#SIZE_T#$# processInputDataSingleMsg(const #^#DATA_BUF#$#& buf, #^#HANDLER#$#& handler, #^#CLASS_NAME#$#_AllFields* allFields = nullptr)\n"
         "    {\n"
         "        if (buf.empty()) { return 0U; }\n"
         "        #^#SIZE_T#$# consumed = 0U;\n"
-        "        Frame::MsgPtr msg;\n"
         "        Frame::AllFields frameFields;\n"
         "        while (consumed < buf.size()) {\n"
         "            auto begIter = buf.begin() + consumed;\n"
         "            auto iter = begIter;\n\n"
-        "            auto es = comms::ErrorStatus::Success;\n"
         "            auto len = buf.size() - consumed;\n"
-        "            std::size_t idx = 0U;\n"
-        "            if (allFields == nullptr) {\n"
-        "                es = m_frame.read(msg, iter, len, comms::protocol::msgIndex(idx));\n"
-        "            }\n"
-        "            else {\n"
-        "                es = m_frame.readFieldsCached(frameFields, msg, iter, len, comms::protocol::msgIndex(idx));\n"
-        "            }\n\n"
+        "            auto es = readMsgInternal(iter, len, (allFields != nullptr) ? &frameFields : nullptr);\n"
         "            if (es == comms::ErrorStatus::NotEnoughData) {\n"
         "                return consumed;\n"
         "            }\n\n"
         "            if (es == comms::ErrorStatus::ProtocolError) {\n"
-        "                ++consumed;\n"
+        "                consumed += Frame::resyncOffset(&buf[consumed], buf.size() - consumed);\n"
         "                continue;\n"
         "            }\n\n"
         "            if (allFields != nullptr) {\n"
@@ -284,12 +321,41 @@ std::string SwigFrame::swigFrameCodeInternal() const
         "            }\n\n"
         "            consumed += static_cast<decltype(consumed)>(std::distance(begIter, iter));\n\n"
         "            if (es == comms::ErrorStatus::Success) {\n"
-        "                msg->dispatch(handler);\n"
+        "                m_msg->dispatch(handler);\n"
         "            }\n"
         "            break;\n"
         "        }\n"
         "        return consumed;\n"
         "    }\n\n"        
+        "    #^#SIZE_T#$# processInputDataBatch(const #^#DATA_BUF#$#& buf, #^#CLASS_NAME#$#_Batch& batch, bool keepMessages = false)\n"
+        "    {\n"
+        "        #^#SIZE_T#$# consumed = 0U;\n"
+        "        while (consumed < buf.size()) {\n"
+        "            auto iter = buf.begin() + consumed;\n"
+        "            auto es = readMsgInternal(iter, buf.size() - consumed, nullptr);\n"
+        "            if (es == comms::ErrorStatus::NotEnoughData) {\n"
+        "                break;\n"
+        "            }\n\n"
+        "            if (es == comms::ErrorStatus::ProtocolError) {\n"
+        "                consumed += Frame::resyncOffset(&buf[consumed], buf.size() - consumed);\n"
+        "                continue;\n"
+        "            }\n\n"
+        "            auto offset = consumed;\n"
+        "            consumed = static_cast<decltype(consumed)>(std::distance(buf.begin(), iter));\n"
+        "            if (es != comms::ErrorStatus::Success) {\n"
+        "                continue;\n"
+        "            }\n\n"
+        "            std::shared_ptr<#^#INTERFACE#$#> msg;\n"
+        "            if (keepMessages) {\n"
+        "                // The cached message object is reused by the following reads, keep its copy\n"
+        "                CloneHandler cloneHandler;\n"
+        "                comms::dispatchMsg<AllMessages>(m_msgId, m_msgIdx, *m_msg, cloneHandler);\n"
+        "                msg = cloneHandler.result();\n"
+        "            }\n"
+        "            batch.add(m_msgId, offset, consumed - offset, std::move(msg));\n"
+        "        }\n"
+        "        return consumed;\n"
+        "    }\n\n"
         "    #^#DATA_BUF#$# writeMessage(const #^#INTERFACE#$#& msg)\n"
         "    {\n"
         "        #^#DATA_BUF#$# outBuf;\n"
@@ -309,7 +375,48 @@ std::string SwigFrame::swigFrameCodeInternal() const
         "    #^#CUSTOM#$#\n\n"
         "private:\n"
         "    using Frame = #^#COMMS_CLASS#$#<#^#INTERFACE#$#, AllMessages#^#OPTS#$#>;\n"
+        "    using ReadIterator = #^#DATA_BUF#$#::const_iterator;\n\n"
+        "    // Copies the cached message object into the separately allocated one.\n"
+        "    class CloneHandler\n"
+        "    {\n"
+        "    public:\n"
+        "        template <typename TMsg>\n"
+        "        void handle(TMsg& msg)\n"
+        "        {\n"
+        "            m_msg = std::make_shared<TMsg>(msg);\n"
+        "        }\n\n"
+        "        void handle(#^#INTERFACE#$#&)\n"
+        "        {\n"
+        "        }\n\n"
+        "        std::shared_ptr<#^#INTERFACE#$#> result()\n"
+        "        {\n"
+        "            return std::move(m_msg);\n"
+        "        }\n\n"
+        "    private:\n"
+        "        std::shared_ptr<#^#INTERFACE#$#> m_msg;\n"
+        "    };\n\n"
+        "    // The message factory of the frame reuses a single message object per message type,\n"
+        "    // the message object is selected by the ID read by the ID layer.\n"
+        "    comms::ErrorStatus readMsgInternal(ReadIterator& iter, std::size_t len, Frame::AllFields* frameFields)\n"
+        "    {\n"
+        "        m_msg.reset();\n"
+        "        m_msgIdx = 0U;\n"
+        "        auto es = comms::ErrorStatus::Success;\n"
+        "        if (frameFields == nullptr) {\n"
+        "            es = m_frame.read(m_msg, iter, len, comms::protocol::msgId(m_msgId), comms::protocol::msgIndex(m_msgIdx));\n"
+        "        }\n"
+        "        else {\n"
+        "            es = m_frame.readFieldsCached(*frameFields, m_msg, iter, len, comms::protocol::msgId(m_msgId), comms::protocol::msgIndex(m_msgIdx));\n"
+        "        }\n\n"
+        "        if (es != comms::ErrorStatus::Success) {\n"
+        "            m_msg.reset();\n"
+        "        }\n"
+        "        return es;\n"
+        "    }\n\n"
         "    Frame m_frame;\n"
+        "    Frame::MsgPtr m_msg;\n"
+        "    #^#MSG_ID#$# m_msgId = static_cast<#^#MSG_ID#$#>(0);\n"
+        "    std::size_t m_msgIdx = 0U;\n"
         "};\n";    
 
     util::StringsList allFieldsAcc;
@@ -334,6 +441,7 @@ std::string SwigFrame::swigFrameCodeInternal() const
         {"COMMS_CLASS", comms::scopeFor(*this, gen)},
         {"DATA_BUF", SwigDataBuf::swigClassName(gen)},
         {"MAIN_NS", gen.protocolSchema().mainNamespace()},
+        {"MSG_ID", comms::scopeForRoot(strings::msgIdEnumNameStr(), gen)},
         {"PROT_OPTS", SwigProtocolOptions::swigClassName(gen)},
         {"ALL_FIELDS_VALUES", util::strListToString(allFieldsAcc, ",\n", "")},
         {"FRAME_FIELDS_VALUES", util::strListToString(frameFieldsAcc, ",\n", "")},
@@ -348,6 +456,86 @@ std::string SwigFrame::swigFrameCodeInternal() const
     return util::processTemplate(Templ, repl);   
 }
 
+std::string SwigFrame::swigBatchDeclInternal() const
+{
+    static const std::string Templ = 
+        "class #^#CLASS_NAME#$#_Batch\n"
+        "{\n"
+        "public:\n"
+        "    #^#SIZE_T#$# size() const;\n"
+        "    #^#MSG_ID#$# id(#^#SIZE_T#$# idx) const;\n"
+        "    #^#SIZE_T#$# offset(#^#SIZE_T#$# idx) const;\n"
+        "    #^#SIZE_T#$# length(#^#SIZE_T#$# idx) const;\n"
+        "    std::shared_ptr<#^#INTERFACE#$#> message(#^#SIZE_T#$# idx) const;\n"
+        "    void clear();\n"
+        "};\n";
+
+    return util::processTemplate(Templ, swigBatchReplInternal());
+}
+
+std::string SwigFrame::swigBatchCodeInternal() const
+{
+    static const std::string Templ = 
+        "// Result of the batched input processing, out of range indices yield default values\n"
+        "class #^#CLASS_NAME#$#_Batch\n"
+        "{\n"
+        "public:\n"
+        "    #^#SIZE_T#$# size() const\n"
+        "    {\n"
+        "        return static_cast<#^#SIZE_T#$#>(m_entries.size());\n"
+        "    }\n\n"
+        "    #^#MSG_ID#$# id(#^#SIZE_T#$# idx) const\n"
+        "    {\n"
+        "        return (idx < m_entries.size()) ? m_entries[idx].m_id : static_cast<#^#MSG_ID#$#>(0);\n"
+        "    }\n\n"
+        "    #^#SIZE_T#$# offset(#^#SIZE_T#$# idx) const\n"
+        "    {\n"
+        "        return (idx < m_entries.size()) ? m_entries[idx].m_offset : 0U;\n"
+        "    }\n\n"
+        "    #^#SIZE_T#$# length(#^#SIZE_T#$# idx) const\n"
+        "    {\n"
+        "        return (idx < m_entries.size()) ? m_entries[idx].m_length : 0U;\n"
+        "    }\n\n"
+        "    // Available only when the messages were requested to be kept, shared with the batch\n"
+        "    std::shared_ptr<#^#INTERFACE#$#> message(#^#SIZE_T#$# idx) const\n"
+        "    {\n"
+        "        return (idx < m_entries.size()) ? m_entries[idx].m_msg : nullptr;\n"
+        "    }\n\n"
+        "    void clear()\n"
+        "    {\n"
+        "        m_entries.clear();\n"
+        "    }\n\n"
+        "    void add(#^#MSG_ID#$# msgId, #^#SIZE_T#$# msgOffset, #^#SIZE_T#$# msgLength, std::shared_ptr<#^#INTERFACE#$#> msg)\n"
+        "    {\n"
+        "        m_entries.push_back(Entry{msgId, msgOffset, msgLength, std::move(msg)});\n"
+        "    }\n\n"
+        "private:\n"
+        "    struct Entry\n"
+        "    {\n"
+        "        #^#MSG_ID#$# m_id;\n"
+        "        #^#SIZE_T#$# m_offset;\n"
+        "        #^#SIZE_T#$# m_length;\n"
+        "        std::shared_ptr<#^#INTERFACE#$#> m_msg;\n"
+        "    };\n\n"
+        "    std::vector<Entry> m_entries;\n"
+        "};\n";
+
+    return util::processTemplate(Templ, swigBatchReplInternal());
+}
+
+util::ReplacementMap SwigFrame::swigBatchReplInternal() const
+{
+    auto& gen = SwigGenerator::cast(generator());
+    auto* iFace = gen.swigMainInterface();
+    assert(iFace != nullptr);
+    return util::ReplacementMap {
+        {"CLASS_NAME", gen.swigClassName(*this)},
+        {"INTERFACE", gen.swigClassName(*iFace)},
+        {"SIZE_T", gen.swigConvertCppType("std::size_t")},
+        {"MSG_ID", SwigMsgId::swigClassName(gen)},
+    };
+}
+
 std::string SwigFrame::swigAllFieldsInternal() const
 {
     static const std::string Templ = 
@@ -62,6 +62,9 @@ private:
     std::string swigLayersAccCodeInternal() const;
     std::string swigFrameCodeInternal() const;
     std::string swigAllFieldsInternal() const;
+    std::string swigBatchDeclInternal() const;
+    std::string swigBatchCodeInternal() const;
+    commsdsl::gen::util::ReplacementMap swigBatchReplInternal() const;
 
     SwigLayersList m_swigLayers;
     bool m_validFrame = true;
@@ -153,7 +153,19 @@ void SwigInterface::swigAddDef(StringsList& list) const
         f->swigAddDef(list);
     }
 
+    static const std::string Templ = 
+        "#ifdef SWIGPYTHON\n"
+        "%thread #^#CLASS_NAME#$#::read;\n"
+        "%thread #^#CLASS_NAME#$#::write;\n"
+        "#endif // #ifdef SWIGPYTHON";
+
     auto& gen = SwigGenerator::cast(generator());
+    util::ReplacementMap repl = {
+        {"CLASS_NAME", gen.swigClassName(*this)},
+    };
+
+    list.push_back(util::processTemplate(Templ, repl));
+    list.push_back("%shared_ptr(" + gen.swigClassName(*this) + ");");
     list.push_back("%nodefaultctor " + gen.swigClassName(*this) + ";");
     list.push_back(SwigGenerator::swigDefInclude(comms::relHeaderPathFor(*this, generator())));
 }
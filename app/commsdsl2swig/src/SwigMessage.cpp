@@ -137,6 +137,7 @@ void SwigMessage::swigAddDef(StringsList& list) const
     }
 
     static const std::string Templ = 
+        "%shared_ptr(#^#CLASS_NAME#$#);\n"
         "%rename(eq_#^#CLASS_NAME#$#) operator==(const #^#CLASS_NAME#$#&, const #^#CLASS_NAME#$#&);";
 
     util::ReplacementMap repl = {
@@ -37,6 +37,8 @@ namespace commsdsl2swig
 namespace 
 {
 
+const std::string DynMemMsgFactoryName("AllMessagesDynMemMsgFactory");
+
 std::string swigCodeInternal(const SwigGenerator& generator, std::size_t idx)
 {
     assert(idx < generator.schemas().size());
@@ -74,6 +76,113 @@ std::string swigCodeInternal(const SwigGenerator& generator, std::size_t idx)
     return util::processTemplate(Templ, repl);
 }
 
+std::string msgFactoryOptionsInternal(const SwigGenerator& generator, const commsdsl::gen::Namespace& ns, const std::string& baseOpts)
+{
+    util::StringsList elems;
+    for (auto& nsPtr : ns.namespaces()) {
+        auto str = msgFactoryOptionsInternal(generator, *nsPtr, baseOpts);
+        if (!str.empty()) {
+            elems.push_back(std::move(str));
+        }
+    }
+
+    bool hasMainNs = (generator.schemas().size() > 1U);
+    util::StringsList frameElems;
+    for (auto& fPtr : ns.frames()) {
+        util::StringsList layerElems;
+        for (auto& lPtr : fPtr->layers()) {
+            if (lPtr->dslObj().kind() != commsdsl::parse::Layer::Kind::Id) {
+                continue;
+            }
+
+            static const std::string Templ =
+                "using #^#NAME#$# =\n"
+                "    std::tuple<\n"
+                "        comms::option::app::MsgFactoryTempl<MsgFactory>,\n"
+                "        typename #^#BASE_OPTS#$#::#^#SCOPE#$#\n"
+                "    >;\n";
+
+            util::ReplacementMap repl = {
+                {"NAME", comms::className(lPtr->dslObj().name())},
+                {"BASE_OPTS", baseOpts},
+                {"SCOPE", comms::scopeFor(*lPtr, generator, hasMainNs)},
+            };
+
+            layerElems.push_back(util::processTemplate(Templ, repl));
+        }
+
+        if (layerElems.empty()) {
+            continue;
+        }
+
+        static const std::string Templ =
+            "struct #^#NAME#$##^#SUFFIX#$# : public #^#BASE_OPTS#$#::#^#SCOPE#$##^#SUFFIX#$#\n"
+            "{\n"
+            "    #^#LAYERS_OPTS#$#\n"
+            "}; // struct #^#NAME#$##^#SUFFIX#$#\n";
+
+        util::ReplacementMap repl = {
+            {"NAME", comms::className(fPtr->dslObj().name())},
+            {"SUFFIX", strings::layersSuffixStr()},
+            {"BASE_OPTS", baseOpts},
+            {"SCOPE", comms::scopeFor(*fPtr, generator, hasMainNs)},
+            {"LAYERS_OPTS", util::strListToString(layerElems, "\n", "")},
+        };
+
+        frameElems.push_back(util::processTemplate(Templ, repl));
+    }
+
+    auto nsScope = comms::scopeFor(ns, generator, hasMainNs);
+    if (!frameElems.empty()) {
+        static const std::string Templ = 
+            "struct #^#FRAME_NS#$# : public #^#BASE_OPTS#$#::#^#NS#$##^#FRAME_NS#$#\n"
+            "{\n"
+            "    #^#OPTS#$#\n"
+            "}; // struct #^#FRAME_NS#$#\n";
+
+        util::ReplacementMap repl = {
+            {"FRAME_NS", strings::frameNamespaceStr()},
+            {"BASE_OPTS", baseOpts},
+            {"NS", nsScope},
+            {"OPTS", util::strListToString(frameElems, "\n", "")},
+        };
+
+        if (!repl["NS"].empty()) {
+            repl["NS"].append("::");
+        }
+
+        elems.push_back(util::processTemplate(Templ, repl));
+    }
+
+    if (elems.empty()) {
+        return strings::emptyString();
+    }
+
+    auto nsName = ns.dslObj().name();
+    if (nsName.empty() && (!hasMainNs)) {
+        return util::strListToString(elems, "\n", "");
+    }
+
+    if (nsName.empty()) {
+        nsName = generator.currentSchema().mainNamespace();
+    }
+
+    static const std::string Templ = 
+        "struct #^#NAME#$# : public #^#BASE_OPTS#$#::#^#NS#$#\n"
+        "{\n"
+        "    #^#BODY#$#\n"
+        "}; // struct #^#NAME#$#\n";
+
+    util::ReplacementMap repl = {
+        {"NAME", std::move(nsName)},
+        {"BASE_OPTS", baseOpts},
+        {"NS", std::move(nsScope)},
+        {"BODY", util::strListToString(elems, "\n", "")},
+    };
+
+    return util::processTemplate(Templ, repl);
+}
+
 } // namespace 
 
 void SwigProtocolOptions::swigAddCodeIncludes(SwigGenerator& generator, StringsList& list)
@@ -84,6 +193,7 @@ void SwigProtocolOptions::swigAddCodeIncludes(SwigGenerator& generator, StringsL
 
     assert(generator.isCurrentProtocolSchema());
 
+    list.push_back("<array>");
     list.push_back(comms::relHeaderForOptions(strings::allMessagesDynMemMsgFactoryDefaultOptionsClassStr(), generator));
     auto& schemas = generator.schemas();
     for (auto idx = 0U; idx < schemas.size(); ++idx) {
@@ -107,19 +217,117 @@ void SwigProtocolOptions::swigAddCode(const SwigGenerator& generator, StringsLis
     assert(generator.isCurrentProtocolSchema());
 
     const std::string Templ = 
-        "using #^#OPT_TYPE#$# =\n"
+        "using #^#OPT_TYPE#$#Base =\n"
         "    #^#MSG_FACT_OPTS#$#T<\n"
         "        #^#CODE#$#\n"
-        "    >;\n\n";
+        "    >;\n\n"
+        "// Message factory of the frames, keeps a single object per message type and\n"
+        "// returns it for every following read of the same message to avoid memory allocation.\n"
+        "// The returned pointer doesn't own the object.\n"
+        "template <typename TInterface, typename TAllMessages, typename... TOptions>\n"
+        "class #^#FACTORY#$# : public #^#DYN_MEM_FACTORY#$#<TInterface, #^#OPT_TYPE#$#Base>\n"
+        "{\n"
+        "    using Base = #^#DYN_MEM_FACTORY#$#<TInterface, #^#OPT_TYPE#$#Base>;\n"
+        "    using Cache = std::array<std::unique_ptr<TInterface>, std::tuple_size<TAllMessages>::value>;\n\n"
+        "    struct NoDeleter\n"
+        "    {\n"
+        "        void operator()(TInterface*) const {}\n"
+        "    };\n\n"
+        "public:\n"
+        "    using MsgIdParamType = typename Base::MsgIdParamType;\n"
+        "    using MsgPtr = std::unique_ptr<TInterface, NoDeleter>;\n"
+        "    using CreateFailureReason = typename Base::CreateFailureReason;\n"
+        "    using GenericMessage = void;\n\n"
+        "    #^#FACTORY#$#() = default;\n\n"
+        "    // The cached message objects are not copied\n"
+        "    #^#FACTORY#$#(const #^#FACTORY#$#&) : Base() {}\n\n"
+        "    #^#FACTORY#$#& operator=(const #^#FACTORY#$#&)\n"
+        "    {\n"
+        "        return *this;\n"
+        "    }\n\n"
+        "    MsgPtr createMsg(MsgIdParamType id, unsigned idx = 0U, CreateFailureReason* reason = nullptr) const\n"
+        "    {\n"
+        "        CreateHandler handler(m_msgs);\n"
+        "        bool created = comms::dispatchMsgType<TAllMessages>(id, idx, handler);\n"
+        "        if (reason != nullptr) {\n"
+        "            *reason = created ? CreateFailureReason::None : CreateFailureReason::InvalidId;\n"
+        "        }\n"
+        "        return MsgPtr(handler.result());\n"
+        "    }\n\n"
+        "    MsgPtr createGenericMsg(MsgIdParamType id, unsigned idx = 0U) const\n"
+        "    {\n"
+        "        static_cast<void>(id);\n"
+        "        static_cast<void>(idx);\n"
+        "        return MsgPtr();\n"
+        "    }\n\n"
+        "    static constexpr bool hasGenericMessageSupport()\n"
+        "    {\n"
+        "        return false;\n"
+        "    }\n\n"
+        "private:\n"
+        "    template <typename TMsg, typename TMsgs>\n"
+        "    struct MsgIdx;\n\n"
+        "    template <typename TMsg, typename... TRest>\n"
+        "    struct MsgIdx<TMsg, std::tuple<TMsg, TRest...> > : public std::integral_constant<std::size_t, 0U> {};\n\n"
+        "    template <typename TMsg, typename TFirst, typename... TRest>\n"
+        "    struct MsgIdx<TMsg, std::tuple<TFirst, TRest...> > :\n"
+        "        public std::integral_constant<std::size_t, 1U + MsgIdx<TMsg, std::tuple<TRest...> >::value> {};\n\n"
+        "    class CreateHandler\n"
+        "    {\n"
+        "    public:\n"
+        "        explicit CreateHandler(Cache& msgs) : m_msgs(msgs) {}\n\n"
+        "        template <typename TMsg>\n"
+        "        void handle()\n"
+        "        {\n"
+        "            auto& msg = m_msgs[MsgIdx<TMsg, TAllMessages>::value];\n"
+        "            if (!msg) {\n"
+        "                msg.reset(new TMsg);\n"
+        "            }\n"
+        "            else {\n"
+        "                // Restore the default state, the copy assignment keeps the storage capacity\n"
+        "                static const TMsg DefaultMsg{};\n"
+        "                static_cast<TMsg&>(*msg) = DefaultMsg;\n"
+        "            }\n"
+        "            m_msg = msg.get();\n"
+        "        }\n\n"
+        "        TInterface* result() const\n"
+        "        {\n"
+        "            return m_msg;\n"
+        "        }\n\n"
+        "    private:\n"
+        "        Cache& m_msgs;\n"
+        "        TInterface* m_msg = nullptr;\n"
+        "    };\n\n"
+        "    mutable Cache m_msgs;\n"
+        "};\n\n"
+        "struct #^#OPT_TYPE#$# : public #^#OPT_TYPE#$#Base\n"
+        "{\n"
+        "    template <typename TInterface, typename TAllMessages, typename... TOptions>\n"
+        "    using MsgFactory = #^#FACTORY#$#<TInterface, TAllMessages>;\n\n"
+        "    #^#FACTORY_OPTS#$#\n"
+        "};\n\n";
 
     auto msgFactOptions = comms::scopeForOptions(strings::allMessagesDynMemMsgFactoryDefaultOptionsClassStr(), generator);
+    auto optType = swigClassName(generator);
     util::ReplacementMap repl = {
-        {"OPT_TYPE", swigClassName(generator)},
+        {"OPT_TYPE", optType},
         {"CODE", swigCodeInternal(generator, generator.schemas().size() - 1U)},
-        {"MSG_FACT_OPTS", std::move(msgFactOptions)}
+        {"MSG_FACT_OPTS", std::move(msgFactOptions)},
+        {"FACTORY", generator.protocolSchema().mainNamespace() + "_MsgCacheFactory"},
     };
 
     generator.chooseProtocolSchema();
+    repl["DYN_MEM_FACTORY"] = comms::scopeForFactory(DynMemMsgFactoryName, generator);
+
+    util::StringsList factoryOpts;
+    for (auto& nsPtr : generator.currentSchema().namespaces()) {
+        auto str = msgFactoryOptionsInternal(generator, *nsPtr, optType + "Base");
+        if (!str.empty()) {
+            factoryOpts.push_back(std::move(str));
+        }
+    }
+    repl["FACTORY_OPTS"] = util::strListToString(factoryOpts, "\n", "");
+
     list.push_back(util::processTemplate(Templ, repl));
 }
 
@@ -1,5 +1,6 @@
 import os
 import sys
+import threading
 import unittest
 
 import test1
@@ -57,6 +58,125 @@ class TestProtocol(unittest.TestCase):
         outData = f.writeMessage(m)
         self.assertEqual(bytearray(outData), bytearray(b'\x01\x01\x01\x01\x02'))
 
+    def test_4(self):
+        f = test1.frame_Frame()
+        b = test1.frame_Frame_Batch()
+        buf = bytearray(b'\x01\x01\x02\x03\x04\x02\x01\x05\x06\x07')
+        self.assertEqual(f.processInputDataBatch(buf, b), 6)
+        self.assertEqual(b.size(), 2)
+        self.assertEqual(b.id(0), test1.MsgId_Msg1)
+        self.assertEqual(b.offset(0), 0)
+        self.assertEqual(b.length(0), 5)
+        self.assertEqual(b.id(1), test1.MsgId_Msg2)
+        self.assertEqual(b.offset(1), 5)
+        self.assertEqual(b.length(1), 1)
+        self.assertIsNone(b.message(0))
+
+        f1 = 0
+        def test_msg1(msg):
+            nonlocal f1
+            f1 = msg.field_f1().getValue()
+
+        b.clear()
+        self.assertEqual(f.processInputDataBatch(buf, b, True), 6)
+        self.assertEqual(b.size(), 2)
+        h = MsgHandler(test_msg1)
+        m = b.message(0)
+        self.assertIsNone(b.message(2))
+
+        # The message object is shared with the batch and outlives its clearing
+        b.clear()
+        m.dispatch(h)
+        self.assertEqual(f1, 0x030201)
+
+    def test_5(self):
+        # Decoding releases the GIL, the handler callbacks of another frame
+        # are invoked while the decoding thread is still inside the call
+        msgsCount = 200000
+        buf = bytearray(b'\x01\x01\x02\x03\x04') * msgsCount
+        started = threading.Event()
+        done = False
+        results = []
+
+        def decode():
+            nonlocal done
+            f = test1.frame_Frame()
+            b = test1.frame_Frame_Batch()
+            started.set()
+            results.append((f.processInputDataBatch(buf, b), b.size()))
+            done = True
+
+        observed = 0
+        def check_msg(msg):
+            nonlocal observed
+            if not done:
+                observed += 1
+
+        t = threading.Thread(target=decode)
+        t.start()
+        started.wait()
+        f = test1.frame_Frame()
+        h = MsgHandler(check_msg)
+        f.processInputData(bytearray(b'\x02'), h)
+        t.join()
+
+        self.assertEqual(results, [(len(buf), msgsCount)])
+        self.assertEqual(h.msg2, True)
+        self.assertEqual(observed, 1)
+
+    def test_6(self):
+        # Consecutive frames of the same message type reuse the message object
+        msgs = []
+        def record_msg(msg):
+            msgs.append((int(msg.this), msg.field_f1().getValue(), msg.field_f2().getValue()))
+
+        f = test1.frame_Frame()
+        h = MsgHandler(record_msg)
+        buf = bytearray(b'\x01\x01\x02\x03\x04\x01\x05\x06\x07\x08')
+        self.assertEqual(f.processInputData(buf, h), len(buf))
+        self.assertEqual(len(msgs), 2)
+        self.assertEqual(msgs[0][0], msgs[1][0])
+        self.assertEqual(msgs[0][1:], (0x030201, 0x04))
+        self.assertEqual(msgs[1][1:], (0x070605, 0x08))
+
+    def test_7(self):
+        # Interleaved message types get their own cached objects
+        msgs = []
+        def record_msg(msg):
+            if isinstance(msg, test1.message_Msg1):
+                msgs.append((int(msg.this), msg.field_f1().getValue()))
+            else:
+                msgs.append((int(msg.this), None))
+
+        f = test1.frame_Frame()
+        h = MsgHandler(record_msg)
+        buf = bytearray(b'\x01\x01\x02\x03\x04\x02\x01\x05\x06\x07\x08')
+        self.assertEqual(f.processInputData(buf, h), len(buf))
+        self.assertEqual(len(msgs), 3)
+        self.assertEqual(msgs[0][0], msgs[2][0])
+        self.assertNotEqual(msgs[0][0], msgs[1][0])
+        self.assertEqual(msgs[0][1], 0x030201)
+        self.assertIsNone(msgs[1][1])
+        self.assertEqual(msgs[2][1], 0x070605)
+
+    def test_8(self):
+        # Invalid message ID doesn't prevent reading of the following message
+        f1 = 0
+        f2 = 0
+        def test_msg1(msg):
+            nonlocal f1
+            nonlocal f2
+            f1 = msg.field_f1().getValue()
+            f2 = msg.field_f2().getValue()
+
+        f = test1.frame_Frame()
+        h = MsgHandler(test_msg1)
+        buf = bytearray(b'\x05\x01\x01\x02\x03\x04')
+        self.assertEqual(f.processInputData(buf, h), len(buf))
+        self.assertEqual(h.msg1, True)
+        self.assertEqual(f1, 0x030201)
+        self.assertEqual(f2, 0x04)
+
 
 if __name__ == '__main__':
     unittest.main()
@@ -0,0 +1,657 @@
+//
+// Copyright 2019 - 2023 (C). Alex Robenko. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "Bench.h"
+
+#include <fstream>
+
+#include "TestGenerator.h"
+
+#include "commsdsl/gen/comms.h"
+#include "commsdsl/gen/util.h"
+
+namespace commsdsl2test
+{
+
+namespace
+{
+
+using ReplacementMap = commsdsl::gen::util::ReplacementMap;
+
+} // namespace
+
+
+bool Bench::write(TestGenerator& generator)
+{
+    Bench obj(generator);
+    return obj.writeBench();
+}
+
+bool Bench::writeBench() const
+{
+    auto benchName =
+        m_generator.currentSchema().mainNamespace() + '_' + "bench.cpp";
+
+    auto filePath = commsdsl::gen::util::pathAddElem(m_generator.getOutputDir(), benchName);
+
+    m_generator.logger().info("Generating " + filePath);
+    std::ofstream stream(filePath);
+    if (!stream) {
+        m_generator.logger().error("Failed to open \"" + filePath + "\" for writing.");
+        return false;
+    }
+
+    ReplacementMap repl = {
+        std::make_pair("GEN_COMMENT", m_generator.fileGeneratedComment()),
+        std::make_pair("BATCH_PROCESSOR_HEADER", commsdsl::gen::comms::relHeaderForDispatch("MsgBatchProcessor", m_generator)),
+        std::make_pair("BATCH_PROCESSOR", commsdsl::gen::comms::scopeForDispatch("MsgBatchProcessor", m_generator)),
+    };
+
+    static const std::string Template =
+        "#^#GEN_COMMENT#$#\n"
+        "// Measures default construction, write, read, valid, refresh and dispatch\n"
+        "// of every input message as well as the throughput of the frames processing\n"
+        "// one message at a time and in batches, and reports the results as JSON.\n"
+        "// Usage: <app> [iterations] [seed]\n\n"
+        "#include <iostream>\n"
+        "#include <cstdint>\n"
+        "#include <cstdlib>\n"
+        "#include <cassert>\n"
+        "#include <chrono>\n"
+        "#include <random>\n"
+        "#include <vector>\n"
+        "#include <algorithm>\n"
+        "#include <limits>\n"
+        "#include <memory>\n"
+        "#include <tuple>\n"
+        "#include <type_traits>\n\n"
+        "#include \"comms/fields.h\"\n"
+        "#include \"comms/ErrorStatus.h\"\n"
+        "#include \"comms/process.h\"\n\n"
+        "#define QUOTES_(x_) #x_\n"
+        "#define QUOTES(x_) QUOTES_(x_)\n\n"
+        "#ifndef INTERFACE_HEADER\n"
+        "#error \"Interface header needs to be defined\"\n"
+        "#endif\n\n"
+        "#ifndef INTERFACE\n"
+        "#error \"Interface type needs to be defined\"\n"
+        "#endif\n\n"
+        "#ifndef FRAME_HEADER\n"
+        "#error \"Frame header needs to be defined\"\n"
+        "#endif\n\n"
+        "#ifndef FRAME\n"
+        "#error \"Frame type needs to be defined\"\n"
+        "#endif\n\n"
+        "#ifndef OPTIONS_HEADER\n"
+        "#error \"Options header needs to be defined\"\n"
+        "#endif\n\n"
+        "#ifndef OPTIONS\n"
+        "#error \"Options type needs to be defined\"\n"
+        "#endif\n\n"
+        "#ifndef INPUT_MESSAGES_HEADER\n"
+        "#error \"Input messages header needs to be defined\"\n"
+        "#endif\n\n"
+        "#ifndef INPUT_MESSAGES\n"
+        "#error \"Input messages type needs to be defined\"\n"
+        "#endif\n\n"
+        "#include QUOTES(INTERFACE_HEADER)\n"
+        "#include QUOTES(FRAME_HEADER)\n"
+        "#include QUOTES(OPTIONS_HEADER)\n"
+        "#include QUOTES(INPUT_MESSAGES_HEADER)\n"
+        "#include \"#^#BATCH_PROCESSOR_HEADER#$#\"\n\n"
+        "namespace\n"
+        "{\n\n"
+        "class Handler;\n"
+        "using Message = \n"
+        "    INTERFACE<\n"
+        "        comms::option::app::ReadIterator<const std::uint8_t*>,\n"
+        "        comms::option::app::WriteIterator<std::uint8_t*>,\n"
+        "        comms::option::app::LengthInfoInterface,\n"
+        "        comms::option::app::ValidCheckInterface,\n"
+        "        comms::option::app::RefreshInterface,\n"
+        "        comms::option::app::Handler<Handler>\n"
+        "    >;\n\n"
+        "using AppOptions = OPTIONS;\n"
+        "using InputMessages = INPUT_MESSAGES<Message, AppOptions>;\n"
+        "using Frame = FRAME<Message, InputMessages, AppOptions>;\n"
+        "using Rnd = std::mt19937_64;\n"
+        "using Clock = std::chrono::steady_clock;\n\n"
+        "// Number of differently randomized objects of every message type\n"
+        "const std::size_t PoolSize = 16U;\n\n"
+
+        "// Maximal number of characters / elements put into randomized strings and lists\n"
+        "const std::size_t MaxRandomElems = 8U;\n\n"
+        "// Maximal number of messages decoded in a single batch\n"
+        "const std::size_t BatchSize = 32U;\n\n"
+        "using BatchProcessor = #^#BATCH_PROCESSOR#$#<Frame, BatchSize, AppOptions>;\n\n"
+        "template <typename T>\n"
+        "void doNotOptimize(const T& value)\n"
+        "{\n"
+        "#if defined(__GNUC__) || defined(__clang__)\n"
+        "    asm volatile(\"\" : : \"r,m\"(value) : \"memory\");\n"
+        "#else\n"
+        "    static const void* volatile Sink = nullptr;\n"
+        "    Sink = &value;\n"
+        "#endif\n"
+        "}\n\n"
+        "// Picks random value out of the selected valid range\n"
+        "class RangeValueSelector\n"
+        "{\n"
+        "public:\n"
+        "    RangeValueSelector(Rnd& rnd, std::size_t selected) : m_rnd(rnd), m_selected(selected) {}\n\n"
+        "    template <typename TRange>\n"
+        "    void operator()()\n"
+        "    {\n"
+        "        if (m_idx++ != m_selected) {\n"
+        "            return;\n"
+        "        }\n\n"
+        "        using MinType = typename std::tuple_element<0, TRange>::type;\n"
+        "        using MaxType = typename std::tuple_element<1, TRange>::type;\n"
+        "        auto minValue = static_cast<std::uintmax_t>(MinType::value);\n"
+        "        auto width = static_cast<std::uintmax_t>(MaxType::value) - minValue;\n"
+        "        auto offset = static_cast<std::uintmax_t>(m_rnd());\n"
+        "        if (width < std::numeric_limits<std::uintmax_t>::max()) {\n"
+        "            offset %= (width + 1U);\n"
+        "        }\n\n"
+        "        m_value = minValue + offset;\n"
+        "    }\n\n"
+        "    std::uintmax_t value() const\n"
+        "    {\n"
+        "        return m_value;\n"
+        "    }\n\n"
+        "private:\n"
+        "    Rnd& m_rnd;\n"
+        "    std::size_t m_selected = 0U;\n"
+        "    std::size_t m_idx = 0U;\n"
+        "    std::uintmax_t m_value = 0U;\n"
+        "};\n\n"
+        "// Random value out of the valid ranges defined in the schema\n"
+        "// (reflected in the options of the field)\n"
+        "template <typename TField>\n"
+        "std::uintmax_t randomValidValue(Rnd& rnd, std::true_type)\n"
+        "{\n"
+        "    using Ranges = typename TField::ParsedOptions::MultiRangeValidationRanges;\n"
+        "    static const std::size_t RangesCount = std::tuple_size<Ranges>::value;\n"
+        "    static_assert(0U < RangesCount, \"Valid ranges are expected\");\n"
+        "    RangeValueSelector selector(rnd, static_cast<std::size_t>(rnd() % RangesCount));\n"
+        "    comms::util::tupleForEachType<Ranges>(selector);\n"
+        "    return selector.value();\n"
+        "}\n\n"
+        "// No valid ranges, any value is valid\n"
+        "template <typename TField>\n"
+        "std::uintmax_t randomValidValue(Rnd& rnd, std::false_type)\n"
+        "{\n"
+        "    return static_cast<std::uintmax_t>(rnd());\n"
+        "}\n\n"
+        "template <typename TField>\n"
+        "std::uintmax_t randomValidValue(Rnd& rnd)\n"
+        "{\n"
+        "    using HasRanges = std::integral_constant<bool, TField::ParsedOptions::HasMultiRangeValidation>;\n"
+        "    return randomValidValue<TField>(rnd, HasRanges());\n"
+        "}\n\n"
+        "std::size_t randomCount(Rnd& rnd, std::size_t maxCount)\n"
+        "{\n"
+        "    return static_cast<std::size_t>(rnd() % (std::min(maxCount, MaxRandomElems) + 1U));\n"
+        "}\n\n"
+        "// Forward declaration of function used to randomize variant field\n"
+        "template <typename TField>\n"
+        "void randomizeVariantField(TField& field, Rnd& rnd);\n\n"
+        "class FieldRandomizer\n"
+        "{\n"
+        "public:\n"
+        "    explicit FieldRandomizer(Rnd& rnd) : m_rnd(rnd) {}\n\n"
+        "    template <typename TField>\n"
+        "    void operator()(TField& field) const\n"
+        "    {\n"
+        "        using FieldType = typename std::decay<decltype(field)>::type;\n"
+        "        using Tag = FieldTag<FieldType>;\n"
+        "        randomizeField<TField>(field, Tag());\n"
+        "    }\n\n"
+        "private:\n"
+        "    struct IntElementTag {};\n"
+        "    struct FieldElementTag {};\n"
+        "    struct EnumFieldTag {};\n"
+        "    struct GenericFieldTag {};\n\n"
+        "    template <typename TField>\n"
+        "    using FieldTag = \n"
+        "        typename std::conditional<\n"
+        "            comms::field::isEnumValue<TField>(),\n"
+        "            EnumFieldTag,\n"
+        "            GenericFieldTag\n"
+        "        >::type;\n\n"
+        "    // The valid ranges depending on the protocol version are not reflected\n"
+        "    // in the field options, the original value is restored when the\n"
+        "    // assigned one is rejected by such check.\n"
+        "    template <typename TField, typename TValue>\n"
+        "    static void assignValue(TField& field, TValue value)\n"
+        "    {\n"
+        "        auto origValue = field.value();\n"
+        "        field.value() = value;\n"
+        "        if (!field.valid()) {\n"
+        "            field.value() = origValue;\n"
+        "        }\n"
+        "    }\n\n"
+        "    template <typename TField, typename TFieldBase, typename T, typename... TOptions>\n"
+        "    void randomizeField(comms::field::IntValue<TFieldBase, T, TOptions...>& field, GenericFieldTag) const\n"
+        "    {\n"
+        "        auto& actField = static_cast<TField&>(field);\n"
+        "        using ValueType = typename TField::ValueType;\n"
+        "        assignValue(actField, static_cast<ValueType>(randomValidValue<TField>(m_rnd)));\n"
+        "    }\n\n"
+        "    template <typename TField>\n"
+        "    void randomizeField(TField& field, EnumFieldTag) const\n"
+        "    {\n"
+        "        using ValueType = typename TField::ValueType;\n"
+        "        using UnderlyingType = typename std::underlying_type<ValueType>::type;\n"
+        "        auto value = static_cast<UnderlyingType>(randomValidValue<TField>(m_rnd));\n"
+        "        assignValue(field, static_cast<ValueType>(value));\n"
+        "    }\n\n"
+        "    // Flips random bits, the reserved ones are reverted by their own validity check\n"
+        "    template <typename TField, typename TFieldBase, typename... TOptions>\n"
+        "    void randomizeField(comms::field::BitmaskValue<TFieldBase, TOptions...>& field, GenericFieldTag) const\n"
+        "    {\n"
+        "        auto& actField = static_cast<TField&>(field);\n"
+        "        using ValueType = typename TField::ValueType;\n"
+        "        auto flips = static_cast<ValueType>(m_rnd());\n"
+        "        for (auto idx = 0U; idx < static_cast<unsigned>(std::numeric_limits<ValueType>::digits); ++idx) {\n"
+        "            auto mask = static_cast<ValueType>(static_cast<ValueType>(1U) << idx);\n"
+        "            if ((flips & mask) == 0) {\n"
+        "                continue;\n"
+        "            }\n\n"
+        "            actField.value() = static_cast<ValueType>(actField.value() ^ mask);\n"
+        "            if (!actField.valid()) {\n"
+        "                actField.value() = static_cast<ValueType>(actField.value() ^ mask);\n"
+        "            }\n"
+        "        }\n"
+        "    }\n\n"
+        "    template <typename TField, typename TFieldBase, typename TMembers, typename... TOptions>\n"
+        "    void randomizeField(comms::field::Bitfield<TFieldBase, TMembers, TOptions...>& field, GenericFieldTag) const\n"
+        "    {\n"
+        "        auto& actField = static_cast<TField&>(field);\n"
+        "        comms::util::tupleForEach(actField.value(), *this);\n"
+        "    }\n\n"
+        "    template <typename TField, typename TFieldBase, typename TMembers, typename... TOptions>\n"
+        "    void randomizeField(comms::field::Bundle<TFieldBase, TMembers, TOptions...>& field, GenericFieldTag) const\n"
+        "    {\n"
+        "        auto& actField = static_cast<TField&>(field);\n"
+        "        comms::util::tupleForEach(actField.value(), *this);\n"
+        "    }\n\n"
+        "    template <typename TField, typename TFieldBase, typename T, typename... TOptions>\n"
+        "    void randomizeField(comms::field::FloatValue<TFieldBase, T, TOptions...>& field, GenericFieldTag) const\n"
+        "    {\n"
+        "        auto& actField = static_cast<TField&>(field);\n"
+        "        using ValueType = typename TField::ValueType;\n"
+        "        assignValue(actField, static_cast<ValueType>(static_cast<double>(m_rnd() % 20001U) / 10.0 - 1000.0));\n"
+        "    }\n\n"
+        "    template <typename TField, typename TFieldBase, typename... TOptions>\n"
+        "    void randomizeField(comms::field::String<TFieldBase, TOptions...>& field, GenericFieldTag) const\n"
+        "    {\n"
+        "        auto& actField = static_cast<TField&>(field);\n"
+        "        auto& str = actField.value();\n"
+        "        auto count = randomCount(m_rnd, str.max_size());\n"
+        "        str.clear();\n"
+        "        for (auto idx = 0U; idx < count; ++idx) {\n"
+        "            str.push_back(static_cast<char>('a' + static_cast<char>(m_rnd() % 26U)));\n"
+        "        }\n"
+        "    }\n\n"
+        "    template <typename TField, typename TFieldBase, typename TElement, typename... TOptions>\n"
+        "    void randomizeField(comms::field::ArrayList<TFieldBase, TElement, TOptions...>& field, GenericFieldTag) const\n"
+        "    {\n"
+        "        auto& actField = static_cast<TField&>(field);\n"
+        "        using FieldType = typename std::decay<decltype(actField)>::type;\n"
+        "        using Tag = \n"
+        "            typename std::conditional<\n"
+        "                std::is_integral<typename FieldType::ElementType>::value,\n"
+        "                IntElementTag,\n"
+        "                FieldElementTag\n"
+        "            >::type;\n\n"
+        "        randomizeArrayData(actField.value(), Tag());\n"
+        "    }\n\n"
+        "    template <typename TField, typename TOptField, typename... TOptions>\n"
+        "    void randomizeField(comms::field::Optional<TOptField, TOptions...>& field, GenericFieldTag) const\n"
+        "    {\n"
+        "        // The mode is updated by the message refresh\n"
+        "        auto& actField = static_cast<TField&>(field);\n"
+        "        (*this)(actField.field());\n"
+        "    }\n\n"
+        "    template <typename TField, typename TFieldBase, typename TMembers, typename... TOptions>\n"
+        "    void randomizeField(comms::field::Variant<TFieldBase, TMembers, TOptions...>& field, GenericFieldTag) const\n"
+        "    {\n"
+        "        auto& actField = static_cast<TField&>(field);\n"
+        "        randomizeVariantField(actField, m_rnd);\n"
+        "    }\n\n"
+        "    template <typename TVec>\n"
+        "    void randomizeArrayData(TVec& data, IntElementTag) const\n"
+        "    {\n"
+        "        using ElementType = typename TVec::value_type;\n"
+        "        auto count = randomCount(m_rnd, data.max_size());\n"
+        "        data.clear();\n"
+        "        for (auto idx = 0U; idx < count; ++idx) {\n"
+        "            data.push_back(static_cast<ElementType>(m_rnd()));\n"
+        "        }\n"
+        "    }\n\n"
+        "    template <typename TVec>\n"
+        "    void randomizeArrayData(TVec& data, FieldElementTag) const\n"
+        "    {\n"
+        "        auto count = randomCount(m_rnd, data.max_size());\n"
+        "        data.clear();\n"
+        "        for (auto idx = 0U; idx < count; ++idx) {\n"
+        "            data.emplace_back();\n"
+        "            (*this)(data.back());\n"
+        "        }\n"
+        "    }\n\n"
+        "    Rnd& m_rnd;\n"
+        "};\n\n"
+        "class VariantFieldRandomizer\n"
+        "{\n"
+        "public:\n"
+        "    explicit VariantFieldRandomizer(Rnd& rnd) : m_randomizer(rnd) {}\n\n"
+        "    template <std::size_t TIdx, typename TField>\n"
+        "    void operator()(TField& field)\n"
+        "    {\n"
+        "        m_randomizer(field);\n"
+        "    }\n"
+        "private:\n"
+        "    FieldRandomizer m_randomizer;\n"
+        "};\n\n"
+        "template <typename TField>\n"
+        "void randomizeVariantField(TField& field, Rnd& rnd)\n"
+        "{\n"
+        "    static const std::size_t MembersCount = std::tuple_size<typename TField::Members>::value;\n"
+        "    field.selectField(static_cast<std::size_t>(rnd() % MembersCount));\n"
+        "    field.currentFieldExec(VariantFieldRandomizer(rnd));\n"
+        "}\n\n"
+        "class Handler\n"
+        "{\n"
+        "public:\n"
+        "    template <typename TMsg>\n"
+        "    void handle(TMsg& msg)\n"
+        "    {\n"
+        "        static_cast<void>(msg);\n"
+        "        ++m_count;\n"
+        "    }\n\n"
+        "    // Handle unexpected messages\n"
+        "    void handle(Message&)\n"
+        "    {\n"
+        "        static constexpr bool Should_not_happen = false;\n"
+        "        static_cast<void>(Should_not_happen);\n"
+        "        assert(!Should_not_happen);\n"
+        "    }\n\n"
+        "    std::size_t count() const\n"
+        "    {\n"
+        "        return m_count;\n"
+        "    }\n\n"
+        "private:\n"
+        "    std::size_t m_count = 0U;\n"
+        "};\n\n"
+        "template <typename TFunc>\n"
+        "double measureNsPerOp(std::size_t iterations, TFunc&& func)\n"
+        "{\n"
+        "    auto start = Clock::now();\n"
+        "    for (std::size_t idx = 0U; idx < iterations; ++idx) {\n"
+        "        func(idx % PoolSize);\n"
+        "    }\n"
+        "    auto diff = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start);\n"
+        "    return static_cast<double>(diff.count()) / static_cast<double>(iterations);\n"
+        "}\n\n"
+        "class MessageBench\n"
+        "{\n"
+        "public:\n"
+        "    MessageBench(std::size_t iterations, Rnd& rnd) : m_iterations(iterations), m_rnd(rnd) {}\n\n"
+        "    template <typename TMsg>\n"
+        "    void operator()()\n"
+        "    {\n"
+        "        std::vector<TMsg> pool(PoolSize);\n"
+        "        for (auto& msg : pool) {\n"
+        "            comms::util::tupleForEach(msg.fields(), FieldRandomizer(m_rnd));\n"
+        "            msg.refresh();\n"
+        "            if (!msg.valid()) {\n"
+        "                // Fall back to the default values\n"
+        "                msg = TMsg();\n"
+        "            }\n"
+        "        }\n\n"
+        "        std::vector<std::size_t> lengths;\n"
+        "        lengths.reserve(pool.size());\n"
+        "        for (auto& msg : pool) {\n"
+        "            lengths.push_back(msg.length());\n"
+        "        }\n\n"
+        "        std::size_t totalLen = 0U;\n"
+        "        std::size_t bufSize = 0U;\n"
+        "        for (auto len : lengths) {\n"
+        "            totalLen += len;\n"
+        "            bufSize = std::max(bufSize, len);\n"
+        "        }\n\n"
+        "        std::vector<std::vector<std::uint8_t> > buffers(PoolSize, std::vector<std::uint8_t>(std::max(bufSize, static_cast<std::size_t>(1U))));\n"
+        "        for (std::size_t idx = 0U; idx < PoolSize; ++idx) {\n"
+        "            std::uint8_t* writeIter = buffers[idx].data();\n"
+        "            auto es = pool[idx].write(writeIter, bufSize);\n"
+        "            if (es != comms::ErrorStatus::Success) {\n"
+        "                std::cerr << \"ERROR: Failed to write \" << pool[idx].doName() << std::endl;\n"
+        "                std::exit(-1);\n"
+        "            }\n"
+        "        }\n\n"
+        "        Frame frame;\n"
+        "        for (auto& msg : pool) {\n"
+        "            auto frameLen = frame.length(msg);\n"
+        "            auto origSize = m_frames.size();\n"
+        "            m_frames.resize(origSize + frameLen);\n"
+        "            std::uint8_t* frameIter = m_frames.data() + origSize;\n"
+        "            auto es = frame.write(msg, frameIter, frameLen);\n"
+        "            if (es != comms::ErrorStatus::Success) {\n"
+        "                std::cerr << \"ERROR: Failed to write frame of \" << msg.doName() << std::endl;\n"
+        "                std::exit(-1);\n"
+        "            }\n"
+        "        }\n\n"
+        "        m_framesCount += pool.size();\n\n"
+        "        auto constructNs = \n"
+        "            measureNsPerOp(\n"
+        "                m_iterations,\n"
+        "                [](std::size_t)\n"
+        "                {\n"
+        "                    TMsg msg;\n"
+        "                    doNotOptimize(msg);\n"
+        "                });\n\n"
+        "        // Make sure the measured operations succeed\n"
+        "        std::vector<std::uint8_t> outBuf(buffers.front().size());\n"
+        "        TMsg readMsg;\n"
+        "        for (std::size_t idx = 0U; idx < PoolSize; ++idx) {\n"
+        "            Message& writeMsg = pool[idx];\n"
+        "            std::uint8_t* writeIter = outBuf.data();\n"
+        "            auto writeEs = writeMsg.write(writeIter, outBuf.size());\n"
+        "            Message& msg = readMsg;\n"
+        "            const std::uint8_t* readIter = buffers[idx].data();\n"
+        "            auto readEs = msg.read(readIter, lengths[idx]);\n"
+        "            auto consumed = static_cast<std::size_t>(readIter - buffers[idx].data());\n"
+        "            if ((writeEs != comms::ErrorStatus::Success) ||\n"
+        "                (readEs != comms::ErrorStatus::Success) ||\n"
+        "                (consumed != lengths[idx])) {\n"
+        "                std::cerr << \"ERROR: Failed to write / read \" << writeMsg.doName() << std::endl;\n"
+        "                std::exit(-1);\n"
+        "            }\n"
+        "        }\n\n"
+        "        auto writeNs = \n"
+        "            measureNsPerOp(\n"
+        "                m_iterations,\n"
+        "                [&pool, &outBuf](std::size_t idx)\n"
+        "                {\n"
+        "                    Message& msg = pool[idx];\n"
+        "                    std::uint8_t* iter = outBuf.data();\n"
+        "                    auto es = msg.write(iter, outBuf.size());\n"
+        "                    doNotOptimize(es);\n"
+        "                    doNotOptimize(outBuf.front());\n"
+        "                });\n\n"
+        "        auto readNs = \n"
+        "            measureNsPerOp(\n"
+        "                m_iterations,\n"
+        "                [&readMsg, &buffers, &lengths](std::size_t idx)\n"
+        "                {\n"
+        "                    Message& msg = readMsg;\n"
+        "                    const std::uint8_t* iter = buffers[idx].data();\n"
+        "                    auto es = msg.read(iter, lengths[idx]);\n"
+        "                    doNotOptimize(es);\n"
+        "                    doNotOptimize(readMsg);\n"
+        "                });\n\n"
+        "        auto validNs = \n"
+        "            measureNsPerOp(\n"
+        "                m_iterations,\n"
+        "                [&pool](std::size_t idx)\n"
+        "                {\n"
+        "                    Message& msg = pool[idx];\n"
+        "                    auto result = msg.valid();\n"
+        "                    doNotOptimize(result);\n"
+        "                });\n\n"
+        "        auto refreshNs = \n"
+        "            measureNsPerOp(\n"
+        "                m_iterations,\n"
+        "                [&pool](std::size_t idx)\n"
+        "                {\n"
+        "                    Message& msg = pool[idx];\n"
+        "                    auto result = msg.refresh();\n"
+        "                    doNotOptimize(result);\n"
+        "                });\n\n"
+        "        Handler handler;\n"
+        "        auto dispatchNs = \n"
+        "            measureNsPerOp(\n"
+        "                m_iterations,\n"
+        "                [&pool, &handler](std::size_t idx)\n"
+        "                {\n"
+        "                    Message& msg = pool[idx];\n"
+        "                    msg.dispatch(handler);\n"
+        "                    doNotOptimize(handler);\n"
+        "                });\n\n"
+        "        if (handler.count() != m_iterations) {\n"
+        "            std::cerr << \"ERROR: Unexpected number of dispatched \" << pool.front().doName() << std::endl;\n"
+        "            std::exit(-1);\n"
+        "        }\n\n"
+        "        if (0U < m_count) {\n"
+        "            std::cout << \",\";\n"
+        "        }\n\n"
+        "        std::cout << \"\\n    {\"\n"
+        "            \"\\\"name\\\":\\\"\" << pool.front().doName() << \"\\\",\"\n"
+        "            \"\\\"id\\\":\" << static_cast<std::intmax_t>(pool.front().doGetId()) << \",\"\n"
+        "            \"\\\"bytes_per_op\\\":\" << static_cast<double>(totalLen) / static_cast<double>(PoolSize) << \",\"\n"
+        "            \"\\\"construct_ns\\\":\" << constructNs << \",\"\n"
+        "            \"\\\"write_ns\\\":\" << writeNs << \",\"\n"
+        "            \"\\\"read_ns\\\":\" << readNs << \",\"\n"
+        "            \"\\\"valid_ns\\\":\" << validNs << \",\"\n"
+        "            \"\\\"refresh_ns\\\":\" << refreshNs << \",\"\n"
+        "            \"\\\"dispatch_ns\\\":\" << dispatchNs << \"}\";\n"
+        "        ++m_count;\n"
+        "    }\n\n"
+        "    const std::vector<std::uint8_t>& frames() const\n"
+        "    {\n"
+        "        return m_frames;\n"
+        "    }\n\n"
+        "    std::size_t framesCount() const\n"
+        "    {\n"
+        "        return m_framesCount;\n"
+        "    }\n\n"
+        "private:\n"
+        "    std::size_t m_iterations = 0U;\n"
+        "    Rnd& m_rnd;\n"
+        "    std::size_t m_count = 0U;\n"
+        "    std::vector<std::uint8_t> m_frames;\n"
+        "    std::size_t m_framesCount = 0U;\n"
+        "};\n\n"
+        "// Processes all the frames of the buffer and reports the processing rate\n"
+        "// in messages per second\n"
+        "template <typename TFunc>\n"
+        "double measureMsgsPerSec(const char* mode, const std::vector<std::uint8_t>& frames, std::size_t framesCount, std::size_t rounds, TFunc&& func)\n"
+        "{\n"
+        "    Handler checkHandler;\n"
+        "    auto consumed = func(frames, checkHandler);\n"
+        "    if ((consumed != frames.size()) || (checkHandler.count() != framesCount)) {\n"
+        "        std::cerr << \"ERROR: Unexpected frames processing in \" << mode << \" mode\" << std::endl;\n"
+        "        std::exit(-1);\n"
+        "    }\n\n"
+        "    Handler handler;\n"
+        "    auto start = Clock::now();\n"
+        "    for (std::size_t idx = 0U; idx < rounds; ++idx) {\n"
+        "        consumed = func(frames, handler);\n"
+        "        doNotOptimize(consumed);\n"
+        "    }\n"
+        "    auto diff = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start);\n"
+        "    doNotOptimize(handler);\n"
+        "    auto diffNs = std::max(static_cast<double>(diff.count()), 1.0);\n"
+        "    return static_cast<double>(handler.count()) * 1e9 / diffNs;\n"
+        "}\n\n"
+        "} // namespace\n\n"
+        "int main(int argc, const char* argv[])\n"
+        "{\n"
+        "    std::size_t iterations = 100000U;\n"
+        "    if (1 < argc) {\n"
+        "        iterations = static_cast<std::size_t>(std::strtoull(argv[1], nullptr, 10));\n"
+        "    }\n\n"
+        "    if (iterations == 0U) {\n"
+        "        std::cerr << \"Invalid number of iterations\" << std::endl;\n"
+        "        return -1;\n"
+        "    }\n\n"
+        "    Rnd::result_type seed = 0U;\n"
+        "    if (2 < argc) {\n"
+        "        seed = static_cast<Rnd::result_type>(std::strtoull(argv[2], nullptr, 10));\n"
+        "    }\n\n"
+        "    Rnd rnd(seed);\n"
+        "    std::cout << \"{\\n  \\\"options\\\":\\\"\" QUOTES(OPTIONS) \"\\\",\\n\"\n"
+        "        \"  \\\"iterations\\\":\" << iterations << \",\\n\"\n"
+        "        \"  \\\"seed\\\":\" << seed << \",\\n\"\n"
+        "        \"  \\\"messages\\\":[\";\n\n"
+        "    MessageBench bench(iterations, rnd);\n"
+        "    comms::util::tupleForEachType<InputMessages>(bench);\n"
+        "    std::cout << \"\\n  ]\";\n\n"
+        "    auto& frames = bench.frames();\n"
+        "    auto framesCount = bench.framesCount();\n"
+        "    if (0U < framesCount) {\n"
+        "        auto rounds = std::max(iterations / framesCount, static_cast<std::size_t>(1U));\n"
+        "        auto singleRate = \n"
+        "            measureMsgsPerSec(\n"
+        "                \"single\", frames, framesCount, rounds,\n"
+        "                [](const std::vector<std::uint8_t>& buf, Handler& handler)\n"
+        "                {\n"
+        "                    Frame frame;\n"
+        "                    return comms::processAllWithDispatch(buf.data(), buf.size(), frame, handler);\n"
+        "                });\n\n"
+        "        std::unique_ptr<BatchProcessor> processor(new BatchProcessor);\n"
+        "        auto batchRate = \n"
+        "            measureMsgsPerSec(\n"
+        "                \"batch\", frames, framesCount, rounds,\n"
+        "                [&processor](const std::vector<std::uint8_t>& buf, Handler& handler)\n"
+        "                {\n"
+        "                    Frame frame;\n"
+        "                    return processor->process(buf.data(), buf.size(), frame, handler);\n"
+        "                });\n\n"
+        "        std::cout << \",\\n  \\\"frames\\\":{\"\n"
+        "            \"\\\"count\\\":\" << framesCount << \",\"\n"
+        "            \"\\\"bytes\\\":\" << frames.size() << \",\"\n"
+        "            \"\\\"batch_size\\\":\" << BatchSize << \",\"\n"
+        "            \"\\\"single_msgs_per_sec\\\":\" << singleRate << \",\"\n"
+        "            \"\\\"batch_msgs_per_sec\\\":\" << batchRate << \"}\";\n"
+        "    }\n\n"
+        "    std::cout << \"\\n}\" << std::endl;\n"
+        "    return 0;\n"
+        "}\n";
+
+    auto str = commsdsl::gen::util::processTemplate(Template, repl, true);
+    stream << str;
+
+    stream.flush();
+    if (!stream.good()) {
+        m_generator.logger().error("Failed to write \"" + filePath + "\".");
+        return false;
+    }
+
+    return true;
+}
+
+} // namespace commsdsl2test
@@ -0,0 +1,456 @@
+//
+// Copyright 2019 - 2023 (C). Alex Robenko. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "Replay.h"
+
+#include <fstream>
+
+#include "TestGenerator.h"
+
+#include "commsdsl/gen/util.h"
+
+namespace commsdsl2test
+{
+
+namespace
+{
+
+using ReplacementMap = commsdsl::gen::util::ReplacementMap;
+
+} // namespace
+
+
+bool Replay::write(TestGenerator& generator)
+{
+    Replay obj(generator);
+    return obj.writeReplay();
+}
+
+bool Replay::writeReplay() const
+{
+    auto replayName =
+        m_generator.currentSchema().mainNamespace() + '_' + "replay.cpp";
+
+    auto filePath = commsdsl::gen::util::pathAddElem(m_generator.getOutputDir(), replayName);
+
+    m_generator.logger().info("Generating " + filePath);
+    std::ofstream stream(filePath);
+    if (!stream) {
+        m_generator.logger().error("Failed to open \"" + filePath + "\" for writing.");
+        return false;
+    }
+
+    ReplacementMap repl = {
+        std::make_pair("GEN_COMMENT", m_generator.fileGeneratedComment()),
+    };
+
+    static const std::string Template =
+        "#^#GEN_COMMENT#$#\n"
+        "// Replays a recorded capture through the protocol frame and reports the\n"
+        "// throughput, the per message ID statistics, the error statuses histogram\n"
+        "// and the per frame processing latency percentiles.\n"
+        "// Usage: <app> [-l] <capture_file> [repeat]\n"
+        "//     -l - The capture is a sequence of records, each prefixed with\n"
+        "//          4 bytes big endian length, rather than a raw stream.\n\n"
+        "#include <iostream>\n"
+        "#include <fstream>\n"
+        "#include <cstdint>\n"
+        "#include <cstdlib>\n"
+        "#include <cstring>\n"
+        "#include <cassert>\n"
+        "#include <chrono>\n"
+        "#include <vector>\n"
+        "#include <map>\n"
+        "#include <string>\n"
+        "#include <algorithm>\n\n"
+        "#if defined(__unix__) || defined(__APPLE__)\n"
+        "#include <fcntl.h>\n"
+        "#include <sys/mman.h>\n"
+        "#include <sys/stat.h>\n"
+        "#include <unistd.h>\n"
+        "#define REPLAY_USE_MMAP\n"
+        "#endif\n\n"
+        "#include \"comms/fields.h\"\n"
+        "#include \"comms/ErrorStatus.h\"\n\n"
+        "#define QUOTES_(x_) #x_\n"
+        "#define QUOTES(x_) QUOTES_(x_)\n\n"
+        "#ifndef INTERFACE_HEADER\n"
+        "#error \"Interface header needs to be defined\"\n"
+        "#endif\n\n"
+        "#ifndef INTERFACE\n"
+        "#error \"Interface type needs to be defined\"\n"
+        "#endif\n\n"
+        "#ifndef FRAME_HEADER\n"
+        "#error \"Frame header needs to be defined\"\n"
+        "#endif\n\n"
+        "#ifndef FRAME\n"
+        "#error \"Frame type needs to be defined\"\n"
+        "#endif\n\n"
+        "#ifndef OPTIONS_HEADER\n"
+        "#error \"Options header needs to be defined\"\n"
+        "#endif\n\n"
+        "#ifndef OPTIONS\n"
+        "#error \"Options type needs to be defined\"\n"
+        "#endif\n\n"
+        "#ifndef INPUT_MESSAGES_HEADER\n"
+        "#error \"Input messages header needs to be defined\"\n"
+        "#endif\n\n"
+        "#ifndef INPUT_MESSAGES\n"
+        "#error \"Input messages type needs to be defined\"\n"
+        "#endif\n\n"
+        "#include QUOTES(INTERFACE_HEADER)\n"
+        "#include QUOTES(FRAME_HEADER)\n"
+        "#include QUOTES(OPTIONS_HEADER)\n"
+        "#include QUOTES(INPUT_MESSAGES_HEADER)\n\n"
+        "namespace\n"
+        "{\n\n"
+        "class Handler;\n"
+        "using Message = \n"
+        "    INTERFACE<\n"
+        "        comms::option::app::ReadIterator<const std::uint8_t*>,\n"
+        "        comms::option::app::Handler<Handler>\n"
+        "    >;\n\n"
+        "using AppOptions = OPTIONS;\n"
+        "using InputMessages = INPUT_MESSAGES<Message, AppOptions>;\n"
+        "using Frame = FRAME<Message, InputMessages, AppOptions>;\n"
+        "using Clock = std::chrono::steady_clock;\n\n"
+        "class Handler\n"
+        "{\n"
+        "public:\n"
+        "    template <typename TMsg>\n"
+        "    void handle(TMsg& msg)\n"
+        "    {\n"
+        "        m_lastId = static_cast<std::intmax_t>(msg.doGetId());\n"
+        "        m_lastName = msg.doName();\n"
+        "    }\n\n"
+        "    // Handle unexpected messages\n"
+        "    void handle(Message&)\n"
+        "    {\n"
+        "        static constexpr bool Should_not_happen = false;\n"
+        "        static_cast<void>(Should_not_happen);\n"
+        "        assert(!Should_not_happen);\n"
+        "    }\n\n"
+        "    std::intmax_t lastId() const\n"
+        "    {\n"
+        "        return m_lastId;\n"
+        "    }\n\n"
+        "    const char* lastName() const\n"
+        "    {\n"
+        "        return m_lastName;\n"
+        "    }\n\n"
+        "private:\n"
+        "    std::intmax_t m_lastId = 0;\n"
+        "    const char* m_lastName = \"\";\n"
+        "};\n\n"
+        "class InputFile\n"
+        "{\n"
+        "public:\n"
+        "    InputFile() = default;\n"
+        "    InputFile(const InputFile&) = delete;\n"
+        "    InputFile& operator=(const InputFile&) = delete;\n\n"
+        "    ~InputFile()\n"
+        "    {\n"
+        "#ifdef REPLAY_USE_MMAP\n"
+        "        if (m_map != nullptr) {\n"
+        "            ::munmap(m_map, m_size);\n"
+        "        }\n"
+        "#endif\n"
+        "    }\n\n"
+        "    bool open(const char* path)\n"
+        "    {\n"
+        "#ifdef REPLAY_USE_MMAP\n"
+        "        int fd = ::open(path, O_RDONLY);\n"
+        "        if (fd < 0) {\n"
+        "            return false;\n"
+        "        }\n\n"
+        "        struct stat info;\n"
+        "        if (::fstat(fd, &info) != 0) {\n"
+        "            ::close(fd);\n"
+        "            return false;\n"
+        "        }\n\n"
+        "        m_size = static_cast<std::size_t>(info.st_size);\n"
+        "        if (m_size == 0U) {\n"
+        "            ::close(fd);\n"
+        "            return true;\n"
+        "        }\n\n"
+        "        auto* map = ::mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);\n"
+        "        ::close(fd);\n"
+        "        if (map == MAP_FAILED) {\n"
+        "            m_size = 0U;\n"
+        "            return false;\n"
+        "        }\n\n"
+        "        ::madvise(map, m_size, MADV_SEQUENTIAL);\n"
+        "        m_map = map;\n"
+        "        m_data = static_cast<const std::uint8_t*>(map);\n"
+        "        return true;\n"
+        "#else\n"
+        "        std::ifstream stream(path, std::ios_base::binary);\n"
+        "        if (!stream) {\n"
+        "            return false;\n"
+        "        }\n\n"
+        "        m_buf.assign(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>());\n"
+        "        m_data = reinterpret_cast<const std::uint8_t*>(m_buf.data());\n"
+        "        m_size = m_buf.size();\n"
+        "        return true;\n"
+        "#endif\n"
+        "    }\n\n"
+        "    const std::uint8_t* data() const\n"
+        "    {\n"
+        "        return m_data;\n"
+        "    }\n\n"
+        "    std::size_t size() const\n"
+        "    {\n"
+        "        return m_size;\n"
+        "    }\n\n"
+        "private:\n"
+        "#ifdef REPLAY_USE_MMAP\n"
+        "    void* m_map = nullptr;\n"
+        "#else\n"
+        "    std::vector<char> m_buf;\n"
+        "#endif\n"
+        "    const std::uint8_t* m_data = nullptr;\n"
+        "    std::size_t m_size = 0U;\n"
+        "};\n\n"
+        "// Invokes the provided function for the whole raw stream or for every record\n"
+        "// of the length delimited recording, returns false on truncated record.\n"
+        "template <typename TFunc>\n"
+        "bool forEachChunk(const InputFile& file, bool lengthDelimited, TFunc&& func)\n"
+        "{\n"
+        "    if (!lengthDelimited) {\n"
+        "        func(file.data(), file.size());\n"
+        "        return true;\n"
+        "    }\n\n"
+        "    static const std::size_t LenSize = 4U;\n"
+        "    std::size_t pos = 0U;\n"
+        "    while (pos < file.size()) {\n"
+        "        if ((file.size() - pos) < LenSize) {\n"
+        "            return false;\n"
+        "        }\n\n"
+        "        auto* lenPtr = file.data() + pos;\n"
+        "        std::size_t len = 0U;\n"
+        "        for (auto idx = 0U; idx < LenSize; ++idx) {\n"
+        "            len = (len << 8U) | lenPtr[idx];\n"
+        "        }\n\n"
+        "        pos += LenSize;\n"
+        "        if ((file.size() - pos) < len) {\n"
+        "            return false;\n"
+        "        }\n\n"
+        "        func(file.data() + pos, len);\n"
+        "        pos += len;\n"
+        "    }\n"
+        "    return true;\n"
+        "}\n\n"
+        "std::size_t processAll(const std::uint8_t* buf, std::size_t len, Frame& frame, Handler& handler)\n"
+        "{\n"
+        "    std::size_t consumed = 0U;\n"
+        "    std::size_t count = 0U;\n"
+        "    while (consumed < len) {\n"
+        "        Frame::MsgPtr msg;\n"
+        "        auto* iter = buf + consumed;\n"
+        "        auto es = frame.read(msg, iter, len - consumed);\n"
+        "        if (es == comms::ErrorStatus::NotEnoughData) {\n"
+        "            break;\n"
+        "        }\n\n"
+        "        if (es == comms::ErrorStatus::ProtocolError) {\n"
+        "            consumed += Frame::resyncOffset(buf + consumed, len - consumed);\n"
+        "            continue;\n"
+        "        }\n\n"
+        "        consumed = static_cast<std::size_t>(iter - buf);\n"
+        "        if (es == comms::ErrorStatus::Success) {\n"
+        "            msg->dispatch(handler);\n"
+        "            ++count;\n"
+        "        }\n"
+        "    }\n"
+        "    return count;\n"
+        "}\n\n"
+        "struct MsgStats\n"
+        "{\n"
+        "    const char* m_name = \"\";\n"
+        "    std::size_t m_count = 0U;\n"
+        "    std::size_t m_bytes = 0U;\n"
+        "    std::uint64_t m_ns = 0U;\n"
+        "};\n\n"
+        "struct Stats\n"
+        "{\n"
+        "    std::map<std::intmax_t, MsgStats> m_msgs;\n"
+        "    std::map<comms::ErrorStatus, std::size_t> m_errors;\n"
+        "    std::vector<std::uint64_t> m_latencies;\n"
+        "};\n\n"
+        "// Same as processAll(), but also times every frame and collects the statistics\n"
+        "void analyze(const std::uint8_t* buf, std::size_t len, Frame& frame, Handler& handler, Stats& stats)\n"
+        "{\n"
+        "    std::size_t consumed = 0U;\n"
+        "    while (consumed < len) {\n"
+        "        Frame::MsgPtr msg;\n"
+        "        auto* iter = buf + consumed;\n"
+        "        auto start = Clock::now();\n"
+        "        auto es = frame.read(msg, iter, len - consumed);\n"
+        "        if (es == comms::ErrorStatus::Success) {\n"
+        "            msg->dispatch(handler);\n"
+        "        }\n"
+        "        auto diff = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start);\n\n"
+        "        ++stats.m_errors[es];\n"
+        "        if (es == comms::ErrorStatus::NotEnoughData) {\n"
+        "            break;\n"
+        "        }\n\n"
+        "        if (es == comms::ErrorStatus::ProtocolError) {\n"
+        "            consumed += Frame::resyncOffset(buf + consumed, len - consumed);\n"
+        "            continue;\n"
+        "        }\n\n"
+        "        auto frameLen = static_cast<std::size_t>(iter - (buf + consumed));\n"
+        "        consumed += frameLen;\n"
+        "        if (es != comms::ErrorStatus::Success) {\n"
+        "            continue;\n"
+        "        }\n\n"
+        "        auto ns = static_cast<std::uint64_t>(diff.count());\n"
+        "        auto& msgStats = stats.m_msgs[handler.lastId()];\n"
+        "        msgStats.m_name = handler.lastName();\n"
+        "        ++msgStats.m_count;\n"
+        "        msgStats.m_bytes += frameLen;\n"
+        "        msgStats.m_ns += ns;\n"
+        "        stats.m_latencies.push_back(ns);\n"
+        "    }\n"
+        "}\n\n"
+        "const char* errorStatusName(comms::ErrorStatus es)\n"
+        "{\n"
+        "    switch (es) {\n"
+        "        case comms::ErrorStatus::Success: return \"Success\";\n"
+        "        case comms::ErrorStatus::NotEnoughData: return \"NotEnoughData\";\n"
+        "        case comms::ErrorStatus::ProtocolError: return \"ProtocolError\";\n"
+        "        case comms::ErrorStatus::BufferOverflow: return \"BufferOverflow\";\n"
+        "        case comms::ErrorStatus::InvalidMsgId: return \"InvalidMsgId\";\n"
+        "        case comms::ErrorStatus::InvalidMsgData: return \"InvalidMsgData\";\n"
+        "        case comms::ErrorStatus::MsgAllocFailure: return \"MsgAllocFailure\";\n"
+        "        case comms::ErrorStatus::NotSupported: return \"NotSupported\";\n"
+        "        default: break;\n"
+        "    }\n"
+        "    return \"Other\";\n"
+        "}\n\n"
+        "std::uint64_t percentile(const std::vector<std::uint64_t>& sorted, double value)\n"
+        "{\n"
+        "    assert(!sorted.empty());\n"
+        "    auto idx = static_cast<std::size_t>(value * static_cast<double>(sorted.size() - 1U) / 100.0);\n"
+        "    return sorted[idx];\n"
+        "}\n\n"
+        "double mbPerSec(std::size_t bytes, double sec)\n"
+        "{\n"
+        "    return static_cast<double>(bytes) / (1024.0 * 1024.0) / sec;\n"
+        "}\n\n"
+        "} // namespace\n\n"
+        "int main(int argc, const char* argv[])\n"
+        "{\n"
+        "    bool lengthDelimited = false;\n"
+        "    int argIdx = 1;\n"
+        "    if ((argIdx < argc) && (std::strcmp(argv[argIdx], \"-l\") == 0)) {\n"
+        "        lengthDelimited = true;\n"
+        "        ++argIdx;\n"
+        "    }\n\n"
+        "    if (argc <= argIdx) {\n"
+        "        std::cerr << \"Usage: \" << argv[0] << \" [-l] <capture_file> [repeat]\" << std::endl;\n"
+        "        return -1;\n"
+        "    }\n\n"
+        "    const char* path = argv[argIdx];\n"
+        "    ++argIdx;\n\n"
+        "    unsigned long repeat = 1U;\n"
+        "    if (argIdx < argc) {\n"
+        "        repeat = std::strtoul(argv[argIdx], nullptr, 10);\n"
+        "    }\n\n"
+        "    if (repeat == 0U) {\n"
+        "        std::cerr << \"Invalid repeat value\" << std::endl;\n"
+        "        return -1;\n"
+        "    }\n\n"
+        "    InputFile file;\n"
+        "    if (!file.open(path)) {\n"
+        "        std::cerr << \"Failed to open \" << path << std::endl;\n"
+        "        return -1;\n"
+        "    }\n\n"
+        "    Frame frame;\n"
+        "    Handler handler;\n\n"
+        "    // Throughput pass, no per frame instrumentation\n"
+        "    std::size_t totalFrames = 0U;\n"
+        "    bool complete = true;\n"
+        "    auto start = Clock::now();\n"
+        "    for (auto iter = 0UL; iter < repeat; ++iter) {\n"
+        "        complete = \n"
+        "            forEachChunk(\n"
+        "                file, lengthDelimited,\n"
+        "                [&frame, &handler, &totalFrames](const std::uint8_t* buf, std::size_t len)\n"
+        "                {\n"
+        "                    totalFrames += processAll(buf, len, frame, handler);\n"
+        "                });\n"
+        "    }\n"
+        "    auto totalDiff = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start);\n\n"
+        "    if (!complete) {\n"
+        "        std::cerr << \"WARNING: The last record is truncated\" << std::endl;\n"
+        "    }\n\n"
+        "    // Analysis pass\n"
+        "    Stats stats;\n"
+        "    forEachChunk(\n"
+        "        file, lengthDelimited,\n"
+        "        [&frame, &handler, &stats](const std::uint8_t* buf, std::size_t len)\n"
+        "        {\n"
+        "            analyze(buf, len, frame, handler, stats);\n"
+        "        });\n\n"
+        "    auto totalSec = std::max(static_cast<double>(totalDiff.count()) / 1e9, 1e-9);\n"
+        "    auto totalBytes = file.size() * repeat;\n"
+        "    std::cout << \"Protocol: \" << QUOTES(FRAME) << \" (\" << QUOTES(OPTIONS) << \")\\n\";\n"
+        "    std::cout << \"Input: \" << path << \" (\" << file.size() << \" bytes, \" <<\n"
+        "        (lengthDelimited ? \"length delimited\" : \"raw\") << \"), repeated \" << repeat << \" time(s)\\n\\n\";\n\n"
+        "    std::cout << \"Throughput:\\n\" <<\n"
+        "        \"    Frames: \" << totalFrames << \" in \" << totalSec * 1000.0 << \" ms\\n\" <<\n"
+        "        \"    Frames/s: \" << static_cast<double>(totalFrames) / totalSec << '\\n' <<\n"
+        "        \"    MB/s: \" << mbPerSec(totalBytes, totalSec) << \"\\n\\n\";\n\n"
+        "    std::cout << \"Error statuses:\\n\";\n"
+        "    for (auto& e : stats.m_errors) {\n"
+        "        std::cout << \"    \" << errorStatusName(e.first) << \" (\" << static_cast<int>(e.first) << \"): \" << e.second << '\\n';\n"
+        "    }\n"
+        "    std::cout << '\\n';\n\n"
+        "    std::cout << \"Messages:\\n\";\n"
+        "    for (auto& m : stats.m_msgs) {\n"
+        "        auto& msgStats = m.second;\n"
+        "        auto sec = std::max(static_cast<double>(msgStats.m_ns) / 1e9, 1e-9);\n"
+        "        std::cout << \"    \" << msgStats.m_name << \" (\" << m.first << \"): \" <<\n"
+        "            msgStats.m_count << \" frames, \" << msgStats.m_bytes << \" bytes, \" <<\n"
+        "            static_cast<double>(msgStats.m_ns) / static_cast<double>(msgStats.m_count) << \" ns/frame, \" <<\n"
+        "            mbPerSec(msgStats.m_bytes, sec) << \" MB/s\\n\";\n"
+        "    }\n"
+        "    std::cout << '\\n';\n\n"
+        "    if (stats.m_latencies.empty()) {\n"
+        "        return 0;\n"
+        "    }\n\n"
+        "    auto& latencies = stats.m_latencies;\n"
+        "    std::sort(latencies.begin(), latencies.end());\n"
+        "    std::cout << \"Frame latency (ns):\\n\" <<\n"
+        "        \"    p50: \" << percentile(latencies, 50.0) << '\\n' <<\n"
+        "        \"    p90: \" << percentile(latencies, 90.0) << '\\n' <<\n"
+        "        \"    p99: \" << percentile(latencies, 99.0) << '\\n' <<\n"
+        "        \"    p99.9: \" << percentile(latencies, 99.9) << '\\n' <<\n"
+        "        \"    max: \" << latencies.back() << std::endl;\n"
+        "    return 0;\n"
+        "}\n";
+
+    auto str = commsdsl::gen::util::processTemplate(Template, repl, true);
+    stream << str;
+
+    stream.flush();
+    if (!stream.good()) {
+        m_generator.logger().error("Failed to write \"" + filePath + "\".");
+        return false;
+    }
+
+    return true;
+}
+
+} // namespace commsdsl2test
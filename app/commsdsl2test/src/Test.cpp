@@ -99,9 +99,18 @@ bool Test::writeInputTest() const
         "#include <cstdlib>\n"
         "#include <array>\n"
         "#include <vector>\n"
-        "#include <iomanip>\n\n"
+        "#include <iomanip>\n"
+        "#include <cstdint>\n"
+        "#include <cstddef>\n"
+        "#include <cerrno>\n\n"
+        "#ifdef _WIN32\n"
+        "#include <fcntl.h>\n"
+        "#include <io.h>\n"
+        "#else\n"
+        "#include <unistd.h>\n"
+        "#endif\n\n"
         "#include \"comms/fields.h\"\n"
-        "#include \"comms/process.h\"\n\n"
+        "#include \"comms/ErrorStatus.h\"\n\n"
         "#define QUOTES_(x_) #x_\n"
         "#define QUOTES(x_) QUOTES_(x_)\n\n"
         "#ifndef INTERFACE_HEADER\n"
@@ -371,8 +380,10 @@ bool Test::writeInputTest() const
         "        // Check write is correct\n"
         "        std::size_t len = m_frame.length(msg);\n"
         "        assert(0U < len);\n"
-        "        std::unique_ptr<char []> outBuf(new char[len]);\n"
-        "        auto writeIter = &(outBuf[0]);\n"
+        "        if (m_outBuf.size() < len) {\n"
+        "            m_outBuf.resize(len);\n"
+        "        }\n\n"
+        "        auto writeIter = m_outBuf.data();\n"
         "        auto es = m_frame.write(msg, writeIter, len);\n"
         "        if (es != comms::ErrorStatus::Success) {\n"
         "            std::cerr << \"ERROR: Failed to write\" << std::endl;\n"
@@ -381,7 +392,7 @@ bool Test::writeInputTest() const
         "            assert(!Should_not_happen);\n"
         "            exit(-1);\n"
         "        }\n\n"
-        "        if (writeIter != (&outBuf[0] + len)) {\n"
+        "        if (writeIter != (m_outBuf.data() + len)) {\n"
         "            std::cerr << \"ERROR: Unexpected pos of write iterator\" << std::endl;\n"
         "            static constexpr bool Should_not_happen = false;\n"
         "            static_cast<void>(Should_not_happen);\n"
@@ -399,40 +410,116 @@ bool Test::writeInputTest() const
         "    }\n\n"
         "private:\n"
         "    Frame& m_frame;\n"
+        "    std::vector<char> m_outBuf; // Reused by all the write checks\n"
         "};\n\n"
-        "} // namespace\n\n"
-        "int main(int argc, const char* argv[])\n"
+        "std::size_t processInput(const char* buf, std::size_t len, Frame& frame, Handler& handler)\n"
+        "{\n"
+        "    std::size_t consumed = 0U;\n"
+        "    while (consumed < len) {\n"
+        "        Frame::MsgPtr msg;\n"
+        "        auto* iter = buf + consumed;\n"
+        "        auto es = frame.read(msg, iter, len - consumed);\n"
+        "        if (es == comms::ErrorStatus::NotEnoughData) {\n"
+        "            break;\n"
+        "        }\n\n"
+        "        if (es == comms::ErrorStatus::ProtocolError) {\n"
+        "            // Jump to the next possible frame start instead of retrying every byte\n"
+        "            consumed += Frame::resyncOffset(buf + consumed, len - consumed);\n"
+        "            continue;\n"
+        "        }\n\n"
+        "        consumed = static_cast<std::size_t>(iter - buf);\n"
+        "        if (es == comms::ErrorStatus::Success) {\n"
+        "            msg->dispatch(handler);\n"
+        "        }\n"
+        "    }\n"
+        "    return consumed;\n"
+        "}\n\n"
+        "// Reads the raw stdin file descriptor, no stdio buffered state is carried over\n"
+        "// between the inputs of the fuzzer persistent mode.\n"
+        "// Returns number of read bytes, 0 on end of input, negative value on error.\n"
+        "long readStdin(char* buf, std::size_t size)\n"
+        "{\n"
+        "    while (true) {\n"
+        "#ifdef _WIN32\n"
+        "        auto result = static_cast<long>(_read(0, buf, static_cast<unsigned>(size)));\n"
+        "#else\n"
+        "        auto result = static_cast<long>(read(0, buf, size));\n"
+        "#endif\n"
+        "        if ((result < 0) && (errno == EINTR)) {\n"
+        "            continue;\n"
+        "        }\n\n"
+        "        return result;\n"
+        "    }\n"
+        "}\n\n"
+        "int processStdin(Frame& frame, Handler& handler, std::vector<char>& input)\n"
         "{\n"
-        "    static_cast<void>(argc);\n"
-        "    static_cast<void>(argv);\n\n"
-        "    auto* openResult = std::freopen(nullptr, \"rb\", stdin);\n"
-        "    static_cast<void>(openResult);\n\n"
-        "    if(std::ferror(stdin)) {\n"
-        "        std::cerr << \"Failed to open stdin\" << std::endl;\n"
-        "        return -1;\n"
-        "    }\n\n"
         "    std::array<char, 1024> buf;\n"
-        "    std::vector<char> input;\n"
-        "    Frame frame;\n"
-        "    Handler handler(frame);\n\n"
+        "    std::size_t begin = 0U;\n"
+        "    input.clear();\n\n"
         "    while (true) {\n"
-        "        std::size_t len = std::fread(buf.data(), sizeof(buf[0]), buf.size(), stdin);\n\n"
-        "        if(std::ferror(stdin)) {\n"
-        "            if (std::feof(stdin)) {\n"
-        "                return 0;\n"
-        "            }\n\n"
+        "        auto readResult = readStdin(buf.data(), buf.size());\n"
+        "        if (readResult < 0) {\n"
         "            std::cerr << \"Some error\" << std::endl;\n"
         "            return -1;\n"
         "        }\n\n"
-        "        if (len == 0U) {\n"
+        "        if (readResult == 0) {\n"
         "            return 0;\n"
         "        }\n\n"
+        "        auto len = static_cast<std::size_t>(readResult);\n"
         "        input.insert(input.end(), buf.data(), buf.data() + len); // append to vector\n"
-        "        auto consumed = comms::processAllWithDispatch(&input[0], input.size(), frame, handler);\n"
-        "        input.erase(input.begin(), input.begin() + consumed);\n"
+        "        begin += processInput(input.data() + begin, input.size() - begin, frame, handler);\n"
+        "        if (begin == input.size()) {\n"
+        "            input.clear();\n"
+        "            begin = 0U;\n"
+        "            continue;\n"
+        "        }\n\n"
+        "        // Compact only when the consumed prefix is bigger than the remaining data,\n"
+        "        // keeps the total amount of copying linear to the input size.\n"
+        "        if ((input.size() - begin) < begin) {\n"
+        "            input.erase(input.begin(), input.begin() + static_cast<std::ptrdiff_t>(begin));\n"
+        "            begin = 0U;\n"
+        "        }\n"
+        "    }\n"
+        "}\n\n"
+        "} // namespace\n\n"
+        "// Entry point for libFuzzer (and compatible) fuzzing engines\n"
+        "extern \"C\" int LLVMFuzzerTestOneInput(const std::uint8_t* data, std::size_t size)\n"
+        "{\n"
+        "    static Frame frame;\n"
+        "    static Handler handler(frame);\n"
+        "    processInput(reinterpret_cast<const char*>(data), size, frame, handler);\n"
+        "    return 0;\n"
+        "}\n\n"
+        "#ifndef TEST_LIBFUZZER\n"
+        "int main(int argc, const char* argv[])\n"
+        "{\n"
+        "    static_cast<void>(argc);\n"
+        "    static_cast<void>(argv);\n\n"
+        "#ifdef _WIN32\n"
+        "    // Binary mode of the raw stdin\n"
+        "    _setmode(0, _O_BINARY);\n"
+        "#endif\n\n"
+        "    Frame frame;\n"
+        "    Handler handler(frame);\n"
+        "    std::vector<char> input;\n\n"
+        "#ifdef __AFL_HAVE_MANUAL_CONTROL\n"
+        "    // Deferred fork server, the initialization above is not repeated for every input\n"
+        "    __AFL_INIT();\n"
+        "#endif\n\n"
+        "#ifdef __AFL_LOOP\n"
+        "    // Persistent mode, process multiple inputs without forking\n"
+        "    while (__AFL_LOOP(10000)) {\n"
+        "        auto result = processStdin(frame, handler, input);\n"
+        "        if (result != 0) {\n"
+        "            return result;\n"
+        "        }\n"
         "    }\n"
         "    return 0;\n"
-        "}\n\n";
+        "#else\n"
+        "    return processStdin(frame, handler, input);\n"
+        "#endif\n"
+        "}\n"
+        "#endif // #ifndef TEST_LIBFUZZER\n\n";
 
     auto str = commsdsl::gen::util::processTemplate(Template, repl, true);
     stream << str;
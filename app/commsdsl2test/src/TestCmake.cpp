@@ -86,8 +86,13 @@ bool TestCmake::testWriteInternal() const
         "project (\"#^#PROJ_NAME#$#_test\")\n\n"
         "option (OPT_WARN_AS_ERR \"Treat warning as error\" ON)\n"
         "option (OPT_USE_CCACHE \"Use of ccache on UNIX system\" ON)\n"
+        "option (OPT_BUILD_BENCH \"Build messages throughput benchmark application\" OFF)\n"
+        "option (OPT_BUILD_REPLAY \"Build capture replay application\" OFF)\n"
+        "option (OPT_TEST_LIBFUZZER \"Build input test application for libFuzzer (requires Clang)\" OFF)\n"
         "# Other parameters:\n"
         "# OPT_TEST_RENAME - Rename the final test application.\n"
+        "# OPT_BENCH_RENAME - Rename the final benchmark application.\n"
+        "# OPT_REPLAY_RENAME - Rename the final replay application.\n"
         "# OPT_TEST_OPTIONS - Class name of the options for test applications,\n"
         "#       defaults to #^#OPTIONS_SCOPE#$#.\n"        
         "# OPT_TEST_INTERFACE - Class name of the interface for test applications,\n"
@@ -103,7 +108,7 @@ bool TestCmake::testWriteInternal() const
         "set(CMAKE_CXX_STANDARD 11 CACHE STRING \"The C++ standard to use\")\n\n"
         "include(GNUInstallDirs)\n"
         "######################################################################\n"
-        "function (define_test name)\n"
+        "function (define_test name rename)\n"
         "    set (src ${name}.cpp)\n"
         "    add_executable(${name} ${src})\n"
         "    target_link_libraries(${name} PRIVATE cc::#^#PROJ_NS#$# cc::comms)\n"
@@ -136,8 +141,8 @@ bool TestCmake::testWriteInternal() const
         "        target_compile_definitions(${name} PRIVATE ${extra_defs})\n"
         "    endif ()\n\n"
         "    set (rename_param)\n"
-        "    if (NOT \"${OPT_TEST_RENAME}\" STREQUAL \"\")\n"
-        "        set (rename_param RENAME ${OPT_TEST_RENAME})\n"
+        "    if (NOT \"${rename}\" STREQUAL \"\")\n"
+        "        set (rename_param RENAME ${rename})\n"
         "    endif()\n\n"
         "    install (\n"
         "        TARGETS ${name}\n"
@@ -175,7 +180,20 @@ bool TestCmake::testWriteInternal() const
         "string (REPLACE \"::\" \"/\" OPT_TEST_FRAME_HEADER \"${OPT_TEST_FRAME}.h\")\n"
         "string (REPLACE \"::\" \"/\" OPT_TEST_OPTIONS_HEADER \"${OPT_TEST_OPTIONS}.h\")\n"
         "string (REPLACE \"::\" \"/\" OPT_TEST_INPUT_MESSAGES_HEADER \"${OPT_TEST_INPUT_MESSAGES}.h\")\n\n"
-        "define_test(#^#PROJ_NS#$#_input_test)\n";
+        "define_test(#^#PROJ_NS#$#_input_test \"${OPT_TEST_RENAME}\")\n\n"
+        "if (OPT_TEST_LIBFUZZER)\n"
+        "    # libFuzzer provides its own main() and calls LLVMFuzzerTestOneInput()\n"
+        "    target_compile_definitions(#^#PROJ_NS#$#_input_test PRIVATE TEST_LIBFUZZER)\n"
+        "    target_compile_options(#^#PROJ_NS#$#_input_test PRIVATE -fsanitize=fuzzer)\n"
+        "    target_link_libraries(#^#PROJ_NS#$#_input_test PRIVATE -fsanitize=fuzzer)\n"
+        "endif ()\n\n"
+        "if (OPT_BUILD_BENCH)\n"
+        "    # Reported numbers are meaningful only for optimized (Release) builds\n"
+        "    define_test(#^#PROJ_NS#$#_bench \"${OPT_BENCH_RENAME}\")\n"
+        "endif ()\n\n"
+        "if (OPT_BUILD_REPLAY)\n"
+        "    define_test(#^#PROJ_NS#$#_replay \"${OPT_REPLAY_RENAME}\")\n"
+        "endif ()\n";
 
     auto str = commsdsl::gen::util::processTemplate(Template, repl, true);
     stream << str;
@@ -15,6 +15,8 @@
 
 #include "TestGenerator.h"
 
+#include "Bench.h"
+#include "Replay.h"
 #include "Test.h"
 #include "TestCmake.h"
 
@@ -47,6 +49,8 @@ bool TestGenerator::writeImpl()
     assert(&currentSchema() == &protocolSchema());
     return 
         Test::write(*this) &&
+        Bench::write(*this) &&
+        Replay::write(*this) &&
         TestCmake::write(*this) &&
         testWriteExtraFilesInternal();
 }
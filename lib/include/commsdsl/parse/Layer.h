@@ -127,6 +127,8 @@ public:
         Crc_16,
         Crc_32,
         Xor,
+        Crc_32C,
+        Crc_64,
         NumOfValues
     };
 
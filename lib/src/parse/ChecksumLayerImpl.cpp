@@ -126,6 +126,10 @@ bool ChecksumLayerImpl::updateAlg()
         std::make_pair("crc-32", Alg::Crc_32),
         std::make_pair("crc_32", Alg::Crc_32),
         std::make_pair("xor", Alg::Xor),
+        std::make_pair("crc-32c", Alg::Crc_32C),
+        std::make_pair("crc_32c", Alg::Crc_32C),
+        std::make_pair("crc-64", Alg::Crc_64),
+        std::make_pair("crc_64", Alg::Crc_64),
     };
 
     auto algIter = Map.find(algStr);